@@ -0,0 +1,373 @@
+/*******************************************************************************************
+*
+*   [raylib-tmx] bench - Times the load, draw and collision paths on generated maps.
+*
+*   Prints the results as JSON on the standard output, so runs can be compared.
+*
+*   Usage: raylib-tmx-bench [--width N] [--height N] [--layers N] [--tilesets N]
+*                           [--animated RATIO] [--objects PER_100_CELLS] [--frames N]
+*                           [--loads N] [--seed N]
+*
+*   raylib-tmx is licensed under an unmodified zlib/libpng license (View raylib.h for details)
+*
+********************************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "raylib.h"
+
+#define RAYLIB_TMX_IMPLEMENTATION
+#include "raylib-tmx.h"
+
+#define BENCH_TILE_SIZE 32
+#define BENCH_TILESET_COLUMNS 8
+#define BENCH_TILESET_TILES (BENCH_TILESET_COLUMNS * BENCH_TILESET_COLUMNS)
+#define BENCH_ANIMATION_FRAMES 4
+#define BENCH_MAX_TILESETS 64
+#define BENCH_ENTITIES 256
+
+typedef struct BenchConfig {
+    int width;
+    int height;
+    int layers;
+    int tilesets;
+    float animated;         // Ratio of the tiles of each tileset that are animated
+    float objects;          // Objects per hundred cells
+    int frames;
+    int loads;
+    unsigned int seed;
+} BenchConfig;
+
+typedef struct BenchTiming {
+    const char *name;
+    int count;
+    double total;
+    double min;
+    double max;
+} BenchTiming;
+
+typedef struct BenchBuffer {
+    char *data;
+    size_t size;
+    size_t capacity;
+} BenchBuffer;
+
+static unsigned int benchRandomState = 1;
+
+unsigned int BenchRandom(void) {
+    // xorshift32, so the maps are the same on every platform.
+    benchRandomState ^= benchRandomState << 13;
+    benchRandomState ^= benchRandomState >> 17;
+    benchRandomState ^= benchRandomState << 5;
+    return benchRandomState;
+}
+
+void BenchAppend(BenchBuffer *buffer, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    if (length < 0) return;
+
+    if (buffer->size + (size_t)length + 1 > buffer->capacity) {
+        while (buffer->size + (size_t)length + 1 > buffer->capacity) buffer->capacity = (buffer->capacity == 0) ? 65536 : buffer->capacity * 2;
+        buffer->data = (char *)realloc(buffer->data, buffer->capacity);
+    }
+    va_start(args, format);
+    vsnprintf(buffer->data + buffer->size, (size_t)length + 1, format, args);
+    va_end(args);
+    buffer->size += (size_t)length;
+}
+
+void BenchRecord(BenchTiming *timing, double start) {
+    double elapsed = (GetTime() - start) * 1000.0;
+    if (timing->count == 0 || elapsed < timing->min) timing->min = elapsed;
+    if (timing->count == 0 || elapsed > timing->max) timing->max = elapsed;
+    timing->total += elapsed;
+    timing->count++;
+}
+
+void BenchCountCollision(tmx_object *object, RaylibTMXCollision collision, void* userdata) {
+    (void)object;
+    (void)collision;
+    (*(int*)userdata)++;
+}
+
+/**
+ * Write the tileset images, and the .tmx map using them, to the working directory.
+ */
+bool BenchGenerateMap(const BenchConfig *config, const char *fileName) {
+    for (int t = 0; t < config->tilesets; t++) {
+        Color color = {(unsigned char)(BenchRandom() % 256), (unsigned char)(BenchRandom() % 256), (unsigned char)(BenchRandom() % 256), 255};
+        Image image = GenImageChecked(BENCH_TILE_SIZE * BENCH_TILESET_COLUMNS, BENCH_TILE_SIZE * BENCH_TILESET_COLUMNS, BENCH_TILE_SIZE, BENCH_TILE_SIZE, color, DARKGRAY);
+        bool exported = ExportImage(image, TextFormat("raylib-tmx-bench-%i.png", t));
+        UnloadImage(image);
+        if (!exported) return false;
+    }
+
+    BenchBuffer xml = {0};
+    BenchAppend(&xml, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    BenchAppend(&xml, "<map version=\"1.4\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"%i\" height=\"%i\" tilewidth=\"%i\" tileheight=\"%i\" infinite=\"0\">\n",
+        config->width, config->height, BENCH_TILE_SIZE, BENCH_TILE_SIZE);
+
+    int animatedTiles = (int)(config->animated * BENCH_TILESET_TILES);
+    for (int t = 0; t < config->tilesets; t++) {
+        BenchAppend(&xml, " <tileset firstgid=\"%i\" name=\"tiles%i\" tilewidth=\"%i\" tileheight=\"%i\" tilecount=\"%i\" columns=\"%i\">\n",
+            1 + t * BENCH_TILESET_TILES, t, BENCH_TILE_SIZE, BENCH_TILE_SIZE, BENCH_TILESET_TILES, BENCH_TILESET_COLUMNS);
+        BenchAppend(&xml, "  <image source=\"raylib-tmx-bench-%i.png\" width=\"%i\" height=\"%i\"/>\n",
+            t, BENCH_TILE_SIZE * BENCH_TILESET_COLUMNS, BENCH_TILE_SIZE * BENCH_TILESET_COLUMNS);
+        for (int id = 0; id < animatedTiles; id++) {
+            BenchAppend(&xml, "  <tile id=\"%i\"><animation>", id);
+            for (int frame = 0; frame < BENCH_ANIMATION_FRAMES; frame++) {
+                BenchAppend(&xml, "<frame tileid=\"%i\" duration=\"%i\"/>", (id + frame) % BENCH_TILESET_TILES, 100 + 50 * frame);
+            }
+            BenchAppend(&xml, "</animation></tile>\n");
+        }
+        BenchAppend(&xml, " </tileset>\n");
+    }
+
+    int tileCount = config->tilesets * BENCH_TILESET_TILES;
+    int cells = config->width * config->height;
+    int objectId = 1;
+    for (int l = 0; l < config->layers; l++) {
+        BenchAppend(&xml, " <layer id=\"%i\" name=\"layer%i\" width=\"%i\" height=\"%i\">\n  <data encoding=\"csv\">\n",
+            objectId++, l, config->width, config->height);
+        for (int i = 0; i < cells; i++) {
+            // Upper layers are sparser, like decorations over a ground layer.
+            unsigned int gid = (l == 0 || BenchRandom() % 4 == 0) ? 1 + BenchRandom() % (unsigned int)tileCount : 0;
+            BenchAppend(&xml, (i + 1 < cells) ? "%u," : "%u", gid);
+            if ((i + 1) % config->width == 0) BenchAppend(&xml, "\n");
+        }
+        BenchAppend(&xml, "  </data>\n </layer>\n");
+    }
+
+    int objectCount = (int)(config->objects * (float)cells / 100.0f);
+    if (objectCount > 0) {
+        BenchAppend(&xml, " <objectgroup id=\"%i\" name=\"objects\">\n", objectId++);
+        int mapWidth = config->width * BENCH_TILE_SIZE;
+        int mapHeight = config->height * BENCH_TILE_SIZE;
+        for (int i = 0; i < objectCount; i++) {
+            int x = (int)(BenchRandom() % (unsigned int)mapWidth);
+            int y = (int)(BenchRandom() % (unsigned int)mapHeight);
+            int w = 8 + (int)(BenchRandom() % 64);
+            int h = 8 + (int)(BenchRandom() % 64);
+            switch (i % 4) {
+                case 0:
+                    BenchAppend(&xml, "  <object id=\"%i\" x=\"%i\" y=\"%i\" width=\"%i\" height=\"%i\"/>\n", objectId++, x, y, w, h);
+                    break;
+                case 1:
+                    BenchAppend(&xml, "  <object id=\"%i\" x=\"%i\" y=\"%i\" width=\"%i\" height=\"%i\"><ellipse/></object>\n", objectId++, x, y, w, h);
+                    break;
+                case 2:
+                    BenchAppend(&xml, "  <object id=\"%i\" x=\"%i\" y=\"%i\"><polygon points=\"0,0 %i,0 %i,%i 0,%i\"/></object>\n", objectId++, x, y, w, w, h, h);
+                    break;
+                default:
+                    BenchAppend(&xml, "  <object id=\"%i\" x=\"%i\" y=\"%i\"><point/></object>\n", objectId++, x, y);
+                    break;
+            }
+        }
+        BenchAppend(&xml, " </objectgroup>\n");
+    }
+    BenchAppend(&xml, "</map>\n");
+
+    bool saved = SaveFileText(fileName, xml.data);
+    free(xml.data);
+    return saved;
+}
+
+void BenchRemoveFiles(const BenchConfig *config, const char *fileName, const char *cookedName) {
+    remove(fileName);
+    remove(cookedName);
+    for (int t = 0; t < config->tilesets; t++) {
+        remove(TextFormat("raylib-tmx-bench-%i.png", t));
+    }
+}
+
+bool BenchParseArguments(BenchConfig *config, int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) return false;
+        const char *value = argv[++i];
+        if (strcmp(argv[i - 1], "--width") == 0) config->width = atoi(value);
+        else if (strcmp(argv[i - 1], "--height") == 0) config->height = atoi(value);
+        else if (strcmp(argv[i - 1], "--layers") == 0) config->layers = atoi(value);
+        else if (strcmp(argv[i - 1], "--tilesets") == 0) config->tilesets = atoi(value);
+        else if (strcmp(argv[i - 1], "--animated") == 0) config->animated = (float)atof(value);
+        else if (strcmp(argv[i - 1], "--objects") == 0) config->objects = (float)atof(value);
+        else if (strcmp(argv[i - 1], "--frames") == 0) config->frames = atoi(value);
+        else if (strcmp(argv[i - 1], "--loads") == 0) config->loads = atoi(value);
+        else if (strcmp(argv[i - 1], "--seed") == 0) config->seed = (unsigned int)strtoul(value, NULL, 10);
+        else return false;
+    }
+    return config->width > 0 && config->height > 0 && config->layers > 0 &&
+        config->tilesets > 0 && config->tilesets <= BENCH_MAX_TILESETS &&
+        config->animated >= 0.0f && config->animated <= 1.0f && config->objects >= 0.0f &&
+        config->frames > 0 && config->loads > 0 && config->seed != 0;
+}
+
+int main(int argc, char *argv[]) {
+    BenchConfig config = {256, 256, 3, 2, 0.1f, 1.0f, 300, 5, 1};
+    if (!BenchParseArguments(&config, argc, argv)) {
+        fprintf(stderr, "Usage: %s [--width N] [--height N] [--layers N] [--tilesets N] [--animated RATIO] [--objects PER_100_CELLS] [--frames N] [--loads N] [--seed N]\n", argv[0]);
+        return 1;
+    }
+    benchRandomState = config.seed;
+
+    // Keep the standard output for the results.
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(1280, 720, "[raylib-tmx] bench");
+    if (!IsWindowReady()) return 1;
+
+    const char *fileName = "raylib-tmx-bench.tmx";
+    const char *cookedName = "raylib-tmx-bench.rtmx";
+    if (!BenchGenerateMap(&config, fileName)) {
+        fprintf(stderr, "Failed to write the generated map\n");
+        CloseWindow();
+        return 1;
+    }
+
+    enum {
+        BENCH_LOAD, BENCH_LOAD_COOKED, BENCH_UNLOAD, BENCH_DRAW, BENCH_DRAW_VIEW, BENCH_DRAW_LIST, BENCH_DRAW_CACHED,
+        BENCH_ANIMATIONS, BENCH_COLLISIONS, BENCH_QUERY, BENCH_QUERY_BATCH, BENCH_COUNT
+    };
+    BenchTiming timings[BENCH_COUNT] = {
+        {"LoadTMX", 0, 0, 0, 0},
+        {"LoadTMXCooked", 0, 0, 0, 0},
+        {"UnloadTMX", 0, 0, 0, 0},
+        {"DrawTMX", 0, 0, 0, 0},
+        {"DrawTMXEx", 0, 0, 0, 0},
+        {"BuildTMXDrawList", 0, 0, 0, 0},
+        {"DrawTMXEx cached", 0, 0, 0, 0},
+        {"UpdateTMXAnimations", 0, 0, 0, 0},
+        {"CollisionsTMXForeach", 0, 0, 0, 0},
+        {"QueryTMXCollisionsRect", 0, 0, 0, 0},
+        {"QueryTMXCollisionsRects", 0, 0, 0, 0}
+    };
+
+    tmx_map *map = NULL;
+    for (int i = 0; i < config.loads; i++) {
+        double start = GetTime();
+        map = LoadTMX(fileName);
+        BenchRecord(&timings[BENCH_LOAD], start);
+        if (map == NULL) break;
+        if (i + 1 == config.loads) break;
+        start = GetTime();
+        UnloadTMX(map);
+        BenchRecord(&timings[BENCH_UNLOAD], start);
+    }
+    if (map == NULL) {
+        fprintf(stderr, "Failed to load the generated map\n");
+        BenchRemoveFiles(&config, fileName, cookedName);
+        CloseWindow();
+        return 1;
+    }
+
+    if (ExportTMX(map, cookedName)) {
+        for (int i = 0; i < config.loads; i++) {
+            double start = GetTime();
+            tmx_map *cooked = LoadTMXCooked(cookedName);
+            BenchRecord(&timings[BENCH_LOAD_COOKED], start);
+            UnloadTMX(cooked);
+        }
+    }
+
+    // The whole map, then a camera panning over it.
+    for (int i = 0; i < config.frames; i++) {
+        double start = GetTime();
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+        DrawTMX(map, 0, 0, WHITE);
+        EndDrawing();
+        BenchRecord(&timings[BENCH_DRAW], start);
+    }
+
+    Camera2D camera = {0};
+    camera.zoom = 1.0f;
+    Rectangle viewport = {0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()};
+    float rangeX = (float)(config.width * BENCH_TILE_SIZE) - viewport.width;
+    float rangeY = (float)(config.height * BENCH_TILE_SIZE) - viewport.height;
+    for (int pass = 0; pass < 3; pass++) {
+        if (pass == 2) EnableTMXCache(map);
+        BenchTiming *timing = &timings[(pass == 0) ? BENCH_DRAW_VIEW : (pass == 1) ? BENCH_DRAW_LIST : BENCH_DRAW_CACHED];
+        for (int i = 0; i < config.frames; i++) {
+            float progress = (float)i / (float)config.frames;
+            camera.target = (Vector2){(rangeX > 0) ? rangeX * progress : 0, (rangeY > 0) ? rangeY * progress : 0};
+            double start = GetTime();
+            BeginDrawing();
+            ClearBackground(RAYWHITE);
+            BeginMode2D(camera);
+            if (pass == 1) {
+                RaylibTMXDrawList *list = BuildTMXDrawList(map, camera, viewport, WHITE, 4);
+                SubmitTMXDrawList(list);
+                UnloadTMXDrawList(list);
+            } else {
+                DrawTMXEx(map, camera, viewport, WHITE);
+            }
+            EndMode2D();
+            EndDrawing();
+            BenchRecord(timing, start);
+        }
+    }
+    DisableTMXCache(map);
+
+    for (int i = 0; i < config.frames; i++) {
+        double start = GetTime();
+        UpdateTMXAnimations(map, 1.0f / 60.0f);
+        BenchRecord(&timings[BENCH_ANIMATIONS], start);
+    }
+
+    int collisions = 0;
+    for (int i = 0; i < config.frames; i++) {
+        collisions = 0;
+        double start = GetTime();
+        CollisionsTMXForeach(map, BenchCountCollision, &collisions);
+        BenchRecord(&timings[BENCH_COLLISIONS], start);
+    }
+
+    int queried = 0;
+    for (int i = 0; i < config.frames; i++) {
+        Rectangle area = {(float)(BenchRandom() % (unsigned int)(config.width * BENCH_TILE_SIZE)), (float)(BenchRandom() % (unsigned int)(config.height * BENCH_TILE_SIZE)), 256, 256};
+        double start = GetTime();
+        QueryTMXCollisionsRect(map, area, BenchCountCollision, &queried);
+        BenchRecord(&timings[BENCH_QUERY], start);
+    }
+
+    // A crowd of entities, tested together every frame.
+    Rectangle entities[BENCH_ENTITIES];
+    RaylibTMXCollisionHit *hits = (RaylibTMXCollisionHit *)malloc(BENCH_ENTITIES * 16 * sizeof(RaylibTMXCollisionHit));
+    int batched = 0;
+    for (int i = 0; i < config.frames; i++) {
+        for (int e = 0; e < BENCH_ENTITIES; e++) {
+            entities[e] = (Rectangle){(float)(BenchRandom() % (unsigned int)(config.width * BENCH_TILE_SIZE)), (float)(BenchRandom() % (unsigned int)(config.height * BENCH_TILE_SIZE)), 24, 24};
+        }
+        double start = GetTime();
+        batched = QueryTMXCollisionsRects(map, entities, BENCH_ENTITIES, hits, BENCH_ENTITIES * 16);
+        BenchRecord(&timings[BENCH_QUERY_BATCH], start);
+    }
+    free(hits);
+
+    double start = GetTime();
+    UnloadTMX(map);
+    BenchRecord(&timings[BENCH_UNLOAD], start);
+
+    BenchRemoveFiles(&config, fileName, cookedName);
+    CloseWindow();
+
+    printf("{\n");
+    printf("  \"config\": {\"width\": %i, \"height\": %i, \"layers\": %i, \"tilesets\": %i, \"animated\": %g, \"objects\": %g, \"frames\": %i, \"loads\": %i, \"seed\": %u},\n",
+        config.width, config.height, config.layers, config.tilesets, config.animated, config.objects, config.frames, config.loads, config.seed);
+    printf("  \"counters\": {\"collisions\": %i, \"queried\": %i, \"batched\": %i},\n", collisions, queried, batched);
+    printf("  \"results\": [\n");
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        const BenchTiming *timing = &timings[i];
+        double mean = (timing->count > 0) ? timing->total / timing->count : 0.0;
+        printf("    {\"name\": \"%s\", \"count\": %i, \"total_ms\": %.4f, \"mean_ms\": %.4f, \"min_ms\": %.4f, \"max_ms\": %.4f}%s\n",
+            timing->name, timing->count, timing->total, mean, timing->min, timing->max, (i + 1 < BENCH_COUNT) ? "," : "");
+    }
+    printf("  ]\n}\n");
+
+    return 0;
+}
@@ -37,15 +37,9 @@ void UpdateCollisons(tmx_object *object, RaylibTMXCollision collision, void* use
             } break;
             case COLLISION_POLYGON:
             case COLLISION_POLYLINE: {
-                double** points = collision.polygon.points;
+                Vector2* check  = collision.polygon.vertices;
                 int count       = collision.polygon.count;
-                Vector2* check  = malloc(count * sizeof(Vector2));
                 int threshold   = RAYLIB_TMX_LINE_THICKNESS;
-                for (int i = 0; i < count; i++) {
-                    float posX = (float)(object->x + points[i][0]);
-                    float posY = (float)(object->y + points[i][1]);
-                    check[i] = (Vector2){posX, posY};
-                }
                 if (object->obj_type == OT_POLYGON) {
                     if (CheckCollisionPointPoly(mousePosition, check, count)) {
                         selected = object;
@@ -56,7 +50,6 @@ void UpdateCollisons(tmx_object *object, RaylibTMXCollision collision, void* use
                         selected = object;
                     }
                 }
-                free(check);
             } break;
         }
     }
@@ -132,13 +125,17 @@ int main(int argc, char *argv[]) {
         if (IsMouseButtonPressed(MOUSE_BUTTON_MIDDLE)) {
             drawCollisions = !drawCollisions;
         }
-        CollisionsTMXForeach(map, UpdateCollisons, map);
+        UpdateTMXAnimations(map, GetFrameTime());
+        if (selected == NULL && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+            QueryTMXCollisionsPoint(map, mousePosition, UpdateCollisons, map);
+        }
         if (selected != NULL) {
             selected->x           = mousePosition.x;
             selected->y           = mousePosition.y;
         }
         if (selected != NULL && IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) {
             selected = NULL;
+            UpdateTMXCollisionIndex(map);
         }
         //----------------------------------------------------------------------------------
 
@@ -45,8 +45,8 @@ extern "C" {
 
 // TMX structs
 typedef struct AnimationState {
-    int currentFrame;
-    float frameCounter;
+    int currentFrame;               // Index of the tmx_anim_frame being shown
+    float frameCounter;             // Milliseconds spent on the current frame
 } AnimationState;
 
 typedef struct {
@@ -63,24 +63,145 @@ typedef struct {
         struct {
             double** points;
             int count;
+            Vector2* vertices;      // The points in map coordinates, NULL when from HandleTMXCollision()
         } polygon;
     };
 } RaylibTMXCollision;
 
+typedef struct RaylibTMXCollider {
+    tmx_object *object;             // The object given to collision callbacks
+    RaylibTMXCollision collision;   // The shape, in map coordinates
+    Rectangle bounds;               // Area covered by the shape
+} RaylibTMXCollider;
+
+typedef struct RaylibTMXCollisionHit {
+    int index;                          // Index of the rectangle or point in the query
+    const RaylibTMXCollider *collider;  // The collision whose bounds it overlaps
+} RaylibTMXCollisionHit;
+
 typedef void (*tmx_collision_functor)(tmx_object *object, RaylibTMXCollision collision, void* userdata);
+typedef unsigned char *(*tmx_file_data_functor)(const char *fileName, int *dataSize, void* userdata);
+typedef struct RaylibTMXLoad RaylibTMXLoad;
+typedef struct RaylibTMXDrawList RaylibTMXDrawList;
+
+typedef struct RaylibTMXTileChange {
+    int x;                      // Column of the cell
+    int y;                      // Row of the cell
+    unsigned int gid;           // New global ID of the cell, with its flip flags
+} RaylibTMXTileChange;
+
+typedef struct RaylibTMXRayHit {
+    bool hit;                   // Whether the ray reached a solid cell
+    float distance;             // Distance from the start of the ray to the hit
+    Vector2 point;              // Where the ray enters the solid cell
+    Vector2 normal;             // Side of the cell that was hit, zero when the ray starts in it
+    int x;                      // Column of the solid cell
+    int y;                      // Row of the solid cell
+} RaylibTMXRayHit;
+
+typedef struct RaylibTMXPathRequest {
+    Vector2 start;              // Where the path starts, in map coordinates
+    Vector2 goal;               // Where the path ends
+    Vector2 *path;              // Waypoints found, to unload with UnloadTMXPath(), NULL when there's no path
+    int count;                  // Number of waypoints found
+} RaylibTMXPathRequest;
+
+typedef struct RaylibTMXTextureCacheStats {
+    unsigned int hits;          // Images loaded from the cache
+    unsigned int misses;        // Images that had to be loaded
+    int resident;               // Textures currently loaded
+    size_t residentBytes;       // Size of the pixels of the textures currently loaded
+} RaylibTMXTextureCacheStats;
+
+#ifndef RAYLIB_TMX_STATS_MAX_LAYERS
+#define RAYLIB_TMX_STATS_MAX_LAYERS 16      // Amount of layers GetTMXFrameStats() keeps separate statistics for
+#endif
+
+typedef struct RaylibTMXLayerStats {
+    tmx_layer *layer;
+    int cellsVisited;           // Cells of the layer within the drawn bounds
+    int tilesDrawn;             // Tiles, objects and images drawn for the layer
+    double time;                // Milliseconds spent on the CPU drawing the layer
+} RaylibTMXLayerStats;
+
+typedef struct RaylibTMXFrameStats {
+    int cellsVisited;           // Cells of tile layers looked at while drawing
+    int tilesDrawn;             // Tiles drawn, including the ones of meshes
+    int cellsSkipped;           // Empty cells looked at while drawing
+    int chunksDrawn;            // Baked chunks, and mesh regions, drawn
+    int textureSwitches;        // Draws that used another texture than the previous draw
+    int animationUpdates;       // Animated tiles advanced
+    int objectsDrawn[8];        // Objects drawn, indexed by their tmx_obj_type
+    int collisionCallbacks;     // Calls made to collision callbacks
+    int layerCount;
+    RaylibTMXLayerStats layers[RAYLIB_TMX_STATS_MAX_LAYERS];  // Statistics of the first layers drawn
+} RaylibTMXFrameStats;
 
 // TMX functions
 tmx_map* LoadTMX(const char* fileName);                                                                // Load a Tiled .tmx tile map
+tmx_map* LoadTMXFromMemory(const unsigned char *data, int dataSize, const char *basePath);             // Load a Tiled .tmx tile map from memory, resolving its files relative to the given base path
+tmx_map* LoadTMXCooked(const char *fileName);                                                          // Load a map saved with ExportTMX(), memory mapping it when possible
+bool ExportTMX(tmx_map *map, const char *fileName);                                                    // Save a loaded map in the cooked binary format
+void SetTMXFileDataCallback(tmx_file_data_functor callback, void* userdata);                           // Set the callback used to read the files of the maps, NULL to read them from the disk
+RaylibTMXLoad *LoadTMXAsync(const char *fileName);                                                     // Start loading a Tiled .tmx tile map on a worker thread
+bool PollTMXLoad(RaylibTMXLoad *load, tmx_map **map);                                                  // Upload the textures of the map once parsed, returns true when the load is over
+void CancelTMXLoad(RaylibTMXLoad *load);                                                               // Stop loading a map, and free what was loaded
+RaylibTMXTextureCacheStats GetTMXTextureCacheStats(void);                                              // Get the hits, misses and resident textures of the texture cache shared between maps
 void UnloadTMX(tmx_map* map);                                                                          // Unload the given Tiled map
 Color ColorFromTMX(uint32_t color);                                                                    // Convert a Tiled color number to a raylib Color
 void DrawTMX(tmx_map *map, int posX, int posY, Color tint);                                            // Render the given Tiled map to the screen
 void DrawTMXLayers(tmx_map *map, tmx_layer *layers, int posX, int posY, Color tint);                   // Render all the given map layers to the screen
 void DrawTMXLayer(tmx_map *map, tmx_layer *layer, int posX, int posY, Color tint);                     // Render a single map layer on the screen
+void DrawTMXEx(tmx_map *map, Camera2D camera, Rectangle viewport, Color tint);                         // Render the parts of the map visible through the given camera and screen viewport
+void DrawTMXLayersEx(tmx_map *map, tmx_layer *layers, int posX, int posY, Rectangle bounds, Color tint); // Render all the given map layers, skipping cells outside of the given world bounds
+void DrawTMXLayerEx(tmx_map *map, tmx_layer *layer, int posX, int posY, Rectangle bounds, Color tint);   // Render a single map layer, skipping cells outside of the given world bounds
+RaylibTMXDrawList *BuildTMXDrawList(tmx_map *map, Camera2D camera, Rectangle viewport, Color tint, int workers); // Record the draws of the visible tile layers on worker threads, one layer at a time
+void SubmitTMXDrawList(RaylibTMXDrawList *list);                                                       // Render a recorded draw list, giving the same result as DrawTMXEx()
+void UnloadTMXDrawList(RaylibTMXDrawList *list);                                                       // Unload a draw list built with BuildTMXDrawList()
+Rectangle GetTMXViewBounds(Camera2D camera, Rectangle viewport);                                       // Get the world-space rectangle seen by a camera through a screen viewport
+void EnableTMXCache(tmx_map *map);                                                                     // Bake static tile layers into chunked render textures the first time they are drawn
+void DisableTMXCache(tmx_map *map);                                                                    // Stop using, and unload, the baked tile layer chunks
+void SetTMXCacheBudget(tmx_map *map, int maxChunks);                                                   // Limit the amount of baked chunks, and of baked chunk collisions, unloading the least recently used ones
+void StreamTMXCache(tmx_map *map, Rectangle bounds);                                                   // Bake the chunks overlapping the given bounds, and their collisions, ahead of using them
+void InvalidateTMXCache(tmx_map *map, tmx_layer *layer, int x, int y);                                 // Update the baked, meshed and compiled data of a cell after its GID changed
+bool SetTMXTile(tmx_map *map, tmx_layer *layer, int x, int y, unsigned int gid);                       // Change the tile of a cell of a tile layer, updating only what was built from that cell
+int SetTMXTiles(tmx_map *map, tmx_layer *layer, const RaylibTMXTileChange *changes, int count);        // Change the tiles of many cells of a tile layer, returns the amount changed
+void BuildTMXLayerMesh(tmx_map *map, tmx_layer *layer);                                                // Build vertex batches per tileset texture, used when drawing the given tile layer
+void UnloadTMXLayerMesh(tmx_map *map, tmx_layer *layer);                                               // Unload the vertex batches of the given tile layer
+void CompileTMX(tmx_map *map);                                                                         // Precompute the draw records of every cell in the map's tile layers
+int PackTMXAtlas(tmx_map *map, int maxSheetSize);                                                      // Pack image collection tiles, and tileset sheets up to the given size, into shared atlases
 void DrawTMXTile(tmx_tile* tile, unsigned int baseGid, int posX, int posY, Color tint);                // Render the given tile to the screen
 void DrawTMXObjectTile(tmx_tile* tile, int baseGid, Rectangle destRect, float rotation, Color tint);   // Render the tile of a given object to the screen
-void UpdateTMXTileAnimation(tmx_map* map, tmx_tile** tile);                                            // Controls the animation state of a tile and return the LID of the current animation
+void UpdateTMXTileAnimation(tmx_map* map, tmx_tile** tile);                                            // Replace the given animated tile with the tile of its current animation frame
+void UpdateTMXAnimations(tmx_map *map, float deltaTime);                                               // Advance every animated tile of the map by the given amount of seconds
+unsigned int GetTMXTilesetFirstGid(tmx_map *map, tmx_tileset *tileset);                                // Get the first global ID of the given tileset within the map, 0 if it's not part of it
+unsigned int GetTMXTileGid(tmx_map *map, tmx_tile *tile);                                              // Get the global ID of the given tile within the map, 0 if it's not part of it
+AnimationState *GetTMXAnimationState(tmx_map *map, tmx_tile *tile);                                    // Get the animation state of an animated tile, NULL if it's not animated
+tmx_property* GetTMXMapProperty(tmx_map *map, const char *name);                                       // Find a custom property of the map, also on maps loaded with LoadTMXCooked()
+tmx_property* GetTMXLayerProperty(tmx_map *map, tmx_layer *layer, const char *name);                   // Find a custom property of a layer of the map
+tmx_property* GetTMXTileProperty(tmx_map *map, tmx_tile *tile, const char *name);                      // Find a custom property of a tile of the map
+tmx_property* GetTMXObjectProperty(tmx_map *map, tmx_object *object, const char *name);                // Find a custom property of an object of the map
+tmx_property* GetTMXPropertyMember(tmx_map *map, tmx_property *property, const char *name);            // Find a member of a class property of the map
 void CollisionsTMXForeach(tmx_map *map, tmx_collision_functor callback, void* userdata);               // Returns each tmx_object on a given map and their collisions on a callback
 RaylibTMXCollision HandleTMXCollision(tmx_object* object);                                              // Returns a single RaylibTMXCollision for an given object pointer
+void QueryTMXCollisionsRect(tmx_map *map, Rectangle rect, tmx_collision_functor callback, void* userdata);   // Returns the collisions overlapping the given rectangle on a callback
+void QueryTMXCollisionsPoint(tmx_map *map, Vector2 point, tmx_collision_functor callback, void* userdata);   // Returns the collisions whose bounds hold the given point on a callback
+int QueryTMXCollisionsRects(tmx_map *map, const Rectangle *rects, int count, RaylibTMXCollisionHit *hits, int maxHits);   // Find the collisions overlapping each of the given rectangles at once, returns the number of hits
+int QueryTMXCollisionsPoints(tmx_map *map, const Vector2 *points, int count, RaylibTMXCollisionHit *hits, int maxHits);   // Find the collisions whose bounds hold each of the given points at once, returns the number of hits
+void UpdateTMXCollisionIndex(tmx_map *map);                                                            // Rebuild the collision index and drawing grids of the object layers, after objects were changed
+Rectangle *LoadTMXLayerColliders(tmx_map *map, tmx_layer *layer, int *count);                          // Load the rectangle collisions of a tile layer, with solid tiles merged together
+void UnloadTMXLayerColliders(Rectangle *colliders);                                                    // Unload the rectangles loaded with LoadTMXLayerColliders()
+const RaylibTMXCollider *GetTMXCellColliders(tmx_map *map, tmx_layer *layer, int x, int y, int *count); // Get the collisions of a cell of a tile layer, from the colliders baked for the map
+const RaylibTMXCollider *GetTMXObjectColliders(tmx_map *map, tmx_layer *layer, int *count);            // Get the collisions of every object of an object layer, from the colliders baked for the map
+void SetTMXSolidProperty(tmx_map *map, const char *property);                                           // Make the tiles with the given boolean property solid, instead of the tiles with collisions, NULL to go back
+bool IsTMXCellSolid(tmx_map *map, tmx_layer *layer, int x, int y);                                      // Check whether a cell of a tile layer, or of any visible tile layer when NULL, holds a solid tile
+RaylibTMXRayHit RaycastTMX(tmx_map *map, tmx_layer *layer, Vector2 start, Vector2 end);                // Find the first solid cell crossed by a line, for line of sight
+Rectangle MoveTMXRect(tmx_map *map, tmx_layer *layer, Rectangle rect, Vector2 motion, Vector2 *normal); // Move a rectangle through the grid, stopping it against solid cells
+Vector2 *LoadTMXPath(tmx_map *map, Vector2 start, Vector2 goal, int *count);                           // Find a path around the solid cells, as the waypoints where it turns
+void LoadTMXPaths(tmx_map *map, RaylibTMXPathRequest *requests, int count, int workers);               // Find the paths of many agents at once, on worker threads
+void UnloadTMXPath(Vector2 *path);                                                                     // Unload the waypoints of a path
+RaylibTMXFrameStats GetTMXFrameStats(void);                                                            // Get the drawing and collision statistics gathered since the last reset, when built with RAYLIB_TMX_STATS
+void ResetTMXFrameStats(void);                                                                         // Clear the statistics, usually once per frame
 
 #ifdef __cplusplus
 }
@@ -92,6 +213,64 @@ RaylibTMXCollision HandleTMXCollision(tmx_object* object);
 #ifndef RAYLIB_TMX_IMPLEMENTATION_ONCE
 #define RAYLIB_TMX_IMPLEMENTATION_ONCE
 
+#include <float.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__) && !defined(RAYLIB_TMX_NO_THREADS)
+#define RAYLIB_TMX_NO_THREADS
+#endif
+
+#if defined(RAYLIB_TMX_NO_THREADS)
+#define RAYLIB_TMX_THREAD_LOCAL
+#elif defined(_WIN32)
+// windows.h clashes with raylib.h, so only the few needed functions are declared.
+#include <process.h>
+__declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void *handle, unsigned long milliseconds);
+__declspec(dllimport) int __stdcall CloseHandle(void *handle);
+#define RAYLIB_TMX_THREAD_LOCAL __declspec(thread)
+#else
+#include <pthread.h>
+#define RAYLIB_TMX_THREAD_LOCAL __thread
+#endif
+
+// Increment a long shared between threads, evaluating to its previous value.
+#if defined(RAYLIB_TMX_NO_THREADS)
+#define RAYLIB_TMX_ATOMIC_INCREMENT(value) ((*(value))++)
+#elif defined(_MSC_VER)
+long _InterlockedIncrement(long volatile *value);
+#pragma intrinsic(_InterlockedIncrement)
+#define RAYLIB_TMX_ATOMIC_INCREMENT(value) (_InterlockedIncrement(value) - 1)
+#else
+#define RAYLIB_TMX_ATOMIC_INCREMENT(value) __atomic_fetch_add(value, 1, __ATOMIC_RELAXED)
+#endif
+
+#ifndef RAYLIB_TMX_MAX_WORKERS
+#define RAYLIB_TMX_MAX_WORKERS 16           // Most threads BuildTMXDrawList() records layers on
+#endif
+
+#if !defined(RAYLIB_TMX_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define RAYLIB_TMX_MMAP
+#endif
+
+#if !defined(RAYLIB_TMX_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <immintrin.h>
+#define RAYLIB_TMX_SSE
+#if defined(__AVX__)
+#define RAYLIB_TMX_AVX
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#include "rlgl.h" // NOLINT
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -108,374 +287,3500 @@ Color ColorFromTMX(uint32_t color) {
 	return *((Color*)&res);
 }
 
+static tmx_file_data_functor raylibTMXFileDataCallback = NULL;
+static void *raylibTMXFileDataUserData = NULL;
+
+// Directory the files of the map being loaded from memory are relative to, NULL when loading from the disk.
+static RAYLIB_TMX_THREAD_LOCAL const char *raylibTMXBasePath = NULL;
+
+// Whether LoadTMXImage() should only decode the images, as it's running on a worker thread.
+static RAYLIB_TMX_THREAD_LOCAL bool raylibTMXDecodeOnly = false;
+
 /**
- * Loads the provided path as a Texture for use with TMX.
- *
- * @param fileName The file path of the image to load.
+ * The texture of a tileset or image, as created by LoadTMXImage().
  *
- * @return A void pointer representation of the Texture.
+ * The texture comes first, so the image pointers of libtmx can be used as Texture2D pointers.
  *
- * @see UnloadTMXImage()
+ * @internal
+ */
+typedef struct RaylibTMXTexture {
+    Texture2D texture;
+    Image image;                        // Decoded pixels waiting to be uploaded by PollTMXLoad()
+    char *path;                         // Resolved path the texture is cached under, NULL when not cached
+    int refCount;                       // Number of images of loaded maps using the texture
+    unsigned int bytes;
+    struct RaylibTMXTexture *next;
+} RaylibTMXTexture;
+
+// Textures shared by all loaded maps, keyed by path.
+static RaylibTMXTexture *raylibTMXTextures = NULL;
+static RaylibTMXTextureCacheStats raylibTMXTextureStats = {0};
+
+#if defined(RAYLIB_TMX_NO_THREADS)
+#define LockTMXTextureCache()
+#define UnlockTMXTextureCache()
+#elif defined(_WIN32)
+__declspec(dllimport) void __stdcall AcquireSRWLockExclusive(void **lock);
+__declspec(dllimport) void __stdcall ReleaseSRWLockExclusive(void **lock);
+static void *raylibTMXTextureLock = NULL;
+#define LockTMXTextureCache() AcquireSRWLockExclusive(&raylibTMXTextureLock)
+#define UnlockTMXTextureCache() ReleaseSRWLockExclusive(&raylibTMXTextureLock)
+#else
+static pthread_mutex_t raylibTMXTextureLock = PTHREAD_MUTEX_INITIALIZER;
+#define LockTMXTextureCache() pthread_mutex_lock(&raylibTMXTextureLock)
+#define UnlockTMXTextureCache() pthread_mutex_unlock(&raylibTMXTextureLock)
+#endif
+
+#ifndef RAYLIB_TMX_MAX_PATH
+#define RAYLIB_TMX_MAX_PATH 1024
+#endif
+
+#if defined(RAYLIB_TMX_STATS)
+static RaylibTMXFrameStats raylibTMXFrameStats = {0};
+static unsigned int raylibTMXStatsTexture = 0;      // Texture of the last draw, to count the switches
+
+// Where the counters go, which is the statistics of its layer when recording a draw list on a worker.
+static RAYLIB_TMX_THREAD_LOCAL RaylibTMXFrameStats *raylibTMXStatsTarget = &raylibTMXFrameStats;
+#define RAYLIB_TMX_STAT(field, amount) (raylibTMXStatsTarget->field += (amount))
+#define RAYLIB_TMX_STAT_TEXTURE(id) CountTMXTextureSwitch(id)
+
+/**
+ * Count a texture switch when the given texture differs from the one of the previous draw.
  *
  * @internal
  */
-void *LoadTMXImage(const char *fileName) {
-	Texture2D *returnValue = MemAlloc(sizeof(Texture2D));
-	*returnValue = LoadTexture(fileName);
-	return returnValue;
+void CountTMXTextureSwitch(unsigned int id) {
+    if (id == raylibTMXStatsTexture) return;
+    raylibTMXStatsTexture = id;
+    raylibTMXFrameStats.textureSwitches++;
 }
 
 /**
- * Unload the provided Texture pointer.
+ * Count the tiles, objects and images drawn so far.
  *
  * @internal
  */
-void UnloadTMXImage(void *ptr) {
-    if (ptr != NULL) {
-        UnloadTexture(*((Texture2D *) ptr));
-        MemFree(ptr);
-    }
+int CountTMXStatsDrawn(void) {
+    int drawn = raylibTMXFrameStats.tilesDrawn;
+    for (int i = 0; i < 8; i++) drawn += raylibTMXFrameStats.objectsDrawn[i];
+    return drawn;
 }
 
 /**
- * Reallocate memory function callback for TMX.
+ * Add the work done drawing a layer to its statistics, when there's room for them.
  *
  * @internal
  */
-void* MemReallocTMX(void* address, size_t len) {
-    return MemRealloc(address, (unsigned int)len);
+void RecordTMXLayerStats(tmx_layer *layer, int cellsVisited, int tilesDrawn, double time) {
+    RaylibTMXLayerStats *stats = NULL;
+    for (int i = 0; i < raylibTMXFrameStats.layerCount && stats == NULL; i++) {
+        if (raylibTMXFrameStats.layers[i].layer == layer) stats = &raylibTMXFrameStats.layers[i];
+    }
+    if (stats == NULL) {
+        if (raylibTMXFrameStats.layerCount == RAYLIB_TMX_STATS_MAX_LAYERS) return;
+        stats = &raylibTMXFrameStats.layers[raylibTMXFrameStats.layerCount++];
+        stats->layer = layer;
+    }
+    stats->cellsVisited += cellsVisited;
+    stats->tilesDrawn += tilesDrawn;
+    stats->time += time;
 }
+#else
+#define RAYLIB_TMX_STAT(field, amount) ((void)0)
+#define RAYLIB_TMX_STAT_TEXTURE(id) ((void)0)
+#endif
+
+#define RAYLIB_TMX_COOKED_MAGIC "RTMX"
+#define RAYLIB_TMX_COOKED_VERSION 3
 
 /**
- * Loads given .tmx Tiled file.
- *
- * @param fileName The .tmx file to load.
+ * Set the callback used to read the files of the maps.
  *
- * @return A TMX Tiled map object pointer.
+ * Once set, LoadTMX() and LoadTMXFromMemory() read the .tmx, .tsx and image files through it, so
+ * maps can be loaded from archives without touching the disk.
  *
- * @see UnloadTMX()
- * @todo Add LoadTMXFromMemory() to allow loading through a buffer: https://github.com/baylej/tmx/pull/58
+ * @param callback The function returning the data of a file, allocated with MemAlloc(), or NULL on failure. NULL to read files with LoadFileData().
+ * @param userdata The userdata passed to the callback.
  */
-tmx_map* LoadTMX(const char* fileName) {
-    // Register the TMX callbacks.
-    tmx_alloc_func = MemReallocTMX;
-    tmx_free_func = MemFree;
-    tmx_img_load_func = LoadTMXImage;
-	tmx_img_free_func = UnloadTMXImage;
+void SetTMXFileDataCallback(tmx_file_data_functor callback, void* userdata) {
+    raylibTMXFileDataCallback = callback;
+    raylibTMXFileDataUserData = userdata;
+}
 
-    // Load the TMX file.
-    tmx_map* map = tmx_load(fileName);
-    if (!map) {
-        TraceLog(LOG_ERROR, "TMX: Failed to load TMX file %s", fileName);
-        return NULL;
+/**
+ * Read a file, through the file data callback when one is set.
+ *
+ * @internal
+ */
+unsigned char *LoadTMXFileData(const char *fileName, int *dataSize) {
+    *dataSize = 0;
+    if (raylibTMXFileDataCallback != NULL) {
+        return raylibTMXFileDataCallback(fileName, dataSize, raylibTMXFileDataUserData);
     }
-    TraceLog(LOG_INFO, "TMX: Loaded %ix%i map", map->width, map->height);
-    return map;
-
-    // TODO: Load using a buffer instead: https://github.com/baylej/tmx/pull/58
-    // const char* fileText = LoadFileText(fileName);
-    // tmx_map* map = tmx_load_buffer_path(fileText, TextLength(fileText), fileName);
-    // if (!map) {
-    //     TraceLog(LOG_ERROR, "TMX: Failed to load TMX file %s", fileName);
-    //     return NULL;
-    // }
-    // TraceLog(LOG_INFO, "TMX: Loaded %ix%i map", map->width, map->height);
-    // return map;
+    return LoadFileData(fileName, dataSize);
 }
 
 /**
- * Unload animations withing layers.
+ * Copy the directory of the given path, without relying on the shared buffer of GetDirectoryPath().
  *
  * @internal
  */
-void UnloadAnimations(tmx_map* map) {
-    for (tmx_layer *layer = (map->ly_head); layer != NULL; layer = layer->next) {
-	    switch (layer->type)
-	    {
-		    default: continue; break;
-		    case L_LAYER: {
-		        for (unsigned int y = 0; y < map->height; y++) {
-			        for (unsigned int x = 0; x < map->width; x++) {
-			            unsigned int index = (y * map->width) + x;
-			            unsigned int baseGid = layer->content.gids[index];
-			            unsigned int gid = baseGid & TMX_FLIP_BITS_REMOVAL;
-			            if (map->tiles[gid] != NULL) {
-				            tmx_tile* tile = map->tiles[gid];
-				            if(tile->animation) {
-				                if (tile->user_data.pointer != NULL) {
-					                MemFree(tile->user_data.pointer);
-				                }
-				            }
-			            }
-			        }
-		        }
-		    } break;
-	    }
-	}
+void GetTMXDirectoryPath(char *output, const char *fileName) {
+    const char *slash = strrchr(fileName, '/');
+    const char *backslash = strrchr(fileName, '\\');
+    if (backslash != NULL && (slash == NULL || backslash > slash)) slash = backslash;
+    if (slash == NULL) {
+        snprintf(output, RAYLIB_TMX_MAX_PATH, ".");
+    }
+    else {
+        snprintf(output, RAYLIB_TMX_MAX_PATH, "%.*s", (int)(slash - fileName), fileName);
+    }
 }
 
 /**
- * Unloads the given TMX map.
+ * Join a path relative to the given directory. Absolute paths, and empty directories, leave it as is.
  *
- * @param map The map to unload.
+ * @internal
  */
-void UnloadTMX(tmx_map* map) {
-    if (map) {
-        UnloadAnimations(map);
-        tmx_map_free(map);
-        TraceLog(LOG_INFO, "TMX: Unloaded map");
+void JoinTMXPath(char *output, const char *directory, const char *fileName) {
+    bool absolute = fileName[0] == '/' || fileName[0] == '\\' || (fileName[0] != '\0' && fileName[1] == ':');
+    if (directory == NULL || directory[0] == '\0' || absolute) {
+        snprintf(output, RAYLIB_TMX_MAX_PATH, "%s", fileName);
+    }
+    else {
+        size_t length = strlen(directory);
+        bool separator = directory[length - 1] == '/' || directory[length - 1] == '\\';
+        snprintf(output, RAYLIB_TMX_MAX_PATH, "%s%s%s", directory, separator ? "" : "/", fileName);
     }
 }
 
-#ifndef RAYLIB_TMX_LINE_THICKNESS
-#define RAYLIB_TMX_LINE_THICKNESS 3.0f
-#endif
-
 /**
+ * Upload the decoded pixels of a texture loaded by LoadTMXImage() on a worker thread.
+ *
  * @internal
  */
-void DrawTMXPolyline(double offset_x, double offset_y, double **points, int points_count, Color color) {
-	for (int i = 1; i < points_count; i++) {
-		DrawLineEx((Vector2){(float)(offset_x + points[i-1][0]), (float)(offset_y + points[i-1][1])},
-		           (Vector2){(float)(offset_x + points[i][0]), (float)(offset_y + points[i][1])},
-		           RAYLIB_TMX_LINE_THICKNESS, color);
-	}
+void UploadTMXImage(void *ptr) {
+    RaylibTMXTexture *texture = (RaylibTMXTexture *)ptr;
+    if (texture == NULL || texture->image.data == NULL) return;
+    texture->texture = LoadTextureFromImage(texture->image);
+    UnloadImage(texture->image);
+    texture->image = (Image){0};
 }
 
 /**
+ * Release the provided Texture pointer, unloading it once no map uses it anymore.
+ *
  * @internal
  */
-void DrawTMXPolygon(double offset_x, double offset_y, double **points, int points_count, Color color) {
-	DrawTMXPolyline(offset_x, offset_y, points, points_count, color);
-	if (points_count > 2) {
-		DrawLineEx((Vector2){(float)(offset_x + points[0][0]), (float)(offset_y + points[0][1])},
-		           (Vector2){(float)(offset_x + points[points_count-1][0]), (float)(offset_y + points[points_count-1][1])},
-		           RAYLIB_TMX_LINE_THICKNESS, color);
-	}
+void UnloadTMXImage(void *ptr) {
+    if (ptr == NULL) return;
+    RaylibTMXTexture *texture = (RaylibTMXTexture *)ptr;
+    if (texture->path != NULL) {
+        LockTMXTextureCache();
+        texture->refCount--;
+        if (texture->refCount > 0) {
+            UnlockTMXTextureCache();
+            return;
+        }
+        RaylibTMXTexture **link = &raylibTMXTextures;
+        while (*link != NULL && *link != texture) link = &(*link)->next;
+        if (*link != NULL) *link = texture->next;
+        raylibTMXTextureStats.resident--;
+        raylibTMXTextureStats.residentBytes -= texture->bytes;
+        UnlockTMXTextureCache();
+        MemFree(texture->path);
+    }
+    else if (--texture->refCount > 0) {
+        return;
+    }
+    if (texture->texture.id > 0) UnloadTexture(texture->texture);
+    if (texture->image.data != NULL) UnloadImage(texture->image);
+    MemFree(ptr);
 }
 
 /**
+ * Find a texture in the texture cache, and hold a reference to it.
+ *
+ * @return The cached texture, or NULL when it isn't cached yet.
+ *
  * @internal
  */
-void DrawTMXText(tmx_text* text, Rectangle dest, Color tint) {
-    float fontSize = (float)text->pixelsize;
-    const char* message = text->text;
-    Font font = GetFontDefault();
-    // TODO: Figure out the correct spacing.
-    float spacing = (float)text->kerning * fontSize / 12.0f;
-    Vector2 position = {dest.x, dest.y};
-
-    if (text->wrap == 0) {
-        Vector2 textSize = MeasureTextEx(font, message, fontSize, spacing);
-        if (text->halign == HA_CENTER) {
-            position.x = dest.x + dest.width / 2.0f - textSize.x / 2.0f;
-        }
-        else if (text->halign == HA_RIGHT) {
-            position.x = dest.x + dest.width - textSize.x;
-        }
-        if (text->valign == VA_CENTER) {
-            position.y = dest.y + dest.height / 2.0f - textSize.y / 2.0f;
-        }
-        else if (text->valign == VA_BOTTOM) {
-            position.y = dest.y + dest.height - textSize.y;
-        }
-        DrawTextEx(font, message, position, fontSize, spacing, tint);
+RaylibTMXTexture *AcquireTMXTexture(const char *path) {
+    LockTMXTextureCache();
+    RaylibTMXTexture *texture = raylibTMXTextures;
+    while (texture != NULL && strcmp(texture->path, path) != 0) texture = texture->next;
+    if (texture != NULL) {
+        texture->refCount++;
+        raylibTMXTextureStats.hits++;
     }
     else {
-        Vector2 origin = {0.0f, 0.0f};
-        DrawTextPro(font, message, position, origin, 0.0f, fontSize, spacing, tint);
+        raylibTMXTextureStats.misses++;
     }
+    UnlockTMXTextureCache();
+    return texture;
 }
 
 /**
+ * Add a freshly loaded texture to the texture cache.
+ *
+ * Textures that failed to load aren't cached. When another thread cached the same path in the
+ * meantime, the given texture is dropped in favor of the cached one.
+ *
+ * @return The texture to use.
+ *
  * @internal
  */
-void DrawTMXLayerObjects(tmx_map *map, tmx_object_group *objgr, int posX, int posY, Color tint) {
-	tmx_object *head = objgr->head;
-	Color color = ColorFromTMX(objgr->color);
-    // TODO: Merge the tint
+RaylibTMXTexture *CacheTMXTexture(const char *path, RaylibTMXTexture *texture) {
+    int width = (texture->texture.id > 0) ? texture->texture.width : texture->image.width;
+    int height = (texture->texture.id > 0) ? texture->texture.height : texture->image.height;
+    int format = (texture->texture.id > 0) ? texture->texture.format : texture->image.format;
+    if (width <= 0 || height <= 0) return texture;
 
-	while (head) {
-		if (head->visible) {
-            Rectangle dest = (Rectangle) {
-                (float)posX + (float)head->x,
-                (float)posY + (float)head->y,
-                (float)head->width,
-                (float)head->height
-            };
-            switch (head->obj_type)
-            {
-                case OT_SQUARE:
-				    DrawRectangleLinesEx(dest, (int)RAYLIB_TMX_LINE_THICKNESS, color);
-                    break;
-                case OT_POLYGON:
-                    DrawTMXPolygon(dest.x, dest.y, head->content.shape->points, head->content.shape->points_len, color);
-                    break;
-                case OT_POLYLINE:
-                    DrawTMXPolyline(dest.x, dest.y, head->content.shape->points, head->content.shape->points_len, color);
-                    break;
-                case OT_ELLIPSE: {
-                    int centerX   = (int)(dest.x + head->width  / 2.0);
-                    int centerY   = (int)(dest.y + head->height / 2.0);
-                    float radiusH = (float)head->width / 2.0f;
-                    float radiusV = (float)head->height / 2.0f;
-                    DrawEllipseLines(centerX, centerY, radiusH, radiusV, color);
-                } break;
-		        case OT_TILE: {
-		            int baseGid = head->content.gid;
-                    int gid = baseGid & TMX_FLIP_BITS_REMOVAL;
-		            if (!map->tiles[gid]) continue;
-			        tmx_tile *tile = map->tiles[gid];
-                    if (tile->animation) UpdateTMXTileAnimation(map, &tile);
-			        DrawTMXObjectTile(tile, baseGid, dest, (float)head->rotation, tint);
-		        } break;
-                case OT_TEXT: {
-                    tmx_text* text = head->content.text;
-                    Color textColor = ColorFromTMX(text->color);
-                    // TODO: Fix application of the tint.
-                    textColor.a = tint.a;
-                    DrawTMXText(text, dest, textColor);
-                } break;
-                case OT_POINT: {
-                    int centerX = (int)(dest.x + head->width  / 2.0);
-                    int centerY = (int)(dest.y + head->height / 2.0);
-                    DrawCircle(centerX, centerY, 5.0f, color);
-                } break;
-		        case OT_NONE: break;
-            }
-		}
-		head = head->next;
-	}
+    LockTMXTextureCache();
+    RaylibTMXTexture *cached = raylibTMXTextures;
+    while (cached != NULL && strcmp(cached->path, path) != 0) cached = cached->next;
+    if (cached != NULL) {
+        cached->refCount++;
+    }
+    else {
+        size_t length = strlen(path);
+        texture->path = (char *)MemAlloc((unsigned int)(length + 1));
+        memcpy(texture->path, path, length + 1);
+        texture->bytes = (unsigned int)GetPixelDataSize(width, height, format);
+        texture->next = raylibTMXTextures;
+        raylibTMXTextures = texture;
+        raylibTMXTextureStats.resident++;
+        raylibTMXTextureStats.residentBytes += texture->bytes;
+    }
+    UnlockTMXTextureCache();
+
+    if (cached != NULL) {
+        texture->refCount = 0;
+        UnloadTMXImage(texture);
+        return cached;
+    }
+    return texture;
 }
 
 /**
- * @internal
+ * Get statistics about the textures shared between the loaded maps.
+ *
+ * @return How many image loads were served from the cache, how many had to load the image, and the textures currently loaded.
  */
-void DrawTMXLayerImage(tmx_image *image, int posX, int posY, Color tint) {
-    if (image->resource_image) {
-        Texture2D *texture = (Texture2D*)image->resource_image;
-        DrawTexture(*texture, posX, posY, tint);
-    }
+RaylibTMXTextureCacheStats GetTMXTextureCacheStats(void) {
+    LockTMXTextureCache();
+    RaylibTMXTextureCacheStats stats = raylibTMXTextureStats;
+    UnlockTMXTextureCache();
+    return stats;
 }
 
 /**
+ * Loads the provided path as a Texture for use with TMX.
+ *
+ * When loading a map from memory, the image is read through the file data callback and decoded
+ * with LoadImageFromMemory(). When loading on a worker thread, the image is only decoded, and
+ * uploaded later by UploadTMXImage().
+ *
+ * @param fileName The file path of the image to load.
+ *
+ * Textures are shared by every map using the same image path, and only unloaded once no map uses
+ * them anymore.
+ *
+ * @return A void pointer representation of the Texture, a RaylibTMXTexture.
+ *
+ * @see UnloadTMXImage()
+ *
  * @internal
  */
-void UpdateTMXTileAnimation(tmx_map* map, tmx_tile** tile){
-    tmx_tile* currentTile = *tile;
-    AnimationState* animState = (AnimationState*) currentTile->user_data.pointer;
-    if (!animState) {
-        animState = malloc(sizeof(AnimationState));
-        animState->currentFrame = 0;
-        animState->frameCounter = 0.0f;
-	    currentTile->user_data.pointer = animState;
+void *LoadTMXImage(const char *fileName) {
+    char path[RAYLIB_TMX_MAX_PATH];
+    JoinTMXPath(path, raylibTMXBasePath, fileName);
+    RaylibTMXTexture *returnValue = AcquireTMXTexture(path);
+    if (returnValue != NULL) {
+        if (!raylibTMXDecodeOnly) UploadTMXImage(returnValue);
+        return returnValue;
     }
-    int*   currentFrame      = &animState->currentFrame;
-    float* frameCounter      = &animState->frameCounter;
-    int    animationLength   = (int)currentTile->animation_len;
-    tmx_anim_frame animation = currentTile->animation[*currentFrame];
-    float  frameThreshold    = (float)(GetFPS() * (int)animation.duration) / 1000.0f;    
 
-    (*frameCounter)++;
-    if (*frameCounter >= (frameThreshold)) {
-	    *frameCounter = 0;
-	    (*currentFrame)++;
-	    if (*currentFrame >= animationLength) *currentFrame = 0;
+	returnValue = MemAlloc(sizeof(RaylibTMXTexture));
+    returnValue->refCount = 1;
+    if (raylibTMXBasePath == NULL) {
+        if (raylibTMXDecodeOnly) {
+            returnValue->image = LoadImage(fileName);
+        }
+        else {
+            returnValue->texture = LoadTexture(fileName);
+        }
+        return CacheTMXTexture(path, returnValue);
     }
 
-    tmx_tileset_list* tileset_list = map->ts_head;
-    while (tileset_list) {
-        if (currentTile->tileset == tileset_list->tileset) {
-            unsigned int gid = tileset_list->firstgid + animation.tile_id;
-            if (map->tiles[gid]) {
-                *tile = map->tiles[gid];
-                return;
-            }
-        }
-        tileset_list = tileset_list->next;
+    int dataSize = 0;
+    unsigned char *data = LoadTMXFileData(path, &dataSize);
+    if (data == NULL) {
+        TraceLog(LOG_WARNING, "TMX: Failed to read image %s", path);
+        return returnValue;
+    }
+    Image image = LoadImageFromMemory(GetFileExtension(path), data, dataSize);
+    MemFree(data);
+    if (raylibTMXDecodeOnly) {
+        returnValue->image = image;
+        return CacheTMXTexture(path, returnValue);
     }
+    returnValue->texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+	return CacheTMXTexture(path, returnValue);
 }
 
 /**
- * Render a single TMX tile on the screen.
+ * Reallocate memory function callback for TMX.
  *
- * @param tile Which tile to render on the screen.
- * @param posX The X position of the tile.
- * @param posY The Y position of the tile.
- * @param tint How to tint the tile when rendering.
+ * @internal
  */
-void DrawTMXTile(tmx_tile* tile, unsigned int baseGid, int posX, int posY, Color tint) {
-    Texture* image = NULL;
-    Rectangle srcRect;
-    Vector2 origin = {0};
-    float rotation = 0;
+void* MemReallocTMX(void* address, size_t len) {
+    return MemRealloc(address, (unsigned int)len);
+}
 
-    srcRect.x      = (float)tile->ul_x;
-    srcRect.y      = (float)tile->ul_y;
-    srcRect.width  = (float)tile->tileset->tile_width;
-    srcRect.height = (float)tile->tileset->tile_height;
+#ifndef RAYLIB_TMX_CHUNK_SIZE
+#define RAYLIB_TMX_CHUNK_SIZE 32    // Width and height, in cells, of the chunks a tile layer is split into
+#endif
 
-    Rectangle destRect = srcRect;
-    destRect.x = (float)posX;
-    destRect.y = (float)posY;
+/**
+ * The baked render textures of a single tile layer.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXCacheEntry {
+    struct RaylibTMXLayerCache *cache;
+    int index;                          // Chunk of the cache that is baked
+    struct RaylibTMXCacheEntry *previous;   // Chunk drawn or streamed less recently
+    struct RaylibTMXCacheEntry *next;       // Chunk drawn or streamed more recently
+} RaylibTMXCacheEntry;
 
-    int flags = (int)baseGid & ~TMX_FLIP_BITS_REMOVAL;
-    if  (flags) {
-        int is_diagonally_fliped   = (baseGid & TMX_FLIPPED_DIAGONALLY);
-        int is_horizontally_fliped = (int)(baseGid & TMX_FLIPPED_HORIZONTALLY);
-        int is_vertically_fliped   = (baseGid & TMX_FLIPPED_VERTICALLY);
-	    if (is_diagonally_fliped) {
-            if (is_horizontally_fliped && is_vertically_fliped) {
-                srcRect.height = (float) -fabs(srcRect.height);
-                rotation = 270.0f;
-            } else if (is_horizontally_fliped) {
-                rotation = 90.0f;
-            } else if (is_vertically_fliped) {
-                rotation = 270.0f;
-            } else {
-                srcRect.height = (float) -fabs(srcRect.height);
-                rotation = -270.0f;
-            }
-            origin.x    = destRect.width  * 0.5f;
-            origin.y    = destRect.height * 0.5f;
-            destRect.x += origin.x;
-            destRect.y += origin.y;
-	    } else {
-            if (is_horizontally_fliped) {
-		        srcRect.width =  (float) -fabs(srcRect.width);
-	        }
-            if (is_vertically_fliped) {
-		        srcRect.height = (float) -fabs(srcRect.height);
-	        }
-        }
-    }
+typedef struct RaylibTMXLayerCache {
+    tmx_layer *layer;
+    bool unbaked;                       // Whether the layer is drawn tile by tile, see IsTMXCellBakeable()
+    int chunksX, chunksY;
+    RenderTexture2D *chunks;            // A chunk with an id of 0 has not been baked yet
+    bool *dirty;
+    RaylibTMXCacheEntry **entries;      // Place of each baked chunk in RaylibTMXState.leastUsed, NULL when not baked
+    struct RaylibTMXLayerCache *next;
+} RaylibTMXLayerCache;
 
-    // Find the image
-    tmx_image *im = tile->image;    
-    if (im && im->resource_image) {
-        image = (Texture*)im->resource_image;
-    }
-    else if (tile->tileset->image->resource_image) {
-        image = (Texture*)tile->tileset->image->resource_image;
-    }
+#ifndef RAYLIB_TMX_INDEX_BUCKET_SIZE
+#define RAYLIB_TMX_INDEX_BUCKET_SIZE 4      // Width and height, in cells, of the buckets of the collision index
+#endif
 
-    if (image) {
-        DrawTexturePro(*image, srcRect, destRect, origin, rotation, tint);
-    }
-}
+#ifndef RAYLIB_TMX_OBJECT_GRID_MIN
+#define RAYLIB_TMX_OBJECT_GRID_MIN 64       // Object layers with fewer objects are drawn without their grid
+#endif
+
+#ifndef RAYLIB_TMX_MOVE_EPSILON
+#define RAYLIB_TMX_MOVE_EPSILON 0.001f      // Distance within which MoveTMXRect() considers a rectangle to touch a cell
+#endif
 
 /**
- * Render a single TMX tile of a TMX Object on the screen.
+ * The objects of an object layer, bucketed by the area they're drawn over.
  *
- * @param tile      Which tile to render on the screen.
- * @param gid       The GID of the object used to calculate it flags
- * @param destRect  The destination of the tile on screen
- * @param rotation  The rotation of the tile on screen
- * @param tint      How to tint the tile when rendering.
+ * Objects are numbered in the order they're drawn, so the objects found by a query are drawn in the
+ * same order as when walking the layer.
+ *
+ * @internal
  */
-void DrawTMXObjectTile(tmx_tile* tile, int baseGid, Rectangle destRect, float rotation, Color tint) {
-    Texture* image = NULL;
-    Vector2 origin = {0};
+typedef struct RaylibTMXObjectGrid {
+    tmx_object_group *group;
+    int bucketsX, bucketsY;
+    float bucketWidth, bucketHeight;
+    int *bucketStarts;                  // First entry of each bucket, followed by the entry count
+    int *entries;                       // Indices of the objects in each bucket
+    int objectCount;
+    tmx_object **objects;
+    unsigned int *stamps;               // Last query that visited each object
+    unsigned int stamp;
+    int *found;                         // Objects found by the last query
+    int unboundedCount;
+    int *unbounded;                     // Objects whose drawn area isn't known, such as texts, always drawn
+    struct RaylibTMXObjectGrid *next;
+} RaylibTMXObjectGrid;
+
+/**
+ * The bounds of a list of collisions, one array per edge, so that they're tested several at a time.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXBoxes {
+    float *minX, *minY, *maxX, *maxY;   // All four arrays share the allocation of minX
+} RaylibTMXBoxes;
+
+/**
+ * Collisions baked for a chunk of a tile layer, or for an object layer.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXColliderBlock {
+    RaylibTMXCollider *colliders;
+    int colliderCount, colliderCapacity;
+    int *vertexStarts;                  // First point of each collider, -1 when it has no points
+    Vector2 *vertices;                  // Points of the polygons and polylines of the colliders
+    int vertexCount, vertexCapacity;
+    int *starts;                        // First collider of each cell or object, followed by the collider count
+    RaylibTMXBoxes boxes;               // Bounds of the colliders, in the same order
+    int boxCapacity;
+    bool dirty;                         // Whether the tiles of the chunk changed since it was baked, or it was unloaded
+    bool cooked;                        // Whether the starts, vertices and boxes point into the data of a cooked map
+    struct RaylibTMXColliderBlock *lessUsed;    // Chunk queried less recently, when baked for a tile layer
+    struct RaylibTMXColliderBlock *moreUsed;    // Chunk queried more recently
+} RaylibTMXColliderBlock;
+
+/**
+ * The cells of a tile layer that hold a solid tile, one bit per cell.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXSolidMask {
+    tmx_layer *layer;                   // NULL for the cells that are solid in any of the visible tile layers
+    int width, height;                  // In cells
+    float cellWidth, cellHeight;
+    int stride;                         // Words per row
+    uint64_t *bits;
+    bool combined;                      // Whether the layer was visible, and so part of the mask of all layers
+    bool cooked;                        // Whether the bits point into the data of a cooked map
+    struct RaylibTMXSolidMask *next;
+} RaylibTMXSolidMask;
+
+#ifndef RAYLIB_TMX_PATH_CLUSTER_SIZE
+#define RAYLIB_TMX_PATH_CLUSTER_SIZE 16     // Width and height, in cells, of the clusters of the pathfinding graph
+#endif
+
+#ifndef RAYLIB_TMX_PATH_SHORT
+#define RAYLIB_TMX_PATH_SHORT 32            // Distance, in cells, under which paths are first searched on the grid directly
+#endif
+
+#define RAYLIB_TMX_PATH_ENTRANCE_SPLIT 6    // Openings between clusters this wide get an entrance at each end, rather than one in the middle
+#define RAYLIB_TMX_PATH_MAX_NODES (RAYLIB_TMX_PATH_CLUSTER_SIZE * 4)
+
+/**
+ * A cluster of cells of the pathfinding graph, with its entrances to the neighboring clusters.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXPathCluster {
+    int nodeCount;
+    int borderStarts[5];                // First node on the north, east, south and west borders, then the node count
+    int nodeCells[RAYLIB_TMX_PATH_MAX_NODES];   // Cell of each entrance node, in this cluster
+    float *distances;                   // Shortest path within the cluster between each pair of nodes, FLT_MAX when there's none
+    bool dirty;                         // Whether cells of the cluster, or its borders, changed since it was built
+} RaylibTMXPathCluster;
+
+typedef struct RaylibTMXPathHeapItem {
+    float estimate;
+    int node;
+} RaylibTMXPathHeapItem;
+
+/**
+ * The memory used by a path search, one per thread so that searches can run in parallel.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXPathSearch {
+    int capacity;                       // Cells, or graph nodes, the arrays below can hold
+    float *costs;
+    int *parents;
+    unsigned int *stamps;               // Equal to stamp when a node was reached, stamp + 1 once it's closed
+    unsigned int stamp;
+    RaylibTMXPathHeapItem *heap;
+    int heapCount, heapCapacity;
+    int *route;                         // Cells of the path being built
+    int routeCount, routeCapacity;
+    int *nodes;                         // Graph nodes of the path being refined
+    int nodeCapacity;
+    float startCosts[RAYLIB_TMX_PATH_MAX_NODES];    // Costs from the start to the nodes of its cluster
+    float goalCosts[RAYLIB_TMX_PATH_MAX_NODES];     // Costs from the nodes of the goal's cluster to the goal
+} RaylibTMXPathSearch;
+
+/**
+ * The pathfinding graph of a map: clusters of cells linked through the openings between them.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXPathGraph {
+    const RaylibTMXSolidMask *mask;     // Solid cells of all visible tile layers
+    int clustersX, clustersY;
+    RaylibTMXPathCluster *clusters;
+    bool dirty;                         // Whether any cluster is dirty
+    RaylibTMXPathSearch searches[RAYLIB_TMX_MAX_WORKERS];
+} RaylibTMXPathGraph;
+
+/**
+ * A rectangle of cells that path searches stay within.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXPathGrid {
+    const RaylibTMXSolidMask *mask;
+    int minX, minY, maxX, maxY;         // Inclusive
+} RaylibTMXPathGrid;
+
+/**
+ * The collisions of a tile layer, baked per chunk, or of an object layer.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXLayerColliders {
+    tmx_layer *layer;
+    int chunksX, chunksY;               // Object layers have a single block
+    RaylibTMXColliderBlock *blocks;
+    int binsX, binsY;                   // Object layers sort their colliders into bins by top-left corner
+    float binWidth, binHeight;
+    int *binStarts;                     // First entry of each bin, then of the colliders larger than a bin, then the entry count
+    int *binColliders;                  // Collider of each entry
+    RaylibTMXBoxes binBoxes;            // Bounds of each entry
+    struct RaylibTMXLayerColliders *next;
+} RaylibTMXLayerColliders;
+
+#ifndef RAYLIB_TMX_ATLAS_SIZE
+#define RAYLIB_TMX_ATLAS_SIZE 2048          // Width, and maximum height, of the atlases made by PackTMXAtlas()
+#endif
+
+#ifndef RAYLIB_TMX_ATLAS_PADDING
+#define RAYLIB_TMX_ATLAS_PADDING 1          // Empty pixels kept between the images of an atlas
+#endif
+
+#ifndef RAYLIB_TMX_MESH_BATCH_QUADS
+#define RAYLIB_TMX_MESH_BATCH_QUADS 1024    // Maximum amount of quads submitted to rlgl between batch limit checks
+#endif
+
+/**
+ * Quads of a mesh region that all sample the same texture.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXMeshBatch {
+    Texture2D *texture;
+    int quadCount;
+    int quadCapacity;
+    float *vertices;                    // 4 vertices of (x, y) per quad, relative to the layer
+    float *texcoords;                   // 4 texture coordinates of (u, v) per quad
+} RaylibTMXMeshBatch;
+
+/**
+ * Geometry for one chunk of cells of a tile layer.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXMeshRegion {
+    bool dirty;
+    int batchCount;
+    RaylibTMXMeshBatch *batches;
+    int animatedCount;
+    int *animatedCells;                 // Animated cells change every frame, so are drawn tile by tile
+    bool overlapping;                   // Whether a tile reaches out of its cell, see IsTMXTileInsideCell()
+} RaylibTMXMeshRegion;
+
+/**
+ * Vertex batches built for a tile layer, one region per chunk of cells.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXLayerMesh {
+    tmx_layer *layer;
+    int regionsX, regionsY;
+    RaylibTMXMeshRegion *regions;
+    struct RaylibTMXLayerMesh *next;
+} RaylibTMXLayerMesh;
+
+// Rotation codes of compiled cells, see CompileTMX()
+#define RAYLIB_TMX_ROTATE_NONE      0
+#define RAYLIB_TMX_ROTATE_90        1
+#define RAYLIB_TMX_ROTATE_270       2
+#define RAYLIB_TMX_ROTATE_MINUS_270 3
+#define RAYLIB_TMX_ROTATE_ANIMATED  0x80    // Set on animated cells, which are resolved when drawn
+
+/**
+ * Draw records for every cell of a tile layer, stored as a structure of arrays.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXCompiledLayer {
+    tmx_layer *layer;
+    unsigned short *texture;            // Index in the map's texture table plus one, 0 for empty cells
+    unsigned char *rotation;            // RAYLIB_TMX_ROTATE_* code
+    Rectangle *source;                  // Source rectangle, flips applied as negative sizes
+    Vector2 *offset;                    // Offset of the destination from the cell position
+    struct RaylibTMXCompiledLayer *next;
+} RaylibTMXCompiledLayer;
+
+/**
+ * An animated tile of a map, and where its frames are found.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXAnimation {
+    unsigned int gid;
+    unsigned int *frameGids;            // GID of each frame of the animation
+    tmx_tile *tile;
+} RaylibTMXAnimation;
+
+/**
+ * The custom properties of a part of a cooked map, which libtmx can't look up as they're not in
+ * one of its hash tables.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXCookedProperties {
+    const void *owner;                  // The map, layer, tile, object or class property holding them
+    int count;
+    tmx_property *properties;
+} RaylibTMXCookedProperties;
+
+/**
+ * The data behind a map loaded with LoadTMXCooked(), which owns the map's structures.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXCooked {
+    void *data;                         // Contents of the cooked file, which strings and GIDs point into
+    size_t size;
+    bool mapped;                        // Whether the data is a memory mapping, rather than a copy
+    void *allocations;                  // Chain of the structures allocated for the map
+    RaylibTMXCookedProperties *properties;  // Sorted by owner
+    int propertyCount;
+} RaylibTMXCooked;
+
+/**
+ * Data that raylib-tmx keeps alongside each loaded map.
+ *
+ * This is kept outside of the map, so that tmx_map.user_data remains available to applications.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXState {
+    tmx_map *map;
+    bool cacheEnabled;
+    int cacheBudget;                    // Maximum amount of baked chunks, 0 for no limit
+    int cacheResident;                  // Amount of baked chunks
+    RaylibTMXCacheEntry *leastUsed;     // Baked chunks of every layer, from the least recently used
+    RaylibTMXCacheEntry *mostUsed;      // Last of the baked chunks, the most recently used
+    RaylibTMXLayerCache *layerCaches;
+    unsigned char *translucentTiles;    // Whether the tile of each GID has partly transparent pixels, NULL until a layer is cached
+    RaylibTMXLayerMesh *layerMeshes;
+    RaylibTMXCompiledLayer *compiledLayers;
+    Texture2D **textures;               // Texture table that compiled cells index into
+    int textureCount;
+    int tilesetSlots;                   // Size of the tileset hash table, a power of two
+    tmx_tileset **tilesetKeys;
+    unsigned int *tilesetFirstGids;
+    bool animationsLoaded;
+    bool animationsUpdated;             // Whether the application advances the animations itself
+    double lastAdvance;                 // GetTime() of the last draw that advanced the animations, 0 before the first
+    int animationCount;
+    RaylibTMXAnimation *animations;     // Sorted by GID
+    AnimationState *animationStates;    // State of each animation, in the same order
+    unsigned int *animationFrameGids;   // Frame GIDs of all animations, see RaylibTMXAnimation
+    tmx_tile **animationFrames;         // GID indexed tile of the current frame, for animated tiles
+    bool indexLoaded;
+    int indexBucketsX, indexBucketsY;
+    float indexBucketWidth, indexBucketHeight;
+    int *indexBucketStarts;             // First entry of each bucket, followed by the entry count
+    int *indexEntries;                  // Indices of the objects in each bucket
+    int indexObjectCount;
+    tmx_object **indexObjects;
+    Rectangle *indexBounds;
+    const RaylibTMXCollider **indexColliders;   // Baked collisions of each indexed object
+    int *indexColliderCounts;
+    unsigned int *indexStamps;          // Last query that visited each object
+    unsigned int indexStamp;
+    RaylibTMXObjectGrid *objectGrids;   // Drawing grids of the larger object layers
+    RaylibTMXLayerColliders *layerColliders;    // Collisions of the layers, in map coordinates
+    int colliderResident;               // Amount of baked chunks of tile layer collisions, bounded by the cache budget as well
+    RaylibTMXColliderBlock *leastUsedBlock; // Baked chunks of tile layer collisions, from the least recently queried
+    RaylibTMXColliderBlock *mostUsedBlock;  // Last of the baked chunks, the most recently queried
+    RaylibTMXSolidMask *solidMasks;     // Solid cells of all visible tile layers, then of each tile layer
+    unsigned char *solidTiles;          // Whether the tile of each GID is solid
+    char *solidProperty;                // Tile property making tiles solid, NULL to use their collisions
+    RaylibTMXPathGraph *pathGraph;      // Built from the solid masks by the first path search
+    tmx_resource_manager *resourceManager;  // Holds the external tilesets of maps loaded from memory
+    RaylibTMXCooked cooked;             // Set on maps loaded with LoadTMXCooked()
+    struct RaylibTMXState *next;
+} RaylibTMXState;
+
+static RaylibTMXState *raylibTMXStates = NULL;
+
+/**
+ * Find the state raylib-tmx holds for the given map.
+ *
+ * @param map The map to find the state for.
+ * @param create Whether or not to create the state when the map doesn't have any yet.
+ *
+ * @return The state of the map, or NULL if it has none.
+ *
+ * @internal
+ */
+RaylibTMXState *GetTMXState(tmx_map *map, bool create) {
+    for (RaylibTMXState *state = raylibTMXStates; state != NULL; state = state->next) {
+        if (state->map == map) return state;
+    }
+    if (!create) return NULL;
+
+    RaylibTMXState *state = (RaylibTMXState *)MemAlloc(sizeof(RaylibTMXState));
+    state->map = map;
+    state->next = raylibTMXStates;
+    raylibTMXStates = state;
+    return state;
+}
+
+/**
+ * Unload the baked chunks of every cached layer.
+ *
+ * @internal
+ */
+void UnloadTMXLayerCaches(RaylibTMXState *state) {
+    RaylibTMXLayerCache *cache = state->layerCaches;
+    while (cache) {
+        RaylibTMXLayerCache *next = cache->next;
+        if (cache->chunks) {
+            for (int i = 0; i < cache->chunksX * cache->chunksY; i++) {
+                if (cache->chunks[i].id > 0) UnloadRenderTexture(cache->chunks[i]);
+                MemFree(cache->entries[i]);
+            }
+            MemFree(cache->chunks);
+        }
+        MemFree(cache->dirty);
+        MemFree(cache->entries);
+        MemFree(cache);
+        cache = next;
+    }
+    state->layerCaches = NULL;
+    state->cacheResident = 0;
+    state->leastUsed = NULL;
+    state->mostUsed = NULL;
+}
+
+/**
+ * Unload the geometry of a single mesh region.
+ *
+ * @internal
+ */
+void UnloadTMXMeshRegion(RaylibTMXMeshRegion *region) {
+    for (int i = 0; i < region->batchCount; i++) {
+        MemFree(region->batches[i].vertices);
+        MemFree(region->batches[i].texcoords);
+    }
+    MemFree(region->batches);
+    MemFree(region->animatedCells);
+    *region = (RaylibTMXMeshRegion){0};
+}
+
+/**
+ * Unload the regions of a layer mesh, and the mesh itself.
+ *
+ * @internal
+ */
+void UnloadTMXMesh(RaylibTMXLayerMesh *mesh) {
+    for (int i = 0; i < mesh->regionsX * mesh->regionsY; i++) {
+        UnloadTMXMeshRegion(&mesh->regions[i]);
+    }
+    MemFree(mesh->regions);
+    MemFree(mesh);
+}
+
+/**
+ * Unload the compiled draw records of every tile layer.
+ *
+ * @internal
+ */
+void UnloadTMXCompiledLayers(RaylibTMXState *state) {
+    while (state->compiledLayers) {
+        RaylibTMXCompiledLayer *next = state->compiledLayers->next;
+        MemFree(state->compiledLayers->texture);
+        MemFree(state->compiledLayers->rotation);
+        MemFree(state->compiledLayers->source);
+        MemFree(state->compiledLayers->offset);
+        MemFree(state->compiledLayers);
+        state->compiledLayers = next;
+    }
+    MemFree(state->textures);
+    state->textures = NULL;
+    state->textureCount = 0;
+}
+
+/**
+ * Unload the drawing grids of the map's object layers.
+ *
+ * @internal
+ */
+void UnloadTMXObjectGrids(RaylibTMXState *state) {
+    while (state->objectGrids) {
+        RaylibTMXObjectGrid *next = state->objectGrids->next;
+        MemFree(state->objectGrids->bucketStarts);
+        MemFree(state->objectGrids->entries);
+        MemFree(state->objectGrids->objects);
+        MemFree(state->objectGrids->stamps);
+        MemFree(state->objectGrids->found);
+        MemFree(state->objectGrids->unbounded);
+        MemFree(state->objectGrids);
+        state->objectGrids = next;
+    }
+}
+
+/**
+ * Unload the collisions baked for a chunk of a tile layer, or for an object layer.
+ *
+ * The block is left empty and dirty, so that a chunk is baked again the next time it's queried.
+ *
+ * @internal
+ */
+void UnloadTMXColliderBlock(RaylibTMXColliderBlock *block) {
+    MemFree(block->colliders);
+    MemFree(block->vertexStarts);
+    if (!block->cooked) {
+        MemFree(block->vertices);
+        MemFree(block->starts);
+        MemFree(block->boxes.minX);
+    }
+    *block = (RaylibTMXColliderBlock){0};
+    block->dirty = true;
+}
+
+/**
+ * Unload the collisions baked for the layers of the map.
+ *
+ * @internal
+ */
+void UnloadTMXColliders(RaylibTMXState *state) {
+    while (state->layerColliders) {
+        RaylibTMXLayerColliders *next = state->layerColliders->next;
+        for (int i = 0; i < state->layerColliders->chunksX * state->layerColliders->chunksY; i++) {
+            UnloadTMXColliderBlock(&state->layerColliders->blocks[i]);
+        }
+        MemFree(state->layerColliders->blocks);
+        MemFree(state->layerColliders->binStarts);
+        MemFree(state->layerColliders->binColliders);
+        MemFree(state->layerColliders->binBoxes.minX);
+        MemFree(state->layerColliders);
+        state->layerColliders = next;
+    }
+    state->colliderResident = 0;
+    state->leastUsedBlock = NULL;
+    state->mostUsedBlock = NULL;
+}
+
+/**
+ * Unload the pathfinding graph of the map, and the memory of its searches.
+ *
+ * @internal
+ */
+void UnloadTMXPathGraph(RaylibTMXState *state) {
+    RaylibTMXPathGraph *graph = state->pathGraph;
+    if (graph == NULL) return;
+    for (int i = 0; i < graph->clustersX * graph->clustersY; i++) MemFree(graph->clusters[i].distances);
+    for (int i = 0; i < RAYLIB_TMX_MAX_WORKERS; i++) {
+        RaylibTMXPathSearch *search = &graph->searches[i];
+        MemFree(search->costs);
+        MemFree(search->parents);
+        MemFree(search->stamps);
+        MemFree(search->heap);
+        MemFree(search->route);
+        MemFree(search->nodes);
+    }
+    MemFree(graph->clusters);
+    MemFree(graph);
+    state->pathGraph = NULL;
+}
+
+/**
+ * Unload the solid cell masks of the map's tile layers, and the pathfinding graph built from them.
+ *
+ * @internal
+ */
+void UnloadTMXSolidMasks(RaylibTMXState *state) {
+    UnloadTMXPathGraph(state);
+    while (state->solidMasks) {
+        RaylibTMXSolidMask *next = state->solidMasks->next;
+        if (!state->solidMasks->cooked) MemFree(state->solidMasks->bits);
+        MemFree(state->solidMasks);
+        state->solidMasks = next;
+    }
+    MemFree(state->solidTiles);
+    state->solidTiles = NULL;
+}
+
+/**
+ * Unload the collision index of the map, with the collisions and solid masks baked for it, and the
+ * drawing grids of its object layers.
+ *
+ * @internal
+ */
+void UnloadTMXCollisionIndex(RaylibTMXState *state) {
+    UnloadTMXObjectGrids(state);
+    UnloadTMXColliders(state);
+    UnloadTMXSolidMasks(state);
+    MemFree(state->indexObjects);
+    MemFree(state->indexBounds);
+    MemFree(state->indexColliders);
+    MemFree(state->indexColliderCounts);
+    MemFree(state->indexStamps);
+    MemFree(state->indexBucketStarts);
+    MemFree(state->indexEntries);
+    state->indexObjects = NULL;
+    state->indexBounds = NULL;
+    state->indexColliders = NULL;
+    state->indexColliderCounts = NULL;
+    state->indexStamps = NULL;
+    state->indexBucketStarts = NULL;
+    state->indexEntries = NULL;
+    state->indexObjectCount = 0;
+    state->indexLoaded = false;
+}
+
+/**
+ * Unload, and forget, the state held for the given map.
+ *
+ * @internal
+ */
+void UnloadTMXState(tmx_map *map) {
+    RaylibTMXState **link = &raylibTMXStates;
+    while (*link) {
+        RaylibTMXState *state = *link;
+        if (state->map == map) {
+            *link = state->next;
+            UnloadTMXLayerCaches(state);
+            MemFree(state->translucentTiles);
+            while (state->layerMeshes) {
+                RaylibTMXLayerMesh *next = state->layerMeshes->next;
+                UnloadTMXMesh(state->layerMeshes);
+                state->layerMeshes = next;
+            }
+            UnloadTMXCompiledLayers(state);
+            UnloadTMXCollisionIndex(state);
+            MemFree(state->solidProperty);
+            MemFree(state);
+            return;
+        }
+        link = &state->next;
+    }
+}
+
+/**
+ * Find the slot of a tileset in the tileset hash table of the map.
+ *
+ * @return The index of the slot holding the tileset, or of the empty slot it would go in.
+ *
+ * @internal
+ */
+int GetTMXTilesetSlot(RaylibTMXState *state, tmx_tileset *tileset) {
+    unsigned int mask = (unsigned int)state->tilesetSlots - 1;
+    unsigned int slot = ((unsigned int)((uintptr_t)tileset >> 4) * 2654435761u) & mask;
+    while (state->tilesetKeys[slot] != NULL && state->tilesetKeys[slot] != tileset) {
+        slot = (slot + 1) & mask;
+    }
+    return (int)slot;
+}
+
+/**
+ * Build the tables used for GID math: the first GID of each tileset, the animated tiles and the GIDs
+ * of their frames.
+ *
+ * @return The state of the map, with its tables loaded.
+ *
+ * @internal
+ */
+RaylibTMXState *LoadTMXTables(tmx_map *map) {
+    RaylibTMXState *state = GetTMXState(map, true);
+    if (state->animationsLoaded) return state;
+    state->animationsLoaded = true;
+
+    // Hash the tilesets by their pointer, keeping the table at most half full.
+    int tilesetCount = 0;
+    for (tmx_tileset_list *ts = map->ts_head; ts != NULL; ts = ts->next) tilesetCount++;
+    state->tilesetSlots = 8;
+    while (state->tilesetSlots < tilesetCount * 2) state->tilesetSlots *= 2;
+    state->tilesetKeys = (tmx_tileset **)MemAlloc((unsigned int)state->tilesetSlots * sizeof(tmx_tileset *));
+    state->tilesetFirstGids = (unsigned int *)MemAlloc((unsigned int)state->tilesetSlots * sizeof(unsigned int));
+    for (tmx_tileset_list *ts = map->ts_head; ts != NULL; ts = ts->next) {
+        int slot = GetTMXTilesetSlot(state, ts->tileset);
+        if (state->tilesetKeys[slot] != NULL) continue;
+        state->tilesetKeys[slot] = ts->tileset;
+        state->tilesetFirstGids[slot] = ts->firstgid;
+    }
+
+    // Count the animations and their frames, so their tables are allocated once.
+    int frameCount = 0;
+    for (unsigned int gid = 0; gid < map->tilecount; gid++) {
+        tmx_tile *tile = map->tiles[gid];
+        if (tile == NULL || tile->animation == NULL || tile->animation_len == 0) continue;
+        state->animationCount++;
+        frameCount += (int)tile->animation_len;
+    }
+
+    state->animationFrames = (tmx_tile **)MemAlloc(map->tilecount * sizeof(tmx_tile *));
+    if (state->animationCount == 0) return state;
+    state->animations = (RaylibTMXAnimation *)MemAlloc((unsigned int)state->animationCount * sizeof(RaylibTMXAnimation));
+    state->animationStates = (AnimationState *)MemAlloc((unsigned int)state->animationCount * sizeof(AnimationState));
+    state->animationFrameGids = (unsigned int *)MemAlloc((unsigned int)frameCount * sizeof(unsigned int));
+
+    int animationIndex = 0;
+    unsigned int *frameGids = state->animationFrameGids;
+    for (unsigned int gid = 0; gid < map->tilecount; gid++) {
+        tmx_tile *tile = map->tiles[gid];
+        if (tile == NULL || tile->animation == NULL || tile->animation_len == 0) continue;
+
+        unsigned int firstGid = GetTMXTilesetFirstGid(map, tile->tileset);
+        for (unsigned int frame = 0; frame < tile->animation_len; frame++) {
+            unsigned int frameGid = firstGid + tile->animation[frame].tile_id;
+            frameGids[frame] = (frameGid < map->tilecount && map->tiles[frameGid]) ? frameGid : gid;
+        }
+
+        state->animations[animationIndex++] = (RaylibTMXAnimation){gid, frameGids, tile};
+        state->animationFrames[gid] = map->tiles[frameGids[0]];
+        frameGids += tile->animation_len;
+    }
+
+    return state;
+}
+
+/**
+ * Get the first global ID of a tileset, through the map's tileset table.
+ *
+ * @param map The map that uses the tileset.
+ * @param tileset The tileset to get the first GID of.
+ *
+ * @return The GID of the first tile in the tileset, or 0 if the map doesn't use the tileset.
+ */
+unsigned int GetTMXTilesetFirstGid(tmx_map *map, tmx_tileset *tileset) {
+    if (map == NULL || tileset == NULL) return 0;
+    RaylibTMXState *state = LoadTMXTables(map);
+    int slot = GetTMXTilesetSlot(state, tileset);
+    return (state->tilesetKeys[slot] == tileset) ? state->tilesetFirstGids[slot] : 0;
+}
+
+/**
+ * Get the global ID of a tile, which is the index of the tile in map->tiles.
+ *
+ * @param map The map that uses the tile.
+ * @param tile The tile to get the GID of.
+ *
+ * @return The GID of the tile, or 0 if the map doesn't use its tileset.
+ */
+unsigned int GetTMXTileGid(tmx_map *map, tmx_tile *tile) {
+    if (tile == NULL) return 0;
+    unsigned int firstGid = GetTMXTilesetFirstGid(map, tile->tileset);
+    return (firstGid == 0) ? 0 : firstGid + tile->id;
+}
+
+/**
+ * Get the animation state of an animated tile.
+ *
+ * The states are kept by raylib-tmx for each map, so tile->user_data remains free for applications.
+ *
+ * @param map The map that uses the tile.
+ * @param tile The animated tile.
+ *
+ * @return The animation state of the tile, or NULL if the tile isn't animated.
+ */
+AnimationState *GetTMXAnimationState(tmx_map *map, tmx_tile *tile) {
+    unsigned int gid = GetTMXTileGid(map, tile);
+    if (gid == 0) return NULL;
+
+    // The animations are stored in GID order.
+    RaylibTMXState *state = LoadTMXTables(map);
+    int low = 0, high = state->animationCount - 1;
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        if (state->animations[middle].gid == gid) return &state->animationStates[middle];
+        if (state->animations[middle].gid < gid) low = middle + 1;
+        else high = middle - 1;
+    }
+    return NULL;
+}
+
+/**
+ * Get the table holding the tile of the current animation frame for each GID.
+ *
+ * Entries are only set for animated tiles.
+ *
+ * @internal
+ */
+tmx_tile **GetTMXAnimationFrames(tmx_map *map) {
+    return LoadTMXTables(map)->animationFrames;
+}
+
+/**
+ * Advance the animations of the map, and update the table of current frames.
+ *
+ * @internal
+ */
+void AdvanceTMXAnimations(tmx_map *map, RaylibTMXState *state, float deltaTime) {
+    float elapsed = deltaTime * 1000.0f;
+    RAYLIB_TMX_STAT(animationUpdates, state->animationCount);
+    for (int i = 0; i < state->animationCount; i++) {
+        RaylibTMXAnimation *animation = &state->animations[i];
+        tmx_tile *tile = animation->tile;
+        AnimationState *animState = &state->animationStates[i];
+        int frame = animState->currentFrame;
+
+        animState->frameCounter += elapsed;
+        for (unsigned int skipped = 0; skipped < tile->animation_len; skipped++) {
+            float duration = (float)tile->animation[frame].duration;
+            if (animState->frameCounter < duration) break;
+            animState->frameCounter -= duration;
+            frame = (frame + 1) % (int)tile->animation_len;
+        }
+        if (animState->frameCounter >= (float)tile->animation[frame].duration) {
+            // Zero-length frames, or a huge delta; don't spin on them.
+            animState->frameCounter = 0.0f;
+        }
+
+        if (frame != animState->currentFrame) {
+            animState->currentFrame = frame;
+            state->animationFrames[animation->gid] = map->tiles[animation->frameGids[frame]];
+        }
+    }
+}
+
+/**
+ * Advance the animations by the time passed since the last draw that advanced them, unless the
+ * application advances them with UpdateTMXAnimations().
+ *
+ * Drawing a map several times in a frame, such as for a minimap, then adds up to the time that
+ * really passed, rather than advancing by the frame time on every draw.
+ *
+ * @internal
+ */
+void AdvanceTMXAnimationsOnDraw(tmx_map *map, RaylibTMXState *state) {
+    if (state->animationsUpdated) return;
+    double now = GetTime();
+    float deltaTime = (state->lastAdvance > 0.0) ? (float)(now - state->lastAdvance) : 0.0f;
+    state->lastAdvance = now;
+    AdvanceTMXAnimations(map, state, deltaTime);
+}
+
+/**
+ * Advance every animated tile of the map by the given time.
+ *
+ * Each animated tile is advanced once, no matter how many cells use it. Once called, DrawTMX() no
+ * longer advances the animations by itself, so call this once per frame.
+ *
+ * @param map The map holding the animated tiles.
+ * @param deltaTime The time passed since the last update, in seconds. Usually GetFrameTime().
+ */
+void UpdateTMXAnimations(tmx_map *map, float deltaTime) {
+    if (map == NULL) return;
+    RaylibTMXState *state = LoadTMXTables(map);
+    state->animationsUpdated = true;
+    AdvanceTMXAnimations(map, state, deltaTime);
+}
+
+/**
+ * Register the TMX callbacks.
+ *
+ * @internal
+ */
+void InitTMXCallbacks(void) {
+    tmx_alloc_func = MemReallocTMX;
+    tmx_free_func = MemFree;
+    tmx_img_load_func = LoadTMXImage;
+	tmx_img_free_func = UnloadTMXImage;
+}
+
+/**
+ * Skip the XML comment or CDATA section starting at the given position.
+ *
+ * @return The position right after the section, the end of the data when it isn't closed, or NULL when no section starts there.
+ *
+ * @internal
+ */
+const char *SkipTMXSection(const char *at, const char *end) {
+    static const char *const sections[][2] = {
+        { "<!--", "-->" },
+        { "<![CDATA[", "]]>" }
+    };
+    for (int i = 0; i < 2; i++) {
+        size_t openSize = strlen(sections[i][0]);
+        if ((size_t)(end - at) < openSize || memcmp(at, sections[i][0], openSize) != 0) continue;
+        size_t closeSize = strlen(sections[i][1]);
+        for (at += openSize; at + closeSize <= end; at++) {
+            if (memcmp(at, sections[i][1], closeSize) == 0) return at + closeSize;
+        }
+        return end;
+    }
+    return NULL;
+}
+
+/**
+ * Find the next source attribute of a <tileset> element in the given XML data.
+ *
+ * Comments and CDATA sections are skipped, so that a <tileset> written in them isn't mistaken for an element.
+ *
+ * @param source Where to copy the value of the attribute.
+ *
+ * @return The position to continue searching from, or NULL when there are no more external tilesets.
+ *
+ * @internal
+ */
+const char *FindTMXTilesetSource(const char *data, const char *end, char *source) {
+    static const char element[] = "<tileset";
+    static const char attribute[] = "source=\"";
+    const char *at = data;
+    while (at + sizeof(element) - 1 <= end) {
+        const char *skipped = SkipTMXSection(at, end);
+        if (skipped != NULL) {
+            at = skipped;
+            continue;
+        }
+        if (memcmp(at, element, sizeof(element) - 1) != 0) {
+            at++;
+            continue;
+        }
+        at += sizeof(element) - 1;
+        for (; at + sizeof(attribute) - 1 <= end && *at != '>'; at++) {
+            if (memcmp(at, attribute, sizeof(attribute) - 1) != 0) continue;
+            at += sizeof(attribute) - 1;
+            const char *close = memchr(at, '"', (size_t)(end - at));
+            if (close == NULL || close - at >= RAYLIB_TMX_MAX_PATH) return NULL;
+            memcpy(source, at, (size_t)(close - at));
+            source[close - at] = '\0';
+            return close;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Parse a .tmx map held in memory, without registering the map with raylib-tmx.
+ *
+ * External tilesets have to be registered in a resource manager, keyed by their source, before
+ * loading the map, so they're looked up ahead of time.
+ *
+ * @internal
+ */
+tmx_map *ParseTMXFromMemory(const unsigned char *data, int dataSize, const char *basePath, tmx_resource_manager **resourceManager) {
+    *resourceManager = NULL;
+    if (data == NULL || dataSize <= 0) return NULL;
+    const char *text = (const char *)data;
+    const char *end = text + dataSize;
+    const char *directory = (basePath != NULL) ? basePath : "";
+
+    char source[RAYLIB_TMX_MAX_PATH];
+    char path[RAYLIB_TMX_MAX_PATH];
+    char tilesetDirectory[RAYLIB_TMX_MAX_PATH];
+    for (const char *at = FindTMXTilesetSource(text, end, source); at != NULL; at = FindTMXTilesetSource(at, end, source)) {
+        JoinTMXPath(path, directory, source);
+        int tilesetSize = 0;
+        unsigned char *tileset = LoadTMXFileData(path, &tilesetSize);
+        if (tileset == NULL) {
+            TraceLog(LOG_WARNING, "TMX: Failed to read tileset %s", path);
+            continue;
+        }
+        if (*resourceManager == NULL) *resourceManager = tmx_make_resource_manager();
+
+        // The images of the tileset are relative to the tileset itself.
+        GetTMXDirectoryPath(tilesetDirectory, path);
+        raylibTMXBasePath = tilesetDirectory;
+        if (!tmx_load_tileset_buffer(*resourceManager, (const char *)tileset, tilesetSize, source)) {
+            TraceLog(LOG_WARNING, "TMX: Failed to load tileset %s: %s", path, tmx_strerr());
+        }
+        raylibTMXBasePath = NULL;
+        MemFree(tileset);
+    }
+
+    raylibTMXBasePath = directory;
+    tmx_map *map = (*resourceManager != NULL) ? tmx_rcmgr_load_buffer(*resourceManager, text, dataSize) : tmx_load_buffer(text, dataSize);
+    raylibTMXBasePath = NULL;
+    if (!map) TraceLog(LOG_ERROR, "TMX: Failed to load TMX from memory: %s", tmx_strerr());
+    return map;
+}
+
+/**
+ * Parse a .tmx file, without registering the map with raylib-tmx.
+ *
+ * This doesn't touch the state of raylib-tmx, so it may run on a worker thread.
+ *
+ * @internal
+ */
+tmx_map *ParseTMX(const char *fileName, tmx_resource_manager **resourceManager) {
+    *resourceManager = NULL;
+    if (raylibTMXFileDataCallback == NULL) {
+        tmx_map* map = tmx_load(fileName);
+        if (!map) TraceLog(LOG_ERROR, "TMX: Failed to load TMX file %s", fileName);
+        return map;
+    }
+
+    int dataSize = 0;
+    unsigned char *data = LoadTMXFileData(fileName, &dataSize);
+    if (data == NULL) {
+        TraceLog(LOG_ERROR, "TMX: Failed to read TMX file %s", fileName);
+        return NULL;
+    }
+    char directory[RAYLIB_TMX_MAX_PATH];
+    GetTMXDirectoryPath(directory, fileName);
+    tmx_map *map = ParseTMXFromMemory(data, dataSize, directory, resourceManager);
+    MemFree(data);
+    return map;
+}
+
+// Defined along with the collision queries
+void LoadTMXCollisionIndex(tmx_map *map, RaylibTMXState *state);
+
+/**
+ * Register a freshly parsed map with raylib-tmx.
+ *
+ * @internal
+ */
+tmx_map *FinishTMXLoad(tmx_map *map, tmx_resource_manager *resourceManager) {
+    if (!map) {
+        if (resourceManager != NULL) tmx_free_resource_manager(resourceManager);
+        return NULL;
+    }
+    TraceLog(LOG_INFO, "TMX: Loaded %ix%i map", map->width, map->height);
+    RaylibTMXState *state = LoadTMXTables(map);
+    state->resourceManager = resourceManager;
+    // Cooked maps come with their collisions and solid masks baked, only the index is left to build.
+    if (state->solidMasks != NULL) LoadTMXCollisionIndex(map, state);
+    else UpdateTMXCollisionIndex(map);
+    return map;
+}
+
+/**
+ * Loads given .tmx Tiled file.
+ *
+ * When a file data callback is set, the map is read through it, see LoadTMXFromMemory().
+ *
+ * @param fileName The .tmx file to load.
+ *
+ * @return A TMX Tiled map object pointer.
+ *
+ * @see UnloadTMX()
+ * @see SetTMXFileDataCallback()
+ * @see LoadTMXAsync()
+ */
+tmx_map* LoadTMX(const char* fileName) {
+    InitTMXCallbacks();
+    tmx_resource_manager *resourceManager;
+    tmx_map *map = ParseTMX(fileName, &resourceManager);
+    return FinishTMXLoad(map, resourceManager);
+}
+
+/**
+ * Loads a Tiled .tmx map from memory.
+ *
+ * The external tilesets and images of the map are read through the file data callback, or from the
+ * disk when there isn't one, relative to the given base path. Images are decoded with
+ * LoadImageFromMemory().
+ *
+ * @param data The contents of the .tmx file.
+ * @param dataSize The size of the data, in bytes.
+ * @param basePath The directory the files referenced by the map are relative to.
+ *
+ * @return A TMX Tiled map object pointer, or NULL on failure.
+ *
+ * @see UnloadTMX()
+ * @see SetTMXFileDataCallback()
+ */
+tmx_map* LoadTMXFromMemory(const unsigned char *data, int dataSize, const char *basePath) {
+    InitTMXCallbacks();
+    tmx_resource_manager *resourceManager;
+    tmx_map *map = ParseTMXFromMemory(data, dataSize, basePath, &resourceManager);
+    return FinishTMXLoad(map, resourceManager);
+}
+
+/**
+ * Upload the decoded images of the given layers, and of their groups.
+ *
+ * @internal
+ */
+void UploadTMXLayerImages(tmx_layer *layer) {
+    for (; layer != NULL; layer = layer->next) {
+        if (layer->type == L_IMAGE && layer->content.image) {
+            UploadTMXImage(layer->content.image->resource_image);
+        }
+        else if (layer->type == L_GROUP) {
+            UploadTMXLayerImages(layer->content.group_head);
+        }
+    }
+}
+
+/**
+ * Upload the decoded images of a map parsed on a worker thread.
+ *
+ * @internal
+ */
+void UploadTMXImages(tmx_map *map) {
+    for (tmx_tileset_list *list = map->ts_head; list != NULL; list = list->next) {
+        tmx_tileset *tileset = list->tileset;
+        if (tileset->image) UploadTMXImage(tileset->image->resource_image);
+        for (unsigned int i = 0; tileset->tiles != NULL && i < tileset->tilecount; i++) {
+            if (tileset->tiles[i].image) UploadTMXImage(tileset->tiles[i].image->resource_image);
+        }
+    }
+    UploadTMXLayerImages(map->ly_head);
+}
+
+/**
+ * A map being loaded on a worker thread.
+ *
+ * @see LoadTMXAsync()
+ */
+struct RaylibTMXLoad {
+    char fileName[RAYLIB_TMX_MAX_PATH];
+    tmx_map *map;
+    tmx_resource_manager *resourceManager;
+#if !defined(RAYLIB_TMX_NO_THREADS)
+#if defined(_WIN32)
+    void *thread;
+#else
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    bool done;
+#endif
+#endif
+};
+
+/**
+ * Parse the map of an asynchronous load, decoding its images without uploading them.
+ *
+ * @internal
+ */
+void RunTMXLoad(RaylibTMXLoad *load) {
+    raylibTMXDecodeOnly = true;
+    load->map = ParseTMX(load->fileName, &load->resourceManager);
+    raylibTMXDecodeOnly = false;
+}
+
+#if !defined(RAYLIB_TMX_NO_THREADS)
+#if defined(_WIN32)
+unsigned int __stdcall RunTMXLoadThread(void *load) {
+    RunTMXLoad((RaylibTMXLoad *)load);
+    return 0;
+}
+#else
+void *RunTMXLoadThread(void *ptr) {
+    RaylibTMXLoad *load = (RaylibTMXLoad *)ptr;
+    RunTMXLoad(load);
+    pthread_mutex_lock(&load->mutex);
+    load->done = true;
+    pthread_mutex_unlock(&load->mutex);
+    return NULL;
+}
+#endif
+#endif
+
+/**
+ * Start loading the given .tmx file on a worker thread.
+ *
+ * The XML is parsed, and the images decoded, on the worker thread. Call PollTMXLoad() once per frame
+ * until it returns true, which uploads the textures from the calling thread, as OpenGL requires. The
+ * file data callback, when set, is called from the worker thread.
+ *
+ * When built with RAYLIB_TMX_NO_THREADS, the map is parsed right away, and only the uploads are left
+ * to PollTMXLoad().
+ *
+ * @param fileName The .tmx file to load.
+ *
+ * @return The handle of the load, to pass to PollTMXLoad(), or NULL on failure.
+ *
+ * @see PollTMXLoad()
+ * @see CancelTMXLoad()
+ */
+RaylibTMXLoad *LoadTMXAsync(const char *fileName) {
+    if (fileName == NULL) return NULL;
+    InitTMXCallbacks();
+    RaylibTMXLoad *load = (RaylibTMXLoad *)MemAlloc(sizeof(RaylibTMXLoad));
+    snprintf(load->fileName, RAYLIB_TMX_MAX_PATH, "%s", fileName);
+#if defined(RAYLIB_TMX_NO_THREADS)
+    RunTMXLoad(load);
+#elif defined(_WIN32)
+    load->thread = (void *)_beginthreadex(NULL, 0, RunTMXLoadThread, load, 0, NULL);
+    if (load->thread == NULL) {
+        TraceLog(LOG_ERROR, "TMX: Failed to start loading %s", fileName);
+        MemFree(load);
+        return NULL;
+    }
+#else
+    pthread_mutex_init(&load->mutex, NULL);
+    if (pthread_create(&load->thread, NULL, RunTMXLoadThread, load) != 0) {
+        TraceLog(LOG_ERROR, "TMX: Failed to start loading %s", fileName);
+        pthread_mutex_destroy(&load->mutex);
+        MemFree(load);
+        return NULL;
+    }
+#endif
+    return load;
+}
+
+/**
+ * Check whether the worker thread of a load is done, and join it if so.
+ *
+ * @param wait Whether to block until the worker thread is done.
+ *
+ * @internal
+ */
+bool JoinTMXLoad(RaylibTMXLoad *load, bool wait) {
+#if defined(RAYLIB_TMX_NO_THREADS)
+    (void)load;
+    (void)wait;
+#elif defined(_WIN32)
+    if (WaitForSingleObject(load->thread, wait ? 0xFFFFFFFF : 0) != 0) return false;
+    CloseHandle(load->thread);
+#else
+    if (!wait) {
+        pthread_mutex_lock(&load->mutex);
+        bool done = load->done;
+        pthread_mutex_unlock(&load->mutex);
+        if (!done) return false;
+    }
+    pthread_join(load->thread, NULL);
+    pthread_mutex_destroy(&load->mutex);
+#endif
+    return true;
+}
+
+/**
+ * Check on a map started with LoadTMXAsync(), and finish loading it once it's parsed.
+ *
+ * Must be called from the thread that owns the OpenGL context. The call returning true uploads the
+ * textures of the map, and frees the handle.
+ *
+ * @param load The handle returned by LoadTMXAsync().
+ * @param map Where to store the loaded map, set to NULL if it failed to load.
+ *
+ * @return True when the load is over, false while the map is still being parsed.
+ *
+ * @see UnloadTMX()
+ */
+bool PollTMXLoad(RaylibTMXLoad *load, tmx_map **map) {
+    if (map != NULL) *map = NULL;
+    if (load == NULL) return true;
+    if (!JoinTMXLoad(load, false)) return false;
+
+    if (load->map) UploadTMXImages(load->map);
+    tmx_map *loaded = FinishTMXLoad(load->map, load->resourceManager);
+    MemFree(load);
+    if (map != NULL) {
+        *map = loaded;
+    }
+    else {
+        UnloadTMX(loaded);
+    }
+    return true;
+}
+
+/**
+ * Stop loading a map started with LoadTMXAsync(), waiting for its worker thread and freeing what it loaded.
+ *
+ * @param load The handle returned by LoadTMXAsync().
+ */
+void CancelTMXLoad(RaylibTMXLoad *load) {
+    if (load == NULL) return;
+    JoinTMXLoad(load, true);
+    if (load->map) tmx_map_free(load->map);
+    if (load->resourceManager != NULL) tmx_free_resource_manager(load->resourceManager);
+    MemFree(load);
+}
+
+/**
+ * Work run on several threads by RunTMXWorkers().
+ *
+ * @internal
+ */
+typedef void (*RaylibTMXWorkFunction)(void *work);
+
+#if !defined(RAYLIB_TMX_NO_THREADS)
+/**
+ * The threads RunTMXWorkers() hands work to, started the first time they're needed and kept until
+ * the last map is unloaded.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXWorkerPool {
+    RaylibTMXWorkFunction function;     // Work of the current job
+    void *work;
+    unsigned int job;                   // Incremented for each job, so that the threads notice new ones
+    unsigned int seenJobs[RAYLIB_TMX_MAX_WORKERS];  // Last job each thread has seen
+    int threadCount;                    // Threads started
+    int jobThreads;                     // Threads taking part in the current job
+    int pending;                        // Threads of the current job that haven't finished it
+    bool busy;                          // Whether a job is running, other callers then work alone
+    bool stopping;
+#if defined(_WIN32)
+    void *threads[RAYLIB_TMX_MAX_WORKERS];
+#else
+    pthread_t threads[RAYLIB_TMX_MAX_WORKERS];
+#endif
+} RaylibTMXWorkerPool;
+
+static RaylibTMXWorkerPool raylibTMXWorkers = {0};
+
+#if defined(_WIN32)
+__declspec(dllimport) int __stdcall SleepConditionVariableSRW(void **condition, void **lock, unsigned long milliseconds, unsigned long flags);
+__declspec(dllimport) void __stdcall WakeAllConditionVariable(void **condition);
+static void *raylibTMXWorkerLock = NULL;
+static void *raylibTMXWorkerStart = NULL;
+static void *raylibTMXWorkerDone = NULL;
+#define LockTMXWorkers() AcquireSRWLockExclusive(&raylibTMXWorkerLock)
+#define UnlockTMXWorkers() ReleaseSRWLockExclusive(&raylibTMXWorkerLock)
+#define WaitTMXWorkers(condition) SleepConditionVariableSRW(&(condition), &raylibTMXWorkerLock, 0xFFFFFFFF, 0)
+#define WakeTMXWorkers(condition) WakeAllConditionVariable(&(condition))
+#else
+static pthread_mutex_t raylibTMXWorkerLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t raylibTMXWorkerStart = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t raylibTMXWorkerDone = PTHREAD_COND_INITIALIZER;
+#define LockTMXWorkers() pthread_mutex_lock(&raylibTMXWorkerLock)
+#define UnlockTMXWorkers() pthread_mutex_unlock(&raylibTMXWorkerLock)
+#define WaitTMXWorkers(condition) pthread_cond_wait(&(condition), &raylibTMXWorkerLock)
+#define WakeTMXWorkers(condition) pthread_cond_broadcast(&(condition))
+#endif
+
+/**
+ * Wait for the jobs of RunTMXWorkers() on a thread of the pool, until the pool stops.
+ *
+ * @internal
+ */
+void RunTMXPoolWorker(int index) {
+    RaylibTMXWorkerPool *pool = &raylibTMXWorkers;
+    LockTMXWorkers();
+    unsigned int seen = pool->seenJobs[index];
+    for (;;) {
+        while (pool->job == seen && !pool->stopping) WaitTMXWorkers(raylibTMXWorkerStart);
+        if (pool->stopping) break;
+        seen = pool->job;
+        if (index >= pool->jobThreads) continue;
+
+        RaylibTMXWorkFunction function = pool->function;
+        void *work = pool->work;
+        UnlockTMXWorkers();
+        function(work);
+        LockTMXWorkers();
+        if (--pool->pending == 0) WakeTMXWorkers(raylibTMXWorkerDone);
+    }
+    UnlockTMXWorkers();
+}
+
+#if defined(_WIN32)
+unsigned int __stdcall RunTMXWorkerThread(void *index) {
+    RunTMXPoolWorker((int)(intptr_t)index);
+    return 0;
+}
+#else
+void *RunTMXWorkerThread(void *index) {
+    RunTMXPoolWorker((int)(intptr_t)index);
+    return NULL;
+}
+#endif
+#endif
+
+/**
+ * Run a function on the given amount of threads, including the calling one, and wait for all of them.
+ *
+ * The other threads come from a pool that grows to the most threads asked for, and is reused by the
+ * following calls. The function is expected to take shared items until none are left, so the calling
+ * thread also picks up the items of the threads that failed to start, or that are busy with the job
+ * of another caller.
+ *
+ * @internal
+ */
+void RunTMXWorkers(RaylibTMXWorkFunction function, void *work, int workers) {
+    if (workers > RAYLIB_TMX_MAX_WORKERS) workers = RAYLIB_TMX_MAX_WORKERS;
+#if !defined(RAYLIB_TMX_NO_THREADS)
+    RaylibTMXWorkerPool *pool = &raylibTMXWorkers;
+    LockTMXWorkers();
+    if (workers <= 1 || pool->busy || pool->stopping) {
+        UnlockTMXWorkers();
+        function(work);
+        return;
+    }
+    pool->busy = true;
+    while (pool->threadCount < workers - 1) {
+        int index = pool->threadCount;
+        pool->seenJobs[index] = pool->job;
+#if defined(_WIN32)
+        pool->threads[index] = (void *)_beginthreadex(NULL, 0, RunTMXWorkerThread, (void *)(intptr_t)index, 0, NULL);
+        if (pool->threads[index] == NULL) break;
+#else
+        if (pthread_create(&pool->threads[index], NULL, RunTMXWorkerThread, (void *)(intptr_t)index) != 0) break;
+#endif
+        pool->threadCount++;
+    }
+    pool->function = function;
+    pool->work = work;
+    pool->jobThreads = (pool->threadCount < workers - 1) ? pool->threadCount : workers - 1;
+    pool->pending = pool->jobThreads;
+    pool->job++;
+    WakeTMXWorkers(raylibTMXWorkerStart);
+    UnlockTMXWorkers();
+#endif
+
+    function(work);
+
+#if !defined(RAYLIB_TMX_NO_THREADS)
+    LockTMXWorkers();
+    while (pool->pending > 0) WaitTMXWorkers(raylibTMXWorkerDone);
+    pool->busy = false;
+    UnlockTMXWorkers();
+#endif
+}
+
+/**
+ * Stop the threads of the pool used by RunTMXWorkers(), which starts them again when next needed.
+ *
+ * @internal
+ */
+void StopTMXWorkers(void) {
+#if !defined(RAYLIB_TMX_NO_THREADS)
+    RaylibTMXWorkerPool *pool = &raylibTMXWorkers;
+    LockTMXWorkers();
+    if (pool->busy || pool->threadCount == 0) {
+        UnlockTMXWorkers();
+        return;
+    }
+    pool->stopping = true;
+    WakeTMXWorkers(raylibTMXWorkerStart);
+    UnlockTMXWorkers();
+
+    for (int i = 0; i < pool->threadCount; i++) {
+#if defined(_WIN32)
+        WaitForSingleObject(pool->threads[i], 0xFFFFFFFF);
+        CloseHandle(pool->threads[i]);
+#else
+        pthread_join(pool->threads[i], NULL);
+#endif
+    }
+
+    LockTMXWorkers();
+    pool->threadCount = 0;
+    pool->stopping = false;
+    UnlockTMXWorkers();
+#endif
+}
+
+/**
+ * A growable buffer the cooked format is written into.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXWriter {
+    unsigned char *data;
+    unsigned int size;
+    unsigned int capacity;
+    tmx_template **templates;           // Templates of the objects, written before the layers
+    unsigned int templateCount;
+} RaylibTMXWriter;
+
+/**
+ * Reads the cooked format, allocating the structures of the map as it goes.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXReader {
+    unsigned char *data;
+    size_t size;
+    size_t at;
+    bool failed;                        // Set when reading past the end, or when the data is invalid
+    void **allocations;                 // Chain of every structure allocated for the map
+    const char *directory;
+    tmx_template **templates;
+    uint32_t templateCount;
+    RaylibTMXCookedProperties *properties;  // Custom properties read so far, in the order they were read
+    int propertyCount, propertyCapacity;
+} RaylibTMXReader;
+
+// Defined along with the collisions they hold
+void WriteTMXCookedCollisions(RaylibTMXWriter *writer, tmx_map *map);
+void ReadTMXCookedCollisions(RaylibTMXReader *reader, tmx_map *map, RaylibTMXState *state);
+
+/**
+ * Append raw bytes to a cooked map.
+ *
+ * @internal
+ */
+void WriteTMXCookedBytes(RaylibTMXWriter *writer, const void *bytes, unsigned int size) {
+    if (writer->size + size > writer->capacity) {
+        while (writer->size + size > writer->capacity) writer->capacity = (writer->capacity == 0) ? 4096 : writer->capacity * 2;
+        writer->data = (unsigned char *)MemRealloc(writer->data, writer->capacity);
+    }
+    if (bytes != NULL) {
+        memcpy(writer->data + writer->size, bytes, size);
+    }
+    else {
+        memset(writer->data + writer->size, 0, size);
+    }
+    writer->size += size;
+}
+
+/**
+ * Append an unsigned integer to a cooked map, in little-endian order.
+ *
+ * @internal
+ */
+void WriteTMXCookedU32(RaylibTMXWriter *writer, uint32_t value) {
+    unsigned char bytes[4] = {(unsigned char)value, (unsigned char)(value >> 8), (unsigned char)(value >> 16), (unsigned char)(value >> 24)};
+    WriteTMXCookedBytes(writer, bytes, 4);
+}
+
+/**
+ * Append a signed integer to a cooked map.
+ *
+ * @internal
+ */
+void WriteTMXCookedI32(RaylibTMXWriter *writer, int value) {
+    WriteTMXCookedU32(writer, (uint32_t)value);
+}
+
+/**
+ * Append a float to a cooked map, as the little-endian bits of its IEEE 754 representation.
+ *
+ * @internal
+ */
+void WriteTMXCookedF32(RaylibTMXWriter *writer, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteTMXCookedU32(writer, bits);
+}
+
+/**
+ * Append a double to a cooked map, as the little-endian bits of its IEEE 754 representation.
+ *
+ * @internal
+ */
+void WriteTMXCookedF64(RaylibTMXWriter *writer, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteTMXCookedU32(writer, (uint32_t)bits);
+    WriteTMXCookedU32(writer, (uint32_t)(bits >> 32));
+}
+
+/**
+ * Append a string to a cooked map: its length, its characters and a NUL, padded to four bytes.
+ *
+ * NULL strings are written with a length of 0xFFFFFFFF.
+ *
+ * @internal
+ */
+void WriteTMXCookedString(RaylibTMXWriter *writer, const char *text) {
+    if (text == NULL) {
+        WriteTMXCookedU32(writer, 0xFFFFFFFF);
+        return;
+    }
+    unsigned int length = (unsigned int)strlen(text);
+    WriteTMXCookedU32(writer, length);
+    WriteTMXCookedBytes(writer, text, length + 1);
+    WriteTMXCookedBytes(writer, NULL, (4 - ((length + 1) % 4)) % 4);
+}
+
+/**
+ * Express a path relative to the given directory, when both are relative to the working directory.
+ *
+ * @internal
+ */
+void GetTMXRelativePath(char *output, const char *path, const char *directory) {
+    bool absolute = path[0] == '/' || path[0] == '\\' || (path[0] != '\0' && path[1] == ':');
+    if (absolute || directory[0] == '/' || directory[0] == '\\' || (directory[0] != '\0' && directory[1] == ':') || strcmp(directory, ".") == 0) {
+        snprintf(output, RAYLIB_TMX_MAX_PATH, "%s", path);
+        return;
+    }
+
+    // Skip the leading directories both have in common, then climb out of the rest of the directory.
+    size_t common = 0;
+    for (size_t i = 0; directory[i] != '\0' && directory[i] == path[i]; i++) {
+        if (directory[i + 1] == '\0' && (path[i + 1] == '/' || path[i + 1] == '\\')) common = i + 2;
+        else if (directory[i] == '/' || directory[i] == '\\') common = i + 1;
+    }
+    size_t length = 0;
+    size_t rest = (common > strlen(directory)) ? strlen(directory) : common;
+    for (size_t i = rest; directory[i] != '\0'; i++) {
+        bool separator = directory[i] == '/' || directory[i] == '\\';
+        bool segment = !separator && (i == rest || directory[i - 1] == '/' || directory[i - 1] == '\\');
+        if (segment && length + 3 < RAYLIB_TMX_MAX_PATH) {
+            memcpy(output + length, "../", 3);
+            length += 3;
+        }
+    }
+    snprintf(output + length, RAYLIB_TMX_MAX_PATH - length, "%s", path + common);
+}
+
+/**
+ * Remove the "." segments of a path, and the ".." segments that follow a directory, in place.
+ *
+ * @internal
+ */
+void NormalizeTMXPath(char *path) {
+    char *start = (path[0] == '/' || path[0] == '\\') ? path + 1 : path;
+    char *read = start;
+    char *write = start;
+    while (*read != '\0') {
+        char *end = read;
+        while (*end != '\0' && *end != '/' && *end != '\\') end++;
+        size_t length = (size_t)(end - read);
+        char *next = (*end != '\0') ? end + 1 : end;
+
+        // Find the last segment kept, which ".." removes unless it's a ".." itself.
+        char *previous = write;
+        while (previous > start && previous[-1] != '/') previous--;
+        bool parent = length == 2 && read[0] == '.' && read[1] == '.';
+        if (length == 0 || (length == 1 && read[0] == '.')) {
+            // Nothing to keep.
+        }
+        else if (parent && write > start && !(write - previous == 2 && previous[0] == '.' && previous[1] == '.')) {
+            write = (previous > start) ? previous - 1 : start;
+        }
+        else {
+            if (write > start) *write++ = '/';
+            memmove(write, read, length);
+            write += length;
+        }
+        read = next;
+    }
+    *write = '\0';
+}
+
+/**
+ * Count a custom property, for the amount written ahead of the properties of a cooked map.
+ *
+ * @internal
+ */
+void CountTMXCookedProperty(tmx_property *property, void *userdata) {
+    (void)property;
+    (*(unsigned int *)userdata)++;
+}
+
+// Class properties hold properties of their own
+void WriteTMXCookedProperties(RaylibTMXWriter *writer, tmx_properties *properties);
+
+/**
+ * Append a custom property to a cooked map, with the members of class properties.
+ *
+ * @internal
+ */
+void WriteTMXCookedProperty(tmx_property *property, void *userdata) {
+    RaylibTMXWriter *writer = (RaylibTMXWriter *)userdata;
+    WriteTMXCookedString(writer, property->name);
+    WriteTMXCookedString(writer, property->propertytype);
+    WriteTMXCookedI32(writer, (int)property->type);
+    switch (property->type) {
+        case PT_INT:
+        case PT_COLOR:
+        case PT_OBJECT:
+            WriteTMXCookedI32(writer, property->value.integer);
+            break;
+        case PT_BOOL:
+            WriteTMXCookedI32(writer, property->value.boolean);
+            break;
+        case PT_FLOAT:
+            WriteTMXCookedF32(writer, property->value.decimal);
+            break;
+        case PT_STRING:
+        case PT_FILE:
+            WriteTMXCookedString(writer, property->value.string);
+            break;
+        case PT_CUSTOM:
+            WriteTMXCookedProperties(writer, property->value.properties);
+            break;
+        default: break;
+    }
+}
+
+/**
+ * Append the custom properties of a part of the map to a cooked map.
+ *
+ * @internal
+ */
+void WriteTMXCookedProperties(RaylibTMXWriter *writer, tmx_properties *properties) {
+    unsigned int count = 0;
+    if (properties != NULL) tmx_property_foreach(properties, CountTMXCookedProperty, &count);
+    WriteTMXCookedU32(writer, count);
+    if (count > 0) tmx_property_foreach(properties, WriteTMXCookedProperty, writer);
+}
+
+/**
+ * Find the index of an object template in the templates of a cooked map.
+ *
+ * @return The index of the template, or 0xFFFFFFFF when it's not one of them.
+ *
+ * @internal
+ */
+uint32_t GetTMXCookedTemplate(RaylibTMXWriter *writer, tmx_template *templateRef) {
+    for (unsigned int i = 0; templateRef != NULL && i < writer->templateCount; i++) {
+        if (writer->templates[i] == templateRef) return i;
+    }
+    return 0xFFFFFFFF;
+}
+
+/**
+ * Gather the templates of the objects of the given layers, and of the layers in their groups.
+ *
+ * @internal
+ */
+void GatherTMXCookedTemplates(RaylibTMXWriter *writer, tmx_layer *layer) {
+    for (; layer != NULL; layer = layer->next) {
+        if (layer->type == L_GROUP) GatherTMXCookedTemplates(writer, layer->content.group_head);
+        if (layer->type != L_OBJGR) continue;
+        for (tmx_object *object = layer->content.objgr->head; object != NULL; object = object->next) {
+            if (object->template_ref == NULL || GetTMXCookedTemplate(writer, object->template_ref) != 0xFFFFFFFF) continue;
+            writer->templates = (tmx_template **)MemRealloc(writer->templates, (writer->templateCount + 1) * sizeof(tmx_template *));
+            writer->templates[writer->templateCount++] = object->template_ref;
+        }
+    }
+}
+
+/**
+ * Append an image to a cooked map, with the path it was loaded from relative to the cooked file.
+ *
+ * @internal
+ */
+void WriteTMXCookedImage(RaylibTMXWriter *writer, tmx_image *image, const char *directory) {
+    WriteTMXCookedU32(writer, image != NULL);
+    if (image == NULL) return;
+    RaylibTMXTexture *texture = (RaylibTMXTexture *)image->resource_image;
+    char path[RAYLIB_TMX_MAX_PATH];
+    GetTMXRelativePath(path, (texture != NULL && texture->path != NULL) ? texture->path : image->source, directory);
+    WriteTMXCookedString(writer, image->source);
+    WriteTMXCookedString(writer, path);
+    WriteTMXCookedU32(writer, image->trans);
+    WriteTMXCookedI32(writer, image->uses_trans);
+    WriteTMXCookedU32(writer, (uint32_t)image->width);
+    WriteTMXCookedU32(writer, (uint32_t)image->height);
+}
+
+/**
+ * Append a list of objects to a cooked map, with the index of their template and their properties.
+ *
+ * @internal
+ */
+void WriteTMXCookedObjects(RaylibTMXWriter *writer, tmx_object *head) {
+    unsigned int count = 0;
+    for (tmx_object *object = head; object != NULL; object = object->next) count++;
+    WriteTMXCookedU32(writer, count);
+    for (tmx_object *object = head; object != NULL; object = object->next) {
+        WriteTMXCookedU32(writer, object->id);
+        WriteTMXCookedU32(writer, GetTMXCookedTemplate(writer, object->template_ref));
+        WriteTMXCookedProperties(writer, object->properties);
+        WriteTMXCookedI32(writer, (int)object->obj_type);
+        WriteTMXCookedF64(writer, object->x);
+        WriteTMXCookedF64(writer, object->y);
+        WriteTMXCookedF64(writer, object->width);
+        WriteTMXCookedF64(writer, object->height);
+        WriteTMXCookedI32(writer, object->visible);
+        WriteTMXCookedF64(writer, object->rotation);
+        WriteTMXCookedString(writer, object->name);
+        WriteTMXCookedString(writer, object->type);
+        switch (object->obj_type) {
+            case OT_TILE:
+                WriteTMXCookedU32(writer, (uint32_t)object->content.gid);
+                break;
+            case OT_POLYGON:
+            case OT_POLYLINE:
+                WriteTMXCookedU32(writer, (uint32_t)object->content.shape->points_len);
+                for (int i = 0; i < object->content.shape->points_len; i++) {
+                    WriteTMXCookedF64(writer, object->content.shape->points[i][0]);
+                    WriteTMXCookedF64(writer, object->content.shape->points[i][1]);
+                }
+                break;
+            case OT_TEXT: {
+                tmx_text *text = object->content.text;
+                WriteTMXCookedString(writer, text->fontfamily);
+                WriteTMXCookedI32(writer, text->pixelsize);
+                WriteTMXCookedU32(writer, text->color);
+                WriteTMXCookedI32(writer, text->wrap);
+                WriteTMXCookedI32(writer, text->bold);
+                WriteTMXCookedI32(writer, text->italic);
+                WriteTMXCookedI32(writer, text->underline);
+                WriteTMXCookedI32(writer, text->strikeout);
+                WriteTMXCookedI32(writer, text->kerning);
+                WriteTMXCookedI32(writer, (int)text->halign);
+                WriteTMXCookedI32(writer, (int)text->valign);
+                WriteTMXCookedString(writer, text->text);
+            } break;
+            default: break;
+        }
+    }
+}
+
+/**
+ * Append a list of layers, and the layers of their groups, to a cooked map.
+ *
+ * @internal
+ */
+void WriteTMXCookedLayers(RaylibTMXWriter *writer, tmx_map *map, tmx_layer *head, const char *directory) {
+    unsigned int count = 0;
+    for (tmx_layer *layer = head; layer != NULL; layer = layer->next) count++;
+    WriteTMXCookedU32(writer, count);
+    for (tmx_layer *layer = head; layer != NULL; layer = layer->next) {
+        WriteTMXCookedI32(writer, layer->id);
+        WriteTMXCookedI32(writer, (int)layer->type);
+        WriteTMXCookedString(writer, layer->name);
+        WriteTMXCookedF64(writer, layer->opacity);
+        WriteTMXCookedI32(writer, layer->visible);
+        WriteTMXCookedI32(writer, layer->offsetx);
+        WriteTMXCookedI32(writer, layer->offsety);
+        WriteTMXCookedString(writer, layer->class_type);
+        WriteTMXCookedF64(writer, layer->parallaxx);
+        WriteTMXCookedF64(writer, layer->parallaxy);
+        WriteTMXCookedU32(writer, layer->tintcolor);
+        WriteTMXCookedProperties(writer, layer->properties);
+        switch (layer->type) {
+            case L_LAYER:
+                // The GIDs are loaded in place, so they're written as is.
+                for (unsigned int i = 0; i < map->width * map->height; i++) WriteTMXCookedU32(writer, layer->content.gids[i]);
+                break;
+            case L_OBJGR:
+                WriteTMXCookedU32(writer, layer->content.objgr->color);
+                WriteTMXCookedI32(writer, (int)layer->content.objgr->draworder);
+                WriteTMXCookedObjects(writer, layer->content.objgr->head);
+                break;
+            case L_IMAGE:
+                WriteTMXCookedImage(writer, layer->content.image, directory);
+                break;
+            case L_GROUP:
+                WriteTMXCookedLayers(writer, map, layer->content.group_head, directory);
+                break;
+            default: break;
+        }
+    }
+}
+
+/**
+ * Save a loaded map in the cooked binary format, to be loaded with LoadTMXCooked().
+ *
+ * The cooked format holds the map, its tilesets, tile collisions, animations, layers and objects,
+ * with their custom properties and object templates, so loading it skips parsing the XML. The
+ * collisions baked for the map and its solid cell masks are saved as well, so they aren't baked
+ * again either. Image paths are stored relative to the cooked file, which is versioned and
+ * little-endian.
+ *
+ * @param map The map to save.
+ * @param fileName Where to save the cooked map.
+ *
+ * @return True when the cooked map was saved.
+ *
+ * @see LoadTMXCooked()
+ */
+bool ExportTMX(tmx_map *map, const char *fileName) {
+    if (map == NULL || fileName == NULL) return false;
+    char directory[RAYLIB_TMX_MAX_PATH];
+    GetTMXDirectoryPath(directory, fileName);
+
+    RaylibTMXWriter writer = {0};
+    WriteTMXCookedBytes(&writer, RAYLIB_TMX_COOKED_MAGIC, 4);
+    WriteTMXCookedU32(&writer, RAYLIB_TMX_COOKED_VERSION);
+    WriteTMXCookedI32(&writer, (int)map->orient);
+    WriteTMXCookedU32(&writer, map->width);
+    WriteTMXCookedU32(&writer, map->height);
+    WriteTMXCookedU32(&writer, map->tile_width);
+    WriteTMXCookedU32(&writer, map->tile_height);
+    WriteTMXCookedI32(&writer, (int)map->stagger_index);
+    WriteTMXCookedI32(&writer, (int)map->stagger_axis);
+    WriteTMXCookedI32(&writer, map->hexsidelength);
+    WriteTMXCookedU32(&writer, map->backgroundcolor);
+    WriteTMXCookedI32(&writer, (int)map->renderorder);
+    WriteTMXCookedU32(&writer, map->tilecount);
+    WriteTMXCookedProperties(&writer, map->properties);
+
+    unsigned int tilesetCount = 0;
+    for (tmx_tileset_list *list = map->ts_head; list != NULL; list = list->next) tilesetCount++;
+    WriteTMXCookedU32(&writer, tilesetCount);
+    for (tmx_tileset_list *list = map->ts_head; list != NULL; list = list->next) {
+        tmx_tileset *tileset = list->tileset;
+        WriteTMXCookedU32(&writer, list->firstgid);
+        WriteTMXCookedI32(&writer, list->is_embedded);
+        WriteTMXCookedString(&writer, list->source);
+        WriteTMXCookedString(&writer, tileset->name);
+        WriteTMXCookedU32(&writer, tileset->tile_width);
+        WriteTMXCookedU32(&writer, tileset->tile_height);
+        WriteTMXCookedU32(&writer, tileset->spacing);
+        WriteTMXCookedU32(&writer, tileset->margin);
+        WriteTMXCookedI32(&writer, tileset->x_offset);
+        WriteTMXCookedI32(&writer, tileset->y_offset);
+        WriteTMXCookedI32(&writer, (int)tileset->objectalignment);
+        WriteTMXCookedImage(&writer, tileset->image, directory);
+        WriteTMXCookedU32(&writer, (tileset->tiles != NULL) ? tileset->tilecount : 0);
+        for (unsigned int i = 0; tileset->tiles != NULL && i < tileset->tilecount; i++) {
+            tmx_tile *tile = &tileset->tiles[i];
+            WriteTMXCookedU32(&writer, tile->id);
+            WriteTMXCookedU32(&writer, tile->ul_x);
+            WriteTMXCookedU32(&writer, tile->ul_y);
+            WriteTMXCookedU32(&writer, tile->width);
+            WriteTMXCookedU32(&writer, tile->height);
+            WriteTMXCookedString(&writer, tile->type);
+            WriteTMXCookedImage(&writer, tile->image, directory);
+            WriteTMXCookedU32(&writer, tile->animation_len);
+            for (unsigned int frame = 0; frame < tile->animation_len; frame++) {
+                WriteTMXCookedU32(&writer, tile->animation[frame].tile_id);
+                WriteTMXCookedU32(&writer, tile->animation[frame].duration);
+            }
+            WriteTMXCookedObjects(&writer, tile->collision);
+            WriteTMXCookedProperties(&writer, tile->properties);
+        }
+    }
+
+    // The templates are only kept for the tilesets they share with the map.
+    GatherTMXCookedTemplates(&writer, map->ly_head);
+    WriteTMXCookedU32(&writer, writer.templateCount);
+    for (unsigned int i = 0; i < writer.templateCount; i++) {
+        tmx_template *templateRef = writer.templates[i];
+        int tilesetIndex = -1, index = 0;
+        for (tmx_tileset_list *list = map->ts_head; list != NULL; list = list->next, index++) {
+            if (templateRef->tileset_ref != NULL && list->tileset == templateRef->tileset_ref->tileset) tilesetIndex = index;
+        }
+        WriteTMXCookedI32(&writer, templateRef->is_embedded);
+        WriteTMXCookedI32(&writer, tilesetIndex);
+        WriteTMXCookedU32(&writer, (templateRef->tileset_ref != NULL) ? templateRef->tileset_ref->firstgid : 0);
+        WriteTMXCookedObjects(&writer, templateRef->object);
+    }
+    WriteTMXCookedLayers(&writer, map, map->ly_head, directory);
+    WriteTMXCookedCollisions(&writer, map);
+
+    bool success = SaveFileData(fileName, writer.data, (int)writer.size);
+    MemFree(writer.data);
+    MemFree(writer.templates);
+    return success;
+}
+
+/**
+ * Allocate zeroed memory for a cooked map, freed along with it.
+ *
+ * @internal
+ */
+void *AllocTMXCooked(RaylibTMXReader *reader, size_t size) {
+    void **allocation = (void **)MemAlloc((unsigned int)(sizeof(void *) * 2 + size));
+    allocation[0] = reader->allocations;
+    reader->allocations = allocation;
+    return allocation + 2;
+}
+
+/**
+ * Move past the given amount of bytes of a cooked map.
+ *
+ * @return Where the bytes start, or NULL when there aren't enough of them.
+ *
+ * @internal
+ */
+unsigned char *ReadTMXCookedBytes(RaylibTMXReader *reader, size_t size) {
+    if (reader->failed || size > reader->size - reader->at) {
+        reader->failed = true;
+        return NULL;
+    }
+    unsigned char *bytes = reader->data + reader->at;
+    reader->at += size;
+    return bytes;
+}
+
+/**
+ * Read a little-endian unsigned integer from a cooked map.
+ *
+ * @internal
+ */
+uint32_t ReadTMXCookedU32(RaylibTMXReader *reader) {
+    unsigned char *bytes = ReadTMXCookedBytes(reader, 4);
+    if (bytes == NULL) return 0;
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+/**
+ * Read a signed integer from a cooked map.
+ *
+ * @internal
+ */
+int ReadTMXCookedI32(RaylibTMXReader *reader) {
+    return (int)ReadTMXCookedU32(reader);
+}
+
+/**
+ * Read a float from a cooked map.
+ *
+ * @internal
+ */
+float ReadTMXCookedF32(RaylibTMXReader *reader) {
+    uint32_t bits = ReadTMXCookedU32(reader);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * Read an array of 32-bit words from a cooked map in place, converting them to the byte order of
+ * the machine first when it isn't little-endian.
+ *
+ * @return Where the words start, which is four byte aligned, or NULL when there aren't enough of them.
+ *
+ * @internal
+ */
+uint32_t *ReadTMXCookedWords(RaylibTMXReader *reader, size_t count) {
+    if (count > (reader->size - reader->at) / 4) {
+        reader->failed = true;
+        return NULL;
+    }
+    uint32_t *words = (uint32_t *)ReadTMXCookedBytes(reader, count * 4);
+    if (words == NULL) return NULL;
+    const uint16_t endianness = 1;
+    if (*(const unsigned char *)&endianness == 0) {
+        for (size_t i = 0; i < count; i++) {
+            unsigned char *bytes = (unsigned char *)&words[i];
+            words[i] = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+        }
+    }
+    return words;
+}
+
+/**
+ * Read a double from a cooked map.
+ *
+ * @internal
+ */
+double ReadTMXCookedF64(RaylibTMXReader *reader) {
+    uint64_t bits = ReadTMXCookedU32(reader);
+    bits |= (uint64_t)ReadTMXCookedU32(reader) << 32;
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * Read a string from a cooked map, pointing into the cooked data rather than copying it.
+ *
+ * @internal
+ */
+char *ReadTMXCookedString(RaylibTMXReader *reader) {
+    uint32_t length = ReadTMXCookedU32(reader);
+    if (length == 0xFFFFFFFF) return NULL;
+    char *text = (char *)ReadTMXCookedBytes(reader, (size_t)length + 1);
+    if (text == NULL || text[length] != '\0') {
+        reader->failed = true;
+        return NULL;
+    }
+    ReadTMXCookedBytes(reader, (4 - ((length + 1) % 4)) % 4);
+    return text;
+}
+
+/**
+ * Read an image from a cooked map, and load its texture relative to the cooked file.
+ *
+ * @internal
+ */
+tmx_image *ReadTMXCookedImage(RaylibTMXReader *reader) {
+    if (!ReadTMXCookedU32(reader)) return NULL;
+    tmx_image *image = (tmx_image *)AllocTMXCooked(reader, sizeof(tmx_image));
+    image->source = ReadTMXCookedString(reader);
+    char *path = ReadTMXCookedString(reader);
+    image->trans = ReadTMXCookedU32(reader);
+    image->uses_trans = ReadTMXCookedI32(reader);
+    image->width = ReadTMXCookedU32(reader);
+    image->height = ReadTMXCookedU32(reader);
+    if (path != NULL && !reader->failed) {
+        // Resolved to the same path as when loading the .tmx file, so the texture cache is shared.
+        char resolved[RAYLIB_TMX_MAX_PATH];
+        JoinTMXPath(resolved, reader->directory, path);
+        NormalizeTMXPath(resolved);
+        raylibTMXBasePath = (raylibTMXFileDataCallback != NULL) ? "" : NULL;
+        image->resource_image = LoadTMXImage(resolved);
+        raylibTMXBasePath = NULL;
+    }
+    return image;
+}
+
+/**
+ * Check that a GID read from a cooked map refers to a tile of the map, failing the read otherwise.
+ *
+ * Every draw and collision looks the GIDs up in tmx_map.tiles, so a corrupted file must not get
+ * that far. The GIDs of templates refer to their own tilesets, so they're not checked.
+ *
+ * @internal
+ */
+void CheckTMXCookedGid(RaylibTMXReader *reader, tmx_map *map, uint32_t gid) {
+    if (map != NULL && (gid & TMX_FLIP_BITS_REMOVAL) >= map->tilecount) reader->failed = true;
+}
+
+/**
+ * Read the custom properties of a part of a cooked map, and of the class properties among them.
+ *
+ * They're kept aside, by their owner, as libtmx only looks properties up in its own hash tables.
+ *
+ * @internal
+ */
+void ReadTMXCookedProperties(RaylibTMXReader *reader, const void *owner, int depth) {
+    uint32_t count = ReadTMXCookedU32(reader);
+    if (count == 0 || reader->failed) return;
+    if (count > (reader->size - reader->at) / 16 || depth >= 64) {
+        reader->failed = true;
+        return;
+    }
+    tmx_property *properties = (tmx_property *)AllocTMXCooked(reader, count * sizeof(tmx_property));
+    if (reader->propertyCount == reader->propertyCapacity) {
+        reader->propertyCapacity = (reader->propertyCapacity == 0) ? 64 : reader->propertyCapacity * 2;
+        reader->properties = (RaylibTMXCookedProperties *)MemRealloc(reader->properties, (unsigned int)reader->propertyCapacity * sizeof(RaylibTMXCookedProperties));
+    }
+    reader->properties[reader->propertyCount++] = (RaylibTMXCookedProperties){owner, (int)count, properties};
+
+    for (uint32_t i = 0; i < count && !reader->failed; i++) {
+        tmx_property *property = &properties[i];
+        property->name = ReadTMXCookedString(reader);
+        property->propertytype = ReadTMXCookedString(reader);
+        property->type = (enum tmx_property_type)ReadTMXCookedI32(reader);
+        if (property->name == NULL) reader->failed = true;
+        switch (property->type) {
+            case PT_INT:
+            case PT_COLOR:
+            case PT_OBJECT:
+                property->value.integer = ReadTMXCookedI32(reader);
+                break;
+            case PT_BOOL:
+                property->value.boolean = ReadTMXCookedI32(reader);
+                break;
+            case PT_FLOAT:
+                property->value.decimal = ReadTMXCookedF32(reader);
+                break;
+            case PT_STRING:
+            case PT_FILE:
+                property->value.string = ReadTMXCookedString(reader);
+                break;
+            case PT_CUSTOM:
+                // The members are found with GetTMXPropertyMember().
+                ReadTMXCookedProperties(reader, property, depth + 1);
+                break;
+            default: break;
+        }
+    }
+}
+
+/**
+ * Read a list of objects from a cooked map, and their properties.
+ *
+ * @param map The map whose tiles the GIDs of the objects refer to, NULL for the objects of templates.
+ *
+ * @internal
+ */
+tmx_object *ReadTMXCookedObjects(RaylibTMXReader *reader, tmx_map *map) {
+    uint32_t count = ReadTMXCookedU32(reader);
+    tmx_object *head = NULL;
+    tmx_object **link = &head;
+    for (uint32_t i = 0; i < count && !reader->failed; i++) {
+        tmx_object *object = (tmx_object *)AllocTMXCooked(reader, sizeof(tmx_object));
+        object->id = ReadTMXCookedU32(reader);
+        uint32_t templateIndex = ReadTMXCookedU32(reader);
+        if (templateIndex != 0xFFFFFFFF && templateIndex >= reader->templateCount) reader->failed = true;
+        else if (templateIndex != 0xFFFFFFFF) object->template_ref = reader->templates[templateIndex];
+        ReadTMXCookedProperties(reader, object, 0);
+        object->obj_type = (enum tmx_obj_type)ReadTMXCookedI32(reader);
+        object->x = ReadTMXCookedF64(reader);
+        object->y = ReadTMXCookedF64(reader);
+        object->width = ReadTMXCookedF64(reader);
+        object->height = ReadTMXCookedF64(reader);
+        object->visible = ReadTMXCookedI32(reader);
+        object->rotation = ReadTMXCookedF64(reader);
+        object->name = ReadTMXCookedString(reader);
+        object->type = ReadTMXCookedString(reader);
+        switch (object->obj_type) {
+            case OT_TILE:
+                object->content.gid = (int)ReadTMXCookedU32(reader);
+                CheckTMXCookedGid(reader, map, (uint32_t)object->content.gid);
+                break;
+            case OT_POLYGON:
+            case OT_POLYLINE: {
+                uint32_t pointCount = ReadTMXCookedU32(reader);
+                if (pointCount > (reader->size - reader->at) / 16) {
+                    reader->failed = true;
+                    break;
+                }
+                tmx_shape *shape = (tmx_shape *)AllocTMXCooked(reader, sizeof(tmx_shape));
+                shape->points_len = (int)pointCount;
+                shape->points = (double **)AllocTMXCooked(reader, pointCount * (sizeof(double *) + 2 * sizeof(double)));
+                double *coordinates = (double *)(shape->points + pointCount);
+                for (uint32_t p = 0; p < pointCount; p++) {
+                    shape->points[p] = coordinates + p * 2;
+                    shape->points[p][0] = ReadTMXCookedF64(reader);
+                    shape->points[p][1] = ReadTMXCookedF64(reader);
+                }
+                object->content.shape = shape;
+            } break;
+            case OT_TEXT: {
+                tmx_text *text = (tmx_text *)AllocTMXCooked(reader, sizeof(tmx_text));
+                text->fontfamily = ReadTMXCookedString(reader);
+                text->pixelsize = ReadTMXCookedI32(reader);
+                text->color = ReadTMXCookedU32(reader);
+                text->wrap = ReadTMXCookedI32(reader);
+                text->bold = ReadTMXCookedI32(reader);
+                text->italic = ReadTMXCookedI32(reader);
+                text->underline = ReadTMXCookedI32(reader);
+                text->strikeout = ReadTMXCookedI32(reader);
+                text->kerning = ReadTMXCookedI32(reader);
+                text->halign = (enum tmx_horizontal_align)ReadTMXCookedI32(reader);
+                text->valign = (enum tmx_vertical_align)ReadTMXCookedI32(reader);
+                text->text = ReadTMXCookedString(reader);
+                object->content.text = text;
+            } break;
+            default: break;
+        }
+        *link = object;
+        link = &object->next;
+    }
+    return head;
+}
+
+/**
+ * Read a list of layers, and the layers of their groups, from a cooked map.
+ *
+ * @internal
+ */
+tmx_layer *ReadTMXCookedLayers(RaylibTMXReader *reader, tmx_map *map, int depth) {
+    uint32_t count = ReadTMXCookedU32(reader);
+    tmx_layer *head = NULL;
+    tmx_layer **link = &head;
+    for (uint32_t i = 0; i < count && !reader->failed; i++) {
+        tmx_layer *layer = (tmx_layer *)AllocTMXCooked(reader, sizeof(tmx_layer));
+        layer->id = ReadTMXCookedI32(reader);
+        layer->type = (enum tmx_layer_type)ReadTMXCookedI32(reader);
+        layer->name = ReadTMXCookedString(reader);
+        layer->opacity = ReadTMXCookedF64(reader);
+        layer->visible = ReadTMXCookedI32(reader);
+        layer->offsetx = ReadTMXCookedI32(reader);
+        layer->offsety = ReadTMXCookedI32(reader);
+        layer->class_type = ReadTMXCookedString(reader);
+        layer->parallaxx = ReadTMXCookedF64(reader);
+        layer->parallaxy = ReadTMXCookedF64(reader);
+        layer->tintcolor = ReadTMXCookedU32(reader);
+        ReadTMXCookedProperties(reader, layer, 0);
+        switch (layer->type) {
+            case L_LAYER: {
+                // Point to the GIDs in place, the data is four byte aligned.
+                size_t cells = (size_t)map->width * map->height;
+                uint32_t *gids = ReadTMXCookedWords(reader, cells);
+                if (gids == NULL) break;
+                for (size_t c = 0; c < cells; c++) CheckTMXCookedGid(reader, map, gids[c]);
+                layer->content.gids = gids;
+            } break;
+            case L_OBJGR: {
+                tmx_object_group *group = (tmx_object_group *)AllocTMXCooked(reader, sizeof(tmx_object_group));
+                group->color = ReadTMXCookedU32(reader);
+                group->draworder = (enum tmx_objgr_draworder)ReadTMXCookedI32(reader);
+                group->head = ReadTMXCookedObjects(reader, map);
+                layer->content.objgr = group;
+            } break;
+            case L_IMAGE:
+                layer->content.image = ReadTMXCookedImage(reader);
+                break;
+            case L_GROUP:
+                if (depth >= 64) {
+                    reader->failed = true;
+                    break;
+                }
+                layer->content.group_head = ReadTMXCookedLayers(reader, map, depth + 1);
+                break;
+            default: break;
+        }
+        *link = layer;
+        link = &layer->next;
+    }
+    return head;
+}
+
+/**
+ * Order the custom properties of a cooked map by their owner.
+ *
+ * @internal
+ */
+int CompareTMXCookedProperties(const void *a, const void *b) {
+    uintptr_t ownerA = (uintptr_t)((const RaylibTMXCookedProperties *)a)->owner;
+    uintptr_t ownerB = (uintptr_t)((const RaylibTMXCookedProperties *)b)->owner;
+    return (ownerA > ownerB) - (ownerA < ownerB);
+}
+
+/**
+ * Release the textures of the given layers.
+ *
+ * @internal
+ */
+void UnloadTMXCookedLayers(tmx_layer *layer) {
+    for (; layer != NULL; layer = layer->next) {
+        if (layer->type == L_IMAGE && layer->content.image) UnloadTMXImage(layer->content.image->resource_image);
+        if (layer->type == L_GROUP) UnloadTMXCookedLayers(layer->content.group_head);
+    }
+}
+
+/**
+ * Unload a map loaded with LoadTMXCooked(), its textures, structures and cooked data.
+ *
+ * @internal
+ */
+void UnloadTMXCooked(tmx_map *map, RaylibTMXCooked cooked) {
+    for (tmx_tileset_list *list = map->ts_head; list != NULL; list = list->next) {
+        if (list->tileset->image) UnloadTMXImage(list->tileset->image->resource_image);
+        for (unsigned int i = 0; list->tileset->tiles != NULL && i < list->tileset->tilecount; i++) {
+            if (list->tileset->tiles[i].image) UnloadTMXImage(list->tileset->tiles[i].image->resource_image);
+        }
+    }
+    UnloadTMXCookedLayers(map->ly_head);
+
+    MemFree(cooked.properties);
+    void **allocation = (void **)cooked.allocations;
+    while (allocation != NULL) {
+        void **next = (void **)allocation[0];
+        MemFree(allocation);
+        allocation = next;
+    }
+#if defined(RAYLIB_TMX_MMAP)
+    if (cooked.mapped) {
+        munmap(cooked.data, cooked.size);
+        return;
+    }
+#endif
+    MemFree(cooked.data);
+}
+
+/**
+ * Load a map saved with ExportTMX().
+ *
+ * The file is memory mapped when possible, and the GIDs of the tile layers, along with the strings,
+ * are used in place, so loading the map barely does more than allocating its structures and checking
+ * that every GID refers to a tile of the map. Without a memory mapping, or with a file data callback,
+ * the file is read in full instead.
+ *
+ * The collisions baked for the map, and its solid cell masks, are used in place as well rather than
+ * baked again. libtmx can't look up the custom properties of cooked maps, so they're found with
+ * GetTMXMapProperty() and the functions like it, which SetTMXSolidProperty() relies on too.
+ *
+ * @param fileName The cooked map to load.
+ *
+ * @return The loaded map, to unload with UnloadTMX(), or NULL on failure.
+ *
+ * @see ExportTMX()
+ */
+tmx_map* LoadTMXCooked(const char *fileName) {
+    if (fileName == NULL) return NULL;
+    RaylibTMXCooked cooked = {0};
+#if defined(RAYLIB_TMX_MMAP)
+    if (raylibTMXFileDataCallback == NULL) {
+        int file = open(fileName, O_RDONLY);
+        struct stat info;
+        if (file >= 0 && fstat(file, &info) == 0 && info.st_size > 0) {
+            // Mapped privately, so changing the GIDs of a cell only copies the pages it touches.
+            void *data = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+            if (data != MAP_FAILED) {
+                cooked.data = data;
+                cooked.size = (size_t)info.st_size;
+                cooked.mapped = true;
+            }
+        }
+        if (file >= 0) close(file);
+    }
+#endif
+    if (cooked.data == NULL) {
+        int dataSize = 0;
+        cooked.data = LoadTMXFileData(fileName, &dataSize);
+        cooked.size = (dataSize > 0) ? (size_t)dataSize : 0;
+    }
+    if (cooked.data == NULL) {
+        TraceLog(LOG_ERROR, "TMX: Failed to read cooked TMX file %s", fileName);
+        return NULL;
+    }
+
+    char directory[RAYLIB_TMX_MAX_PATH];
+    GetTMXDirectoryPath(directory, fileName);
+    RaylibTMXReader reader = {(unsigned char *)cooked.data, cooked.size, 0, false, NULL, directory, NULL, 0, NULL, 0, 0};
+    unsigned char *magic = ReadTMXCookedBytes(&reader, 4);
+    if (magic == NULL || memcmp(magic, RAYLIB_TMX_COOKED_MAGIC, 4) != 0 || ReadTMXCookedU32(&reader) != RAYLIB_TMX_COOKED_VERSION) {
+        TraceLog(LOG_ERROR, "TMX: %s is not a cooked TMX file of version %i", fileName, RAYLIB_TMX_COOKED_VERSION);
+        UnloadTMXCooked(&(tmx_map){0}, cooked);
+        return NULL;
+    }
+
+    tmx_map *map = (tmx_map *)AllocTMXCooked(&reader, sizeof(tmx_map));
+    map->orient = (enum tmx_map_orient)ReadTMXCookedI32(&reader);
+    map->width = ReadTMXCookedU32(&reader);
+    map->height = ReadTMXCookedU32(&reader);
+    map->tile_width = ReadTMXCookedU32(&reader);
+    map->tile_height = ReadTMXCookedU32(&reader);
+    map->stagger_index = (enum tmx_stagger_index)ReadTMXCookedI32(&reader);
+    map->stagger_axis = (enum tmx_stagger_axis)ReadTMXCookedI32(&reader);
+    map->hexsidelength = ReadTMXCookedI32(&reader);
+    map->backgroundcolor = ReadTMXCookedU32(&reader);
+    map->renderorder = (enum tmx_map_renderorder)ReadTMXCookedI32(&reader);
+    map->tilecount = ReadTMXCookedU32(&reader);
+    ReadTMXCookedProperties(&reader, map, 0);
+    if ((size_t)map->width * map->height > cooked.size || map->tilecount > cooked.size) reader.failed = true;
+    if (!reader.failed) map->tiles = (tmx_tile **)AllocTMXCooked(&reader, (size_t)map->tilecount * sizeof(tmx_tile *));
+
+    uint32_t tilesetCount = ReadTMXCookedU32(&reader);
+    tmx_tileset_list **link = &map->ts_head;
+    for (uint32_t t = 0; t < tilesetCount && !reader.failed; t++) {
+        tmx_tileset_list *list = (tmx_tileset_list *)AllocTMXCooked(&reader, sizeof(tmx_tileset_list));
+        tmx_tileset *tileset = (tmx_tileset *)AllocTMXCooked(&reader, sizeof(tmx_tileset));
+        list->tileset = tileset;
+        list->firstgid = ReadTMXCookedU32(&reader);
+        list->is_embedded = ReadTMXCookedI32(&reader);
+        list->source = ReadTMXCookedString(&reader);
+        tileset->name = ReadTMXCookedString(&reader);
+        tileset->tile_width = ReadTMXCookedU32(&reader);
+        tileset->tile_height = ReadTMXCookedU32(&reader);
+        tileset->spacing = ReadTMXCookedU32(&reader);
+        tileset->margin = ReadTMXCookedU32(&reader);
+        tileset->x_offset = ReadTMXCookedI32(&reader);
+        tileset->y_offset = ReadTMXCookedI32(&reader);
+        tileset->objectalignment = (enum tmx_obj_alignment)ReadTMXCookedI32(&reader);
+        tileset->image = ReadTMXCookedImage(&reader);
+        tileset->tilecount = ReadTMXCookedU32(&reader);
+        if (tileset->tilecount > cooked.size) reader.failed = true;
+        if (!reader.failed && tileset->tilecount > 0) tileset->tiles = (tmx_tile *)AllocTMXCooked(&reader, tileset->tilecount * sizeof(tmx_tile));
+        for (unsigned int i = 0; i < tileset->tilecount && !reader.failed; i++) {
+            tmx_tile *tile = &tileset->tiles[i];
+            tile->tileset = tileset;
+            tile->id = ReadTMXCookedU32(&reader);
+            tile->ul_x = ReadTMXCookedU32(&reader);
+            tile->ul_y = ReadTMXCookedU32(&reader);
+            tile->width = ReadTMXCookedU32(&reader);
+            tile->height = ReadTMXCookedU32(&reader);
+            tile->type = ReadTMXCookedString(&reader);
+            tile->image = ReadTMXCookedImage(&reader);
+            tile->animation_len = ReadTMXCookedU32(&reader);
+            if (tile->animation_len > (reader.size - reader.at) / 8) {
+                reader.failed = true;
+                break;
+            }
+            if (tile->animation_len > 0) {
+                tile->animation = (tmx_anim_frame *)AllocTMXCooked(&reader, tile->animation_len * sizeof(tmx_anim_frame));
+                for (unsigned int frame = 0; frame < tile->animation_len; frame++) {
+                    tile->animation[frame].tile_id = ReadTMXCookedU32(&reader);
+                    tile->animation[frame].duration = ReadTMXCookedU32(&reader);
+                }
+            }
+            tile->collision = ReadTMXCookedObjects(&reader, map);
+            ReadTMXCookedProperties(&reader, tile, 0);
+
+            unsigned int gid = list->firstgid + tile->id;
+            if (gid < map->tilecount) map->tiles[gid] = tile;
+        }
+        *link = list;
+        link = &list->next;
+    }
+
+    // The objects of the layers refer to their templates by index.
+    reader.templateCount = ReadTMXCookedU32(&reader);
+    if (reader.templateCount > (reader.size - reader.at) / 16) reader.failed = true;
+    if (!reader.failed && reader.templateCount > 0) reader.templates = (tmx_template **)AllocTMXCooked(&reader, reader.templateCount * sizeof(tmx_template *));
+    for (uint32_t t = 0; t < reader.templateCount && !reader.failed; t++) {
+        tmx_template *templateRef = (tmx_template *)AllocTMXCooked(&reader, sizeof(tmx_template));
+        templateRef->is_embedded = ReadTMXCookedI32(&reader);
+        int tilesetIndex = ReadTMXCookedI32(&reader);
+        unsigned int firstGid = ReadTMXCookedU32(&reader);
+        tmx_tileset_list *list = map->ts_head;
+        for (int i = 0; i < tilesetIndex && list != NULL; i++) list = list->next;
+        if (tilesetIndex >= 0 && list != NULL) {
+            templateRef->tileset_ref = (tmx_tileset_list *)AllocTMXCooked(&reader, sizeof(tmx_tileset_list));
+            templateRef->tileset_ref->firstgid = firstGid;
+            templateRef->tileset_ref->is_embedded = list->is_embedded;
+            templateRef->tileset_ref->source = list->source;
+            templateRef->tileset_ref->tileset = list->tileset;
+        }
+        templateRef->object = ReadTMXCookedObjects(&reader, NULL);
+        reader.templates[t] = templateRef;
+    }
+    if (!reader.failed) map->ly_head = ReadTMXCookedLayers(&reader, map, 0);
+
+    // The collisions are put in place in the state of the map, which holds the cooked data as well.
+    RaylibTMXState *state = GetTMXState(map, true);
+    if (!reader.failed) ReadTMXCookedCollisions(&reader, map, state);
+
+    cooked.allocations = reader.allocations;
+    cooked.properties = reader.properties;
+    cooked.propertyCount = reader.propertyCount;
+    if (reader.failed) {
+        TraceLog(LOG_ERROR, "TMX: Cooked TMX file %s is truncated or corrupted", fileName);
+        UnloadTMXState(map);
+        UnloadTMXCooked(map, cooked);
+        return NULL;
+    }
+    qsort(cooked.properties, (size_t)cooked.propertyCount, sizeof(RaylibTMXCookedProperties), CompareTMXCookedProperties);
+    state->cooked = cooked;
+    return FinishTMXLoad(map, NULL);
+}
+
+/**
+ * Find a custom property, in the side table of cooked maps when libtmx doesn't hold it.
+ *
+ * @internal
+ */
+tmx_property *FindTMXProperty(tmx_map *map, const void *owner, tmx_properties *properties, const char *name) {
+    if (map == NULL || owner == NULL || name == NULL) return NULL;
+    if (properties != NULL) return tmx_get_property(properties, name);
+    RaylibTMXState *state = GetTMXState(map, false);
+    if (state == NULL || state->cooked.propertyCount == 0) return NULL;
+    RaylibTMXCookedProperties key = {owner, 0, NULL};
+    RaylibTMXCookedProperties *found = (RaylibTMXCookedProperties *)bsearch(&key, state->cooked.properties, (size_t)state->cooked.propertyCount, sizeof(RaylibTMXCookedProperties), CompareTMXCookedProperties);
+    if (found == NULL) return NULL;
+    for (int i = 0; i < found->count; i++) {
+        if (strcmp(found->properties[i].name, name) == 0) return &found->properties[i];
+    }
+    return NULL;
+}
+
+/**
+ * Find a custom property of the map.
+ *
+ * Unlike tmx_get_property(), this also finds the properties of maps loaded with LoadTMXCooked().
+ *
+ * @param map  The map.
+ * @param name The name of the property.
+ *
+ * @return The property, or NULL when the map doesn't have it.
+ */
+tmx_property* GetTMXMapProperty(tmx_map *map, const char *name) {
+    return (map != NULL) ? FindTMXProperty(map, map, map->properties, name) : NULL;
+}
+
+/**
+ * Find a custom property of a layer of the map.
+ *
+ * @param map   The map holding the layer.
+ * @param layer The layer.
+ * @param name  The name of the property.
+ *
+ * @return The property, or NULL when the layer doesn't have it.
+ *
+ * @see GetTMXMapProperty()
+ */
+tmx_property* GetTMXLayerProperty(tmx_map *map, tmx_layer *layer, const char *name) {
+    return (layer != NULL) ? FindTMXProperty(map, layer, layer->properties, name) : NULL;
+}
+
+/**
+ * Find a custom property of a tile of the map.
+ *
+ * @param map  The map holding the tile.
+ * @param tile The tile.
+ * @param name The name of the property.
+ *
+ * @return The property, or NULL when the tile doesn't have it.
+ *
+ * @see GetTMXMapProperty()
+ */
+tmx_property* GetTMXTileProperty(tmx_map *map, tmx_tile *tile, const char *name) {
+    return (tile != NULL) ? FindTMXProperty(map, tile, tile->properties, name) : NULL;
+}
+
+/**
+ * Find a custom property of an object of the map, including the collisions of its tiles.
+ *
+ * @param map    The map holding the object.
+ * @param object The object.
+ * @param name   The name of the property.
+ *
+ * @return The property, or NULL when the object doesn't have it.
+ *
+ * @see GetTMXMapProperty()
+ */
+tmx_property* GetTMXObjectProperty(tmx_map *map, tmx_object *object, const char *name) {
+    return (object != NULL) ? FindTMXProperty(map, object, object->properties, name) : NULL;
+}
+
+/**
+ * Find a member of a class property of the map.
+ *
+ * @param map      The map holding the property.
+ * @param property The class property, of type PT_CUSTOM.
+ * @param name     The name of the member.
+ *
+ * @return The member, or NULL when the property isn't a class or doesn't have it.
+ *
+ * @see GetTMXMapProperty()
+ */
+tmx_property* GetTMXPropertyMember(tmx_map *map, tmx_property *property, const char *name) {
+    if (property == NULL || property->type != PT_CUSTOM) return NULL;
+    return FindTMXProperty(map, property, property->value.properties, name);
+}
+
+/**
+ * Unload the animation states of the map's animated tiles, and its GID tables.
+ *
+ * Everything is held in a few arrays sized when the map was loaded, so this doesn't depend on the
+ * size of the map.
+ *
+ * @internal
+ */
+void UnloadAnimations(tmx_map* map) {
+    RaylibTMXState *state = GetTMXState(map, false);
+    if (state == NULL) return;
+
+    MemFree(state->animations);
+    MemFree(state->animationStates);
+    MemFree(state->animationFrames);
+    MemFree(state->animationFrameGids);
+    MemFree(state->tilesetKeys);
+    MemFree(state->tilesetFirstGids);
+    state->animations = NULL;
+    state->animationStates = NULL;
+    state->animationFrames = NULL;
+    state->animationFrameGids = NULL;
+    state->tilesetKeys = NULL;
+    state->tilesetFirstGids = NULL;
+    state->tilesetSlots = 0;
+    state->animationCount = 0;
+    state->animationsLoaded = false;
+}
+
+/**
+ * Unloads the given TMX map.
+ *
+ * @param map The map to unload.
+ */
+void UnloadTMX(tmx_map* map) {
+    if (map) {
+        // The external tilesets of maps loaded from memory belong to their resource manager.
+        RaylibTMXState *state = GetTMXState(map, false);
+        tmx_resource_manager *resourceManager = (state != NULL) ? state->resourceManager : NULL;
+        RaylibTMXCooked cooked = (state != NULL) ? state->cooked : (RaylibTMXCooked){0};
+        UnloadAnimations(map);
+        UnloadTMXState(map);
+        // The worker threads are only kept while maps may use them.
+        if (raylibTMXStates == NULL) StopTMXWorkers();
+        if (cooked.data != NULL) {
+            UnloadTMXCooked(map, cooked);
+        }
+        else {
+            tmx_map_free(map);
+        }
+        if (resourceManager != NULL) tmx_free_resource_manager(resourceManager);
+        TraceLog(LOG_INFO, "TMX: Unloaded map");
+    }
+}
+
+#ifndef RAYLIB_TMX_LINE_THICKNESS
+#define RAYLIB_TMX_LINE_THICKNESS 3.0f
+#endif
+
+// Bounds used by the drawing functions that render everything
+#define RAYLIB_TMX_NO_BOUNDS (Rectangle){-FLT_MAX/2.0f, -FLT_MAX/2.0f, FLT_MAX, FLT_MAX}
+
+/**
+ * @internal
+ */
+void DrawTMXPolyline(double offset_x, double offset_y, double **points, int points_count, Color color) {
+	for (int i = 1; i < points_count; i++) {
+		DrawLineEx((Vector2){(float)(offset_x + points[i-1][0]), (float)(offset_y + points[i-1][1])},
+		           (Vector2){(float)(offset_x + points[i][0]), (float)(offset_y + points[i][1])},
+		           RAYLIB_TMX_LINE_THICKNESS, color);
+	}
+}
+
+/**
+ * @internal
+ */
+void DrawTMXPolygon(double offset_x, double offset_y, double **points, int points_count, Color color) {
+	DrawTMXPolyline(offset_x, offset_y, points, points_count, color);
+	if (points_count > 2) {
+		DrawLineEx((Vector2){(float)(offset_x + points[0][0]), (float)(offset_y + points[0][1])},
+		           (Vector2){(float)(offset_x + points[points_count-1][0]), (float)(offset_y + points[points_count-1][1])},
+		           RAYLIB_TMX_LINE_THICKNESS, color);
+	}
+}
+
+/**
+ * @internal
+ */
+void DrawTMXText(tmx_text* text, Rectangle dest, Color tint) {
+    float fontSize = (float)text->pixelsize;
+    const char* message = text->text;
+    Font font = GetFontDefault();
+    // TODO: Figure out the correct spacing.
+    float spacing = (float)text->kerning * fontSize / 12.0f;
+    Vector2 position = {dest.x, dest.y};
+
+    if (text->wrap == 0) {
+        Vector2 textSize = MeasureTextEx(font, message, fontSize, spacing);
+        if (text->halign == HA_CENTER) {
+            position.x = dest.x + dest.width / 2.0f - textSize.x / 2.0f;
+        }
+        else if (text->halign == HA_RIGHT) {
+            position.x = dest.x + dest.width - textSize.x;
+        }
+        if (text->valign == VA_CENTER) {
+            position.y = dest.y + dest.height / 2.0f - textSize.y / 2.0f;
+        }
+        else if (text->valign == VA_BOTTOM) {
+            position.y = dest.y + dest.height - textSize.y;
+        }
+        DrawTextEx(font, message, position, fontSize, spacing, tint);
+    }
+    else {
+        Vector2 origin = {0.0f, 0.0f};
+        DrawTextPro(font, message, position, origin, 0.0f, fontSize, spacing, tint);
+    }
+}
+
+/**
+ * Get the area an object is drawn over, relative to its layer.
+ *
+ * Tile objects are aligned and rotated like DrawTMXObjectTile() does, and outlines are widened by
+ * the line thickness.
+ *
+ * @return False when the area isn't known, like for texts that may be wider than their object.
+ *
+ * @internal
+ */
+bool GetTMXObjectDrawBounds(tmx_map *map, tmx_object *object, Rectangle *bounds) {
+    float x = (float)object->x;
+    float y = (float)object->y;
+    float width = (float)object->width;
+    float height = (float)object->height;
+    float margin = RAYLIB_TMX_LINE_THICKNESS;
+    switch (object->obj_type)
+    {
+        case OT_POLYGON:
+        case OT_POLYLINE: {
+            double **points = object->content.shape->points;
+            double minX = 0.0, minY = 0.0, maxX = 0.0, maxY = 0.0;
+            for (int i = 0; i < object->content.shape->points_len; i++) {
+                minX = (i == 0 || points[i][0] < minX) ? points[i][0] : minX;
+                minY = (i == 0 || points[i][1] < minY) ? points[i][1] : minY;
+                maxX = (i == 0 || points[i][0] > maxX) ? points[i][0] : maxX;
+                maxY = (i == 0 || points[i][1] > maxY) ? points[i][1] : maxY;
+            }
+            *bounds = (Rectangle){x + (float)minX, y + (float)minY, (float)(maxX - minX), (float)(maxY - minY)};
+        } break;
+        case OT_POINT: {
+            *bounds = (Rectangle){x + width / 2.0f - 5.0f, y + height / 2.0f - 5.0f, 10.0f, 10.0f};
+            margin = 1.0f;
+        } break;
+        case OT_TILE: {
+            tmx_tile *tile = map->tiles[object->content.gid & TMX_FLIP_BITS_REMOVAL];
+            if (tile != NULL && (tile->tileset->objectalignment == OA_NONE || tile->tileset->objectalignment == OA_BOTTOMLEFT)) {
+                y -= height;
+            }
+
+            // The tile is rotated around its top left corner.
+            float sinR = sinf((float)object->rotation * DEG2RAD);
+            float cosR = cosf((float)object->rotation * DEG2RAD);
+            float cornersX[4] = {0.0f, width * cosR, -height * sinR, width * cosR - height * sinR};
+            float cornersY[4] = {0.0f, width * sinR, height * cosR, width * sinR + height * cosR};
+            float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+            for (int i = 1; i < 4; i++) {
+                minX = fminf(minX, cornersX[i]);
+                minY = fminf(minY, cornersY[i]);
+                maxX = fmaxf(maxX, cornersX[i]);
+                maxY = fmaxf(maxY, cornersY[i]);
+            }
+            *bounds = (Rectangle){x + minX, y + minY, maxX - minX, maxY - minY};
+            margin = 1.0f;
+        } break;
+        case OT_TEXT:
+            return false;
+        default:
+            *bounds = (Rectangle){x, y, width, height};
+            break;
+    }
+
+    bounds->x -= margin;
+    bounds->y -= margin;
+    bounds->width += margin * 2.0f;
+    bounds->height += margin * 2.0f;
+    return true;
+}
+
+/**
+ * Get the range of the buckets of an object grid that a rectangle overlaps, clamped to the grid.
+ *
+ * @internal
+ */
+void GetTMXObjectGridRange(RaylibTMXObjectGrid *grid, Rectangle bounds, int *minX, int *minY, int *maxX, int *maxY) {
+    *minX = (int)fminf(fmaxf(floorf(bounds.x / grid->bucketWidth), 0.0f), (float)(grid->bucketsX - 1));
+    *minY = (int)fminf(fmaxf(floorf(bounds.y / grid->bucketHeight), 0.0f), (float)(grid->bucketsY - 1));
+    *maxX = (int)fminf(fmaxf(floorf((bounds.x + bounds.width) / grid->bucketWidth), 0.0f), (float)(grid->bucketsX - 1));
+    *maxY = (int)fminf(fmaxf(floorf((bounds.y + bounds.height) / grid->bucketHeight), 0.0f), (float)(grid->bucketsY - 1));
+}
+
+/**
+ * Build the drawing grid of an object layer, when it holds enough objects for one to be worth it.
+ *
+ * The grid covers the map, and objects outside of it go in the buckets at its edges.
+ *
+ * @internal
+ */
+void LoadTMXObjectGrid(tmx_map *map, RaylibTMXState *state, tmx_object_group *group) {
+    int objectCount = 0;
+    for (tmx_object *object = group->head; object != NULL; object = object->next) objectCount++;
+    if (objectCount < RAYLIB_TMX_OBJECT_GRID_MIN) return;
+
+    RaylibTMXObjectGrid *grid = (RaylibTMXObjectGrid *)MemAlloc(sizeof(RaylibTMXObjectGrid));
+    grid->group = group;
+    grid->bucketWidth = (float)(map->tile_width * RAYLIB_TMX_INDEX_BUCKET_SIZE);
+    grid->bucketHeight = (float)(map->tile_height * RAYLIB_TMX_INDEX_BUCKET_SIZE);
+    grid->bucketsX = ((int)map->width + RAYLIB_TMX_INDEX_BUCKET_SIZE - 1) / RAYLIB_TMX_INDEX_BUCKET_SIZE;
+    grid->bucketsY = ((int)map->height + RAYLIB_TMX_INDEX_BUCKET_SIZE - 1) / RAYLIB_TMX_INDEX_BUCKET_SIZE;
+    if (grid->bucketsX < 1) grid->bucketsX = 1;
+    if (grid->bucketsY < 1) grid->bucketsY = 1;
+    if (grid->bucketWidth <= 0.0f) grid->bucketWidth = 1.0f;
+    if (grid->bucketHeight <= 0.0f) grid->bucketHeight = 1.0f;
+    int bucketCount = grid->bucketsX * grid->bucketsY;
+
+    grid->objectCount = objectCount;
+    grid->objects = (tmx_object **)MemAlloc((unsigned int)objectCount * sizeof(tmx_object *));
+    grid->stamps = (unsigned int *)MemAlloc((unsigned int)objectCount * sizeof(unsigned int));
+    grid->found = (int *)MemAlloc((unsigned int)objectCount * sizeof(int));
+    Rectangle *bounds = (Rectangle *)MemAlloc((unsigned int)objectCount * sizeof(Rectangle));
+    bool *bounded = (bool *)MemAlloc((unsigned int)objectCount * sizeof(bool));
+    int i = 0;
+    for (tmx_object *object = group->head; object != NULL; object = object->next, i++) {
+        grid->objects[i] = object;
+        bounded[i] = GetTMXObjectDrawBounds(map, object, &bounds[i]);
+        if (!bounded[i]) {
+            grid->unbounded = (int *)MemRealloc(grid->unbounded, (unsigned int)(grid->unboundedCount + 1) * sizeof(int));
+            grid->unbounded[grid->unboundedCount++] = i;
+        }
+    }
+
+    // Count the entries of each bucket, then fill them in, so all entries share one array.
+    grid->bucketStarts = (int *)MemAlloc((unsigned int)(bucketCount + 1) * sizeof(int));
+    for (i = 0; i < objectCount; i++) {
+        if (!bounded[i]) continue;
+        int minX, minY, maxX, maxY;
+        GetTMXObjectGridRange(grid, bounds[i], &minX, &minY, &maxX, &maxY);
+        for (int y = minY; y <= maxY; y++) {
+            for (int x = minX; x <= maxX; x++) grid->bucketStarts[y * grid->bucketsX + x + 1]++;
+        }
+    }
+    for (i = 0; i < bucketCount; i++) {
+        grid->bucketStarts[i + 1] += grid->bucketStarts[i];
+    }
+    grid->entries = (int *)MemAlloc((unsigned int)(grid->bucketStarts[bucketCount] + 1) * sizeof(int));
+    int *fill = (int *)MemAlloc((unsigned int)bucketCount * sizeof(int));
+    for (i = 0; i < objectCount; i++) {
+        if (!bounded[i]) continue;
+        int minX, minY, maxX, maxY;
+        GetTMXObjectGridRange(grid, bounds[i], &minX, &minY, &maxX, &maxY);
+        for (int y = minY; y <= maxY; y++) {
+            for (int x = minX; x <= maxX; x++) {
+                int bucket = y * grid->bucketsX + x;
+                grid->entries[grid->bucketStarts[bucket] + fill[bucket]++] = i;
+            }
+        }
+    }
+    MemFree(fill);
+    MemFree(bounded);
+    MemFree(bounds);
+
+    grid->next = state->objectGrids;
+    state->objectGrids = grid;
+}
+
+/**
+ * Build the drawing grids of the object layers in the given layers, and in their groups.
+ *
+ * @internal
+ */
+void LoadTMXObjectGrids(tmx_map *map, RaylibTMXState *state, tmx_layer *layer) {
+    for (; layer != NULL; layer = layer->next) {
+        if (layer->type == L_OBJGR) LoadTMXObjectGrid(map, state, layer->content.objgr);
+        else if (layer->type == L_GROUP) LoadTMXObjectGrids(map, state, layer->content.group_head);
+    }
+}
+
+/**
+ * @internal
+ */
+int CompareTMXObjectIndices(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+/**
+ * Find the objects of a grid that may be drawn within the given bounds, in the order they're drawn.
+ *
+ * @return The amount of objects found, whose indices are in grid->found.
+ *
+ * @internal
+ */
+int QueryTMXObjectGrid(RaylibTMXObjectGrid *grid, Rectangle bounds) {
+    unsigned int stamp = ++grid->stamp;
+    if (stamp == 0) {
+        for (int i = 0; i < grid->objectCount; i++) grid->stamps[i] = 0;
+        stamp = ++grid->stamp;
+    }
+
+    int count = 0;
+    for (int i = 0; i < grid->unboundedCount; i++) {
+        grid->found[count++] = grid->unbounded[i];
+    }
+    int minX, minY, maxX, maxY;
+    GetTMXObjectGridRange(grid, bounds, &minX, &minY, &maxX, &maxY);
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x++) {
+            int bucket = y * grid->bucketsX + x;
+            for (int entry = grid->bucketStarts[bucket]; entry < grid->bucketStarts[bucket + 1]; entry++) {
+                int i = grid->entries[entry];
+                if (grid->stamps[i] == stamp) continue;
+                grid->stamps[i] = stamp;
+                grid->found[count++] = i;
+            }
+        }
+    }
+
+    qsort(grid->found, (size_t)count, sizeof(int), CompareTMXObjectIndices);
+    return count;
+}
+
+/**
+ * @internal
+ */
+void DrawTMXObject(tmx_map *map, tmx_object *object, int posX, int posY, Color color, Color tint, tmx_tile **animationFrames) {
+    RAYLIB_TMX_STAT(objectsDrawn[object->obj_type], 1);
+    Rectangle dest = (Rectangle) {
+        (float)posX + (float)object->x,
+        (float)posY + (float)object->y,
+        (float)object->width,
+        (float)object->height
+    };
+    switch (object->obj_type)
+    {
+        case OT_SQUARE:
+            DrawRectangleLinesEx(dest, (int)RAYLIB_TMX_LINE_THICKNESS, color);
+            break;
+        case OT_POLYGON:
+            DrawTMXPolygon(dest.x, dest.y, object->content.shape->points, object->content.shape->points_len, color);
+            break;
+        case OT_POLYLINE:
+            DrawTMXPolyline(dest.x, dest.y, object->content.shape->points, object->content.shape->points_len, color);
+            break;
+        case OT_ELLIPSE: {
+            int centerX   = (int)(dest.x + object->width  / 2.0);
+            int centerY   = (int)(dest.y + object->height / 2.0);
+            float radiusH = (float)object->width / 2.0f;
+            float radiusV = (float)object->height / 2.0f;
+            DrawEllipseLines(centerX, centerY, radiusH, radiusV, color);
+        } break;
+        case OT_TILE: {
+            int baseGid = object->content.gid;
+            int gid = baseGid & TMX_FLIP_BITS_REMOVAL;
+            if (!map->tiles[gid]) break;
+            tmx_tile *tile = map->tiles[gid];
+            if (tile->animation) tile = animationFrames[gid];
+            DrawTMXObjectTile(tile, baseGid, dest, (float)object->rotation, tint);
+        } break;
+        case OT_TEXT: {
+            tmx_text* text = object->content.text;
+            Color textColor = ColorFromTMX(text->color);
+            // TODO: Fix application of the tint.
+            textColor.a = tint.a;
+            DrawTMXText(text, dest, textColor);
+        } break;
+        case OT_POINT: {
+            int centerX = (int)(dest.x + object->width  / 2.0);
+            int centerY = (int)(dest.y + object->height / 2.0);
+            DrawCircle(centerX, centerY, 5.0f, color);
+        } break;
+        case OT_NONE: break;
+    }
+}
+
+/**
+ * Render the objects of an object layer, only visiting the ones drawn within the bounds when the
+ * layer has a drawing grid.
+ *
+ * @internal
+ */
+void DrawTMXLayerObjects(tmx_map *map, tmx_object_group *objgr, int posX, int posY, Rectangle bounds, Color tint) {
+	Color color = ColorFromTMX(objgr->color);
+    tmx_tile **animationFrames = GetTMXAnimationFrames(map);
+    // TODO: Merge the tint
+
+    RaylibTMXState *state = GetTMXState(map, false);
+    RaylibTMXObjectGrid *grid = (state != NULL) ? state->objectGrids : NULL;
+    while (grid && grid->group != objgr) grid = grid->next;
+    if (grid == NULL) {
+        for (tmx_object *object = objgr->head; object != NULL; object = object->next) {
+            if (object->visible) DrawTMXObject(map, object, posX, posY, color, tint, animationFrames);
+        }
+        return;
+    }
+
+    bounds.x -= (float)posX;
+    bounds.y -= (float)posY;
+    int count = QueryTMXObjectGrid(grid, bounds);
+    for (int i = 0; i < count; i++) {
+        tmx_object *object = grid->objects[grid->found[i]];
+        if (object->visible) DrawTMXObject(map, object, posX, posY, color, tint, animationFrames);
+    }
+}
+
+/**
+ * @internal
+ */
+void DrawTMXLayerImage(tmx_image *image, int posX, int posY, Rectangle bounds, Color tint) {
+    if (image->resource_image) {
+        Texture2D *texture = (Texture2D*)image->resource_image;
+        Rectangle dest = {(float)posX, (float)posY, (float)texture->width, (float)texture->height};
+        if (!CheckCollisionRecs(dest, bounds)) return;
+        RAYLIB_TMX_STAT(tilesDrawn, 1);
+        RAYLIB_TMX_STAT_TEXTURE(texture->id);
+        DrawTexture(*texture, posX, posY, tint);
+    }
+}
+
+/**
+ * Replace the given animated tile with the tile of its current animation frame.
+ *
+ * The frames are advanced by UpdateTMXAnimations(), so this can be called for every cell.
+ *
+ * @param map The map that holds the tile.
+ * @param tile The animated tile, which will be replaced by the tile of the current frame.
+ */
+void UpdateTMXTileAnimation(tmx_map* map, tmx_tile** tile){
+    if ((*tile)->animation == NULL) return;
+    unsigned int gid = GetTMXTileGid(map, *tile);
+    tmx_tile **animationFrames = GetTMXAnimationFrames(map);
+    if (gid > 0 && gid < map->tilecount && animationFrames[gid]) {
+        *tile = animationFrames[gid];
+    }
+}
+
+/**
+ * Find the texture that holds the image of the given tile.
+ *
+ * @return The texture of the tile, or NULL if it has none.
+ *
+ * @internal
+ */
+Texture2D *GetTMXTileTexture(tmx_tile *tile) {
+    if (tile->image && tile->image->resource_image) {
+        return (Texture2D *)tile->image->resource_image;
+    }
+    if (tile->tileset->image && tile->tileset->image->resource_image) {
+        return (Texture2D *)tile->tileset->image->resource_image;
+    }
+    return NULL;
+}
+
+/**
+ * A draw recorded by BuildTMXDrawList(), drawn later by SubmitTMXDrawList().
+ *
+ * @internal
+ */
+typedef struct RaylibTMXDrawCommand {
+    Texture2D *texture;
+    Rectangle source;
+    Rectangle dest;
+    Vector2 origin;
+    float rotation;
+    Color tint;
+} RaylibTMXDrawCommand;
+
+/**
+ * A layer of a draw list, with the draws recorded for it when it's a tile layer.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXDrawLayer {
+    tmx_layer *layer;
+    int posX, posY;                     // Offset of the groups the layer is in
+    bool recorded;                      // Whether the layer is recorded, or drawn when submitted
+    RaylibTMXDrawCommand *commands;
+    int commandCount;
+    int commandCapacity;
+#if defined(RAYLIB_TMX_STATS)
+    RaylibTMXFrameStats stats;          // Counters gathered while recording the layer
+    double time;
+#endif
+} RaylibTMXDrawLayer;
+
+struct RaylibTMXDrawList {
+    tmx_map *map;
+    Rectangle bounds;
+    Color tint;
+    RaylibTMXDrawLayer *layers;
+    int layerCount;
+    int layerCapacity;
+    long nextLayer;                     // Next layer to record, shared by the workers
+};
+
+// Layer the draws of the current thread are recorded into, NULL to draw them right away.
+static RAYLIB_TMX_THREAD_LOCAL RaylibTMXDrawLayer *raylibTMXRecorder = NULL;
+
+/**
+ * Draw a part of a texture, or record the draw when building a draw list.
+ *
+ * @internal
+ */
+void DrawTMXTexturePro(Texture2D *texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+    RaylibTMXDrawLayer *recorder = raylibTMXRecorder;
+    if (recorder == NULL) {
+        RAYLIB_TMX_STAT_TEXTURE(texture->id);
+        DrawTexturePro(*texture, source, dest, origin, rotation, tint);
+        return;
+    }
+
+    if (recorder->commandCount == recorder->commandCapacity) {
+        recorder->commandCapacity = (recorder->commandCapacity == 0) ? 256 : recorder->commandCapacity * 2;
+        recorder->commands = (RaylibTMXDrawCommand *)MemRealloc(recorder->commands, (unsigned int)recorder->commandCapacity * sizeof(RaylibTMXDrawCommand));
+    }
+    recorder->commands[recorder->commandCount++] = (RaylibTMXDrawCommand){texture, source, dest, origin, rotation, tint};
+}
+
+/**
+ * Render a single TMX tile on the screen.
+ *
+ * @param tile Which tile to render on the screen.
+ * @param posX The X position of the tile.
+ * @param posY The Y position of the tile.
+ * @param tint How to tint the tile when rendering.
+ */
+void DrawTMXTile(tmx_tile* tile, unsigned int baseGid, int posX, int posY, Color tint) {
+    Texture* image = NULL;
+    Rectangle srcRect;
+    Vector2 origin = {0};
+    float rotation = 0;
+
+    srcRect.x      = (float)tile->ul_x;
+    srcRect.y      = (float)tile->ul_y;
+    srcRect.width  = (float)tile->width;
+    srcRect.height = (float)tile->height;
+
+    Rectangle destRect = srcRect;
+    destRect.x = (float)posX;
+    destRect.y = (float)posY;
+
+    int flags = (int)baseGid & ~TMX_FLIP_BITS_REMOVAL;
+    if  (flags) {
+        int is_diagonally_fliped   = (baseGid & TMX_FLIPPED_DIAGONALLY);
+        int is_horizontally_fliped = (int)(baseGid & TMX_FLIPPED_HORIZONTALLY);
+        int is_vertically_fliped   = (baseGid & TMX_FLIPPED_VERTICALLY);
+	    if (is_diagonally_fliped) {
+            if (is_horizontally_fliped && is_vertically_fliped) {
+                srcRect.height = (float) -fabs(srcRect.height);
+                rotation = 270.0f;
+            } else if (is_horizontally_fliped) {
+                rotation = 90.0f;
+            } else if (is_vertically_fliped) {
+                rotation = 270.0f;
+            } else {
+                srcRect.height = (float) -fabs(srcRect.height);
+                rotation = -270.0f;
+            }
+            origin.x    = destRect.width  * 0.5f;
+            origin.y    = destRect.height * 0.5f;
+            destRect.x += origin.x;
+            destRect.y += origin.y;
+	    } else {
+            if (is_horizontally_fliped) {
+		        srcRect.width =  (float) -fabs(srcRect.width);
+	        }
+            if (is_vertically_fliped) {
+		        srcRect.height = (float) -fabs(srcRect.height);
+	        }
+        }
+    }
+
+    // Find the image
+    image = GetTMXTileTexture(tile);
+    if (image) {
+        DrawTMXTexturePro(image, srcRect, destRect, origin, rotation, tint);
+    }
+}
+
+/**
+ * Render a single TMX tile of a TMX Object on the screen.
+ *
+ * @param tile      Which tile to render on the screen.
+ * @param gid       The GID of the object used to calculate it flags
+ * @param destRect  The destination of the tile on screen
+ * @param rotation  The rotation of the tile on screen
+ * @param tint      How to tint the tile when rendering.
+ */
+void DrawTMXObjectTile(tmx_tile* tile, int baseGid, Rectangle destRect, float rotation, Color tint) {
+    Texture* image = NULL;
+    Vector2 origin = {0};
     Rectangle srcRect = (Rectangle) {
         .x      = (float)tile->ul_x,
         .y      = (float)tile->ul_y,
@@ -483,343 +3788,4179 @@ void DrawTMXObjectTile(tmx_tile* tile, int baseGid, Rectangle destRect, float ro
         .height = (float)tile->height
     };
 
-    switch (tile->tileset->objectalignment)
-    {
-        case OA_TOPLEFT: /*RAYLIB DEFAULT*/ break;
-        case OA_NONE:
-        case OA_BOTTOMLEFT: { /* TILED DEFAULT */
-            destRect.y -= destRect.height;
-        } break;
-        case OA_TOP:         /* TODO */ break;
-        case OA_LEFT:        /* TODO */ break;
-        case OA_BOTTOM:      /* TODO */ break;
-        case OA_RIGHT:       /* TODO */ break;
-        case OA_TOPRIGHT:    /* TODO */ break;
-        case OA_BOTTOMRIGHT: /* TODO */ break;
-        case OA_CENTER:      /* TODO */ break;
+    switch (tile->tileset->objectalignment)
+    {
+        case OA_TOPLEFT: /*RAYLIB DEFAULT*/ break;
+        case OA_NONE:
+        case OA_BOTTOMLEFT: { /* TILED DEFAULT */
+            destRect.y -= destRect.height;
+        } break;
+        case OA_TOP:         /* TODO */ break;
+        case OA_LEFT:        /* TODO */ break;
+        case OA_BOTTOM:      /* TODO */ break;
+        case OA_RIGHT:       /* TODO */ break;
+        case OA_TOPRIGHT:    /* TODO */ break;
+        case OA_BOTTOMRIGHT: /* TODO */ break;
+        case OA_CENTER:      /* TODO */ break;
+    }
+
+    int flags = baseGid & ~TMX_FLIP_BITS_REMOVAL;
+    if  (flags) {
+        int is_horizontally_fliped = {
+            (int)((unsigned int)baseGid & TMX_FLIPPED_HORIZONTALLY)
+        };
+        if (is_horizontally_fliped) {
+		    srcRect.width = (float) -fabs(srcRect.width);
+	    }
+        int is_vertically_fliped = baseGid & TMX_FLIPPED_VERTICALLY;
+        if (is_vertically_fliped) {
+		    srcRect.height = (float) -fabs(srcRect.height);
+	    }
+    }
+
+    // Find the image
+    image = GetTMXTileTexture(tile);
+    if (image) {
+        DrawTMXTexturePro(image, srcRect, destRect, origin, rotation, tint);
+    }
+}
+
+/**
+ * Get the size of the largest tiles of the map, which is at least the size of its grid.
+ *
+ * @internal
+ */
+void GetTMXMaxTileSize(tmx_map *map, float *maxWidth, float *maxHeight) {
+    *maxWidth = (float)map->tile_width;
+    *maxHeight = (float)map->tile_height;
+    for (tmx_tileset_list *ts = map->ts_head; ts != NULL; ts = ts->next) {
+        if ((float)ts->tileset->tile_width > *maxWidth) *maxWidth = (float)ts->tileset->tile_width;
+        if ((float)ts->tileset->tile_height > *maxHeight) *maxHeight = (float)ts->tileset->tile_height;
+    }
+}
+
+/**
+ * Whether the cells of the map are laid out on a rectangular grid, which the baked chunks, meshes
+ * and compiled layers rely on.
+ *
+ * @internal
+ */
+bool IsTMXOrthogonal(tmx_map *map) {
+    return map->orient == O_ORT || map->orient == O_NONE;
+}
+
+/**
+ * Calculate which cells of a tile layer overlap the given bounds.
+ *
+ * Tiles from tilesets larger than the map grid are drawn extending to the right and downwards, so
+ * the range is widened by the largest tileset tile size.
+ *
+ * @param startX Receives the first visible column.
+ * @param startY Receives the first visible row.
+ * @param endX Receives the column after the last visible one.
+ * @param endY Receives the row after the last visible one.
+ *
+ * @internal
+ */
+void GetTMXLayerCellRange(tmx_map *map, int posX, int posY, Rectangle bounds, int *startX, int *startY, int *endX, int *endY) {
+    float tileWidth = (float)map->tile_width;
+    float tileHeight = (float)map->tile_height;
+    float maxWidth, maxHeight;
+    GetTMXMaxTileSize(map, &maxWidth, &maxHeight);
+
+    float minX = floorf((bounds.x - (float)posX - maxWidth) / tileWidth) + 1.0f;
+    float minY = floorf((bounds.y - (float)posY - maxHeight) / tileHeight) + 1.0f;
+    float maxX = ceilf((bounds.x + bounds.width - (float)posX) / tileWidth);
+    float maxY = ceilf((bounds.y + bounds.height - (float)posY) / tileHeight);
+
+    // Clamp while still in floating point, so unbounded rectangles don't overflow.
+    *startX = (int)fminf(fmaxf(minX, 0.0f), (float)map->width);
+    *startY = (int)fminf(fmaxf(minY, 0.0f), (float)map->height);
+    *endX = (int)fminf(fmaxf(maxX, (float)*startX), (float)map->width);
+    *endY = (int)fminf(fmaxf(maxY, (float)*startY), (float)map->height);
+}
+
+/**
+ * Check which tiles of the map have partly transparent pixels, reading each texture back once.
+ *
+ * Textures that can't be read back are taken as having no such pixels. Reading a texture back may
+ * go through a framebuffer of its own, so the one being drawn into is bound again afterwards.
+ *
+ * @internal
+ */
+void LoadTMXTranslucentTiles(tmx_map *map, RaylibTMXState *state) {
+    state->translucentTiles = (unsigned char *)MemAlloc(map->tilecount + 1);
+    rlDrawRenderBatchActive();
+    unsigned int framebuffer = rlGetActiveFramebuffer();
+    Texture2D *texture = NULL;
+    Image image = {0};
+    for (unsigned int gid = 0; gid < map->tilecount; gid++) {
+        tmx_tile *tile = map->tiles[gid];
+        Texture2D *tileTexture = (tile != NULL) ? GetTMXTileTexture(tile) : NULL;
+        if (tileTexture == NULL) continue;
+        if (tileTexture != texture) {
+            UnloadImage(image);
+            texture = tileTexture;
+            image = LoadImageFromTexture(*texture);
+            if (image.data != NULL) ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        }
+        if (image.data == NULL) continue;
+
+        const Color *pixels = (const Color *)image.data;
+        int endX = (int)(tile->ul_x + tile->width), endY = (int)(tile->ul_y + tile->height);
+        if (endX > image.width) endX = image.width;
+        if (endY > image.height) endY = image.height;
+        for (int y = (int)tile->ul_y; y < endY && !state->translucentTiles[gid]; y++) {
+            for (int x = (int)tile->ul_x; x < endX; x++) {
+                unsigned char alpha = pixels[y * image.width + x].a;
+                if (alpha == 0 || alpha == 255) continue;
+                state->translucentTiles[gid] = true;
+                break;
+            }
+        }
+    }
+    UnloadImage(image);
+    if (framebuffer != 0) rlEnableFramebuffer(framebuffer);
+}
+
+/**
+ * Check whether a tile stays within its cell, rather than overlapping the neighboring cells.
+ *
+ * Overlapping tiles must be drawn one by one in the render order of the map to stack the same way.
+ *
+ * @internal
+ */
+bool IsTMXTileInsideCell(tmx_map *map, tmx_tile *tile, unsigned int baseGid) {
+    // Diagonally flipped tiles are turned around their center.
+    float width = (float)tile->width, height = (float)tile->height;
+    float left = 0.0f, top = 0.0f;
+    if (baseGid & TMX_FLIPPED_DIAGONALLY) {
+        left = (width - height) * 0.5f;
+        top = (height - width) * 0.5f;
+        width = (float)tile->height;
+        height = (float)tile->width;
+    }
+    return left >= 0.0f && top >= 0.0f && left + width <= (float)map->tile_width && top + height <= (float)map->tile_height;
+}
+
+/**
+ * Check whether a cell can be baked into a chunk, and look the same as when drawn by itself.
+ *
+ * Animated tiles change every frame. Tiles reaching out of their cell overlap their neighbors,
+ * which the chunks would draw in another order than the render order, or cover with the next
+ * chunk. Partly transparent pixels would be blended twice, once into the chunk and once more onto
+ * the screen.
+ *
+ * @internal
+ */
+bool IsTMXCellBakeable(tmx_map *map, RaylibTMXState *state, unsigned int baseGid) {
+    tmx_tile *tile = map->tiles[baseGid & TMX_FLIP_BITS_REMOVAL];
+    if (tile == NULL) return true;
+    if (tile->animation) return false;
+    if (!IsTMXTileInsideCell(map, tile, baseGid)) return false;
+
+    if (state->translucentTiles == NULL) LoadTMXTranslucentTiles(map, state);
+    return !state->translucentTiles[baseGid & TMX_FLIP_BITS_REMOVAL];
+}
+
+/**
+ * Get, or create, the cache of the given tile layer.
+ *
+ * @internal
+ */
+RaylibTMXLayerCache *GetTMXLayerCache(tmx_map *map, RaylibTMXState *state, tmx_layer *layer) {
+    for (RaylibTMXLayerCache *cache = state->layerCaches; cache != NULL; cache = cache->next) {
+        if (cache->layer == layer) return cache;
+    }
+
+    RaylibTMXLayerCache *cache = (RaylibTMXLayerCache *)MemAlloc(sizeof(RaylibTMXLayerCache));
+    cache->layer = layer;
+    cache->chunksX = ((int)map->width + RAYLIB_TMX_CHUNK_SIZE - 1) / RAYLIB_TMX_CHUNK_SIZE;
+    cache->chunksY = ((int)map->height + RAYLIB_TMX_CHUNK_SIZE - 1) / RAYLIB_TMX_CHUNK_SIZE;
+
+    for (unsigned int i = 0; i < map->width * map->height; i++) {
+        if (!IsTMXCellBakeable(map, state, layer->content.gids[i])) {
+            cache->unbaked = true;
+            break;
+        }
+    }
+
+    if (!cache->unbaked) {
+        cache->chunks = (RenderTexture2D *)MemAlloc((unsigned int)(cache->chunksX * cache->chunksY) * sizeof(RenderTexture2D));
+        cache->dirty = (bool *)MemAlloc((unsigned int)(cache->chunksX * cache->chunksY) * sizeof(bool));
+        cache->entries = (RaylibTMXCacheEntry **)MemAlloc((unsigned int)(cache->chunksX * cache->chunksY) * sizeof(RaylibTMXCacheEntry *));
+    }
+
+    cache->next = state->layerCaches;
+    state->layerCaches = cache;
+    return cache;
+}
+
+/**
+ * Move a baked chunk to the end of the least recently used list, adding it when it was just baked.
+ *
+ * @internal
+ */
+void UseTMXCacheChunk(RaylibTMXState *state, RaylibTMXLayerCache *cache, int index) {
+    RaylibTMXCacheEntry *entry = cache->entries[index];
+    if (entry == NULL) {
+        entry = (RaylibTMXCacheEntry *)MemAlloc(sizeof(RaylibTMXCacheEntry));
+        entry->cache = cache;
+        entry->index = index;
+        cache->entries[index] = entry;
+    }
+    else if (entry == state->mostUsed) {
+        return;
+    }
+    else {
+        if (entry->previous) entry->previous->next = entry->next;
+        else state->leastUsed = entry->next;
+        entry->next->previous = entry->previous;
+    }
+
+    entry->previous = state->mostUsed;
+    entry->next = NULL;
+    if (state->mostUsed) state->mostUsed->next = entry;
+    else state->leastUsed = entry;
+    state->mostUsed = entry;
+}
+
+/**
+ * Unload a baked chunk, and take it out of the least recently used list.
+ *
+ * @internal
+ */
+void UnloadTMXCacheChunk(RaylibTMXState *state, RaylibTMXLayerCache *cache, int index) {
+    RaylibTMXCacheEntry *entry = cache->entries[index];
+    if (entry) {
+        if (entry->previous) entry->previous->next = entry->next;
+        else state->leastUsed = entry->next;
+        if (entry->next) entry->next->previous = entry->previous;
+        else state->mostUsed = entry->previous;
+        MemFree(entry);
+        cache->entries[index] = NULL;
+    }
+    if (cache->chunks[index].id == 0) return;
+    UnloadRenderTexture(cache->chunks[index]);
+    cache->chunks[index] = (RenderTexture2D){0};
+    state->cacheResident--;
+}
+
+/**
+ * Unload the least recently used chunks until the cache fits its budget.
+ *
+ * The chunk being baked is always the most recently used one, so it stays.
+ *
+ * @internal
+ */
+void EvictTMXCacheChunks(RaylibTMXState *state) {
+    if (state->cacheBudget <= 0 || state->cacheResident <= state->cacheBudget) return;
+
+    // The chunks may have been drawn already this frame, so send those draws before unloading them.
+    rlDrawRenderBatchActive();
+    while (state->cacheResident > state->cacheBudget && state->leastUsed != state->mostUsed) {
+        UnloadTMXCacheChunk(state, state->leastUsed->cache, state->leastUsed->index);
+    }
+}
+
+/**
+ * Render the tiles of a single chunk into its render texture.
+ *
+ * The current 2D camera and projection are restored afterwards, along with the render texture the
+ * application was drawing into, so chunks can be baked in the middle of a frame, even within
+ * BeginTextureMode().
+ *
+ * @internal
+ */
+void BakeTMXLayerChunk(tmx_map *map, RaylibTMXState *state, RaylibTMXLayerCache *cache, int chunkX, int chunkY) {
+    RenderTexture2D *target = &cache->chunks[chunkY * cache->chunksX + chunkX];
+    int tileWidth = (int)map->tile_width;
+    int tileHeight = (int)map->tile_height;
+
+    if (target->id == 0) {
+        // Leave room for tiles that are larger than the map grid.
+        int overflowX = 0, overflowY = 0;
+        for (tmx_tileset_list *ts = map->ts_head; ts != NULL; ts = ts->next) {
+            if ((int)ts->tileset->tile_width - tileWidth > overflowX) overflowX = (int)ts->tileset->tile_width - tileWidth;
+            if ((int)ts->tileset->tile_height - tileHeight > overflowY) overflowY = (int)ts->tileset->tile_height - tileHeight;
+        }
+        *target = LoadRenderTexture(RAYLIB_TMX_CHUNK_SIZE * tileWidth + overflowX, RAYLIB_TMX_CHUNK_SIZE * tileHeight + overflowY);
+        state->cacheResident++;
+        UseTMXCacheChunk(state, cache, chunkY * cache->chunksX + chunkX);
+        EvictTMXCacheChunks(state);
+    }
+
+    int startX = chunkX * RAYLIB_TMX_CHUNK_SIZE;
+    int startY = chunkY * RAYLIB_TMX_CHUNK_SIZE;
+    int endX = (startX + RAYLIB_TMX_CHUNK_SIZE < (int)map->width) ? startX + RAYLIB_TMX_CHUNK_SIZE : (int)map->width;
+    int endY = (startY + RAYLIB_TMX_CHUNK_SIZE < (int)map->height) ? startY + RAYLIB_TMX_CHUNK_SIZE : (int)map->height;
+
+    // BeginTextureMode() sends the pending draws to the current framebuffer before switching, but
+    // EndTextureMode() goes back to the screen, so the framebuffer and its viewport are kept too.
+    unsigned int framebuffer = rlGetActiveFramebuffer();
+    int framebufferWidth = rlGetFramebufferWidth();
+    int framebufferHeight = rlGetFramebufferHeight();
+    Matrix modelview = rlGetMatrixModelview();
+    Matrix projection = rlGetMatrixProjection();
+    BeginTextureMode(*target);
+    {
+        ClearBackground(BLANK);
+
+        // Draw the cells of the chunk, offset so that the chunk starts at the texture origin.
+        for (int y = startY; y < endY; y++) {
+            for (int x = startX; x < endX; x++) {
+                unsigned int baseGid = cache->layer->content.gids[(y * (int)map->width) + x];
+                tmx_tile *tile = map->tiles[baseGid & TMX_FLIP_BITS_REMOVAL];
+                if (!tile) continue;
+                DrawTMXTile(tile, baseGid, (x - startX) * tileWidth, (y - startY) * tileHeight, WHITE);
+            }
+        }
+    }
+    EndTextureMode();
+    if (framebuffer != 0) {
+        rlEnableFramebuffer(framebuffer);
+        rlViewport(0, 0, framebufferWidth, framebufferHeight);
+        rlSetFramebufferWidth(framebufferWidth);
+        rlSetFramebufferHeight(framebufferHeight);
+    }
+    rlSetMatrixProjection(projection);
+    rlSetMatrixModelview(modelview);
+
+    cache->dirty[chunkY * cache->chunksX + chunkX] = false;
+}
+
+/**
+ * Render a tile layer through its baked chunks, baking the visible ones that are missing or dirty.
+ *
+ * @return True when the layer was drawn, false when it needs to be drawn tile by tile.
+ *
+ * @internal
+ */
+bool DrawTMXLayerCached(tmx_map *map, RaylibTMXState *state, tmx_layer *layer, int posX, int posY, Rectangle bounds, Color tint) {
+    RaylibTMXLayerCache *cache = GetTMXLayerCache(map, state, layer);
+    if (cache->unbaked) return false;
+
+    int minX, minY, maxX, maxY;
+    GetTMXLayerCellRange(map, posX, posY, bounds, &minX, &minY, &maxX, &maxY);
+    if (minX == maxX || minY == maxY) return true;
+
+    int chunkWidth = RAYLIB_TMX_CHUNK_SIZE * (int)map->tile_width;
+    int chunkHeight = RAYLIB_TMX_CHUNK_SIZE * (int)map->tile_height;
+    Color newTint = ColorAlpha(tint, (float)layer->opacity);
+
+    for (int chunkY = minY / RAYLIB_TMX_CHUNK_SIZE; chunkY <= (maxY - 1) / RAYLIB_TMX_CHUNK_SIZE; chunkY++) {
+        for (int chunkX = minX / RAYLIB_TMX_CHUNK_SIZE; chunkX <= (maxX - 1) / RAYLIB_TMX_CHUNK_SIZE; chunkX++) {
+            int index = chunkY * cache->chunksX + chunkX;
+            if (cache->chunks[index].id == 0 || cache->dirty[index]) {
+                BakeTMXLayerChunk(map, state, cache, chunkX, chunkY);
+            }
+            UseTMXCacheChunk(state, cache, index);
+
+            Texture2D texture = cache->chunks[index].texture;
+            RAYLIB_TMX_STAT(chunksDrawn, 1);
+            RAYLIB_TMX_STAT_TEXTURE(texture.id);
+            Rectangle source = {0.0f, 0.0f, (float)texture.width, -(float)texture.height};
+            Rectangle dest = {
+                (float)(posX + chunkX * chunkWidth),
+                (float)(posY + chunkY * chunkHeight),
+                (float)texture.width,
+                (float)texture.height
+            };
+            DrawTexturePro(texture, source, dest, (Vector2){0.0f, 0.0f}, 0.0f, newTint);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Start baking the static tile layers of the given map into chunks of render textures.
+ *
+ * Each chunk covers RAYLIB_TMX_CHUNK_SIZE by RAYLIB_TMX_CHUNK_SIZE cells, and is baked the first
+ * time it is drawn. Later frames draw a single texture per visible chunk instead of every tile.
+ * Layers holding animated tiles, tiles larger than the map grid or tiles with partly transparent
+ * pixels, and maps that aren't orthogonal, keep being drawn tile by tile, so that the cache looks
+ * the same as drawing without it.
+ *
+ * @param map The map to cache.
+ *
+ * @see DisableTMXCache()
+ * @see InvalidateTMXCache()
+ */
+void EnableTMXCache(tmx_map *map) {
+    if (map == NULL) return;
+    GetTMXState(map, true)->cacheEnabled = true;
+}
+
+// Defined along with the collisions they bake
+RaylibTMXColliderBlock *GetTMXColliderChunk(tmx_map *map, RaylibTMXState *state, RaylibTMXLayerColliders *colliders, int chunkX, int chunkY);
+void EvictTMXColliderChunks(RaylibTMXState *state);
+
+/**
+ * Limit the amount of chunks baked by the cache, unloading the least recently drawn ones first.
+ *
+ * This keeps the texture memory used by the cache of large maps bounded, as only the chunks around
+ * the camera stay baked. The budget should be larger than the amount of chunks visible at once,
+ * otherwise chunks get baked again every frame.
+ *
+ * The collisions baked for the chunks of tile layers are bounded by the same amount, unloading the
+ * least recently queried ones first, whether the map is cached or not. Collisions returned by
+ * GetTMXCellColliders() stay valid until that many other chunks have been queried. With a budget,
+ * the collisions of a chunk are only baked the first time it's queried or streamed.
+ *
+ * The cells of the map are still held as a single grid by libtmx, so they, and the meshes and
+ * compiled layers built from them, take memory in proportion to the size of the map.
+ *
+ * @param map The map that is cached with EnableTMXCache().
+ * @param maxChunks The maximum amount of chunks kept baked across all layers, 0 for no limit.
+ *
+ * @see StreamTMXCache()
+ */
+void SetTMXCacheBudget(tmx_map *map, int maxChunks) {
+    if (map == NULL) return;
+    RaylibTMXState *state = GetTMXState(map, true);
+    state->cacheBudget = (maxChunks > 0) ? maxChunks : 0;
+    EvictTMXCacheChunks(state);
+    EvictTMXColliderChunks(state);
+}
+
+/**
+ * Bake the chunks of the given layers that overlap the bounds.
+ *
+ * @internal
+ */
+void StreamTMXLayers(tmx_map *map, RaylibTMXState *state, tmx_layer *layer, int posX, int posY, Rectangle bounds) {
+    for (; layer != NULL; layer = layer->next) {
+        if (!layer->visible) continue;
+        if (layer->type == L_GROUP) {
+            StreamTMXLayers(map, state, layer->content.group_head, posX + layer->offsetx, posY + layer->offsety, bounds);
+            continue;
+        }
+        if (layer->type != L_LAYER) continue;
+
+        RaylibTMXLayerCache *cache = GetTMXLayerCache(map, state, layer);
+        if (cache->unbaked) continue;
+        int minX, minY, maxX, maxY;
+        GetTMXLayerCellRange(map, posX + layer->offsetx, posY + layer->offsety, bounds, &minX, &minY, &maxX, &maxY);
+        if (minX == maxX || minY == maxY) continue;
+        for (int chunkY = minY / RAYLIB_TMX_CHUNK_SIZE; chunkY <= (maxY - 1) / RAYLIB_TMX_CHUNK_SIZE; chunkY++) {
+            for (int chunkX = minX / RAYLIB_TMX_CHUNK_SIZE; chunkX <= (maxX - 1) / RAYLIB_TMX_CHUNK_SIZE; chunkX++) {
+                int index = chunkY * cache->chunksX + chunkX;
+                if (cache->chunks[index].id == 0 || cache->dirty[index]) {
+                    BakeTMXLayerChunk(map, state, cache, chunkX, chunkY);
+                }
+                UseTMXCacheChunk(state, cache, index);
+            }
+        }
+    }
+}
+
+/**
+ * Bake the collisions of the chunks of tile layers that overlap the bounds.
+ *
+ * @internal
+ */
+void StreamTMXColliders(tmx_map *map, RaylibTMXState *state, Rectangle bounds) {
+    if (!state->indexLoaded) return;
+    EvictTMXColliderChunks(state);
+    for (RaylibTMXLayerColliders *colliders = state->layerColliders; colliders != NULL; colliders = colliders->next) {
+        if (!colliders->layer->visible || colliders->layer->type != L_LAYER) continue;
+        int minX, minY, maxX, maxY;
+        GetTMXLayerCellRange(map, 0, 0, bounds, &minX, &minY, &maxX, &maxY);
+        if (minX == maxX || minY == maxY) continue;
+        for (int chunkY = minY / RAYLIB_TMX_CHUNK_SIZE; chunkY <= (maxY - 1) / RAYLIB_TMX_CHUNK_SIZE; chunkY++) {
+            for (int chunkX = minX / RAYLIB_TMX_CHUNK_SIZE; chunkX <= (maxX - 1) / RAYLIB_TMX_CHUNK_SIZE; chunkX++) {
+                GetTMXColliderChunk(map, state, colliders, chunkX, chunkY);
+            }
+        }
+    }
+}
+
+/**
+ * Bake the chunks around the camera ahead of drawing them, along with their collisions.
+ *
+ * Pass bounds larger than the view, for example GetTMXViewBounds() grown by a chunk on each side,
+ * so chunks are ready before they scroll into view. Chunks outside the bounds are the first to be
+ * unloaded once the cache exceeds its budget. The collisions of the chunks are baked even when the
+ * map isn't cached, so that the first queries around the camera don't have to.
+ *
+ * @param map The map that is cached with EnableTMXCache().
+ * @param bounds The area to bake, in map coordinates.
+ *
+ * @see SetTMXCacheBudget()
+ */
+void StreamTMXCache(tmx_map *map, Rectangle bounds) {
+    RaylibTMXState *state = GetTMXState(map, false);
+    if (state == NULL || map->ly_head == NULL) return;
+    StreamTMXColliders(map, state, bounds);
+    if (!state->cacheEnabled || !IsTMXOrthogonal(map)) return;
+    StreamTMXLayers(map, state, map->ly_head, 0, 0, bounds);
+}
+
+/**
+ * Stop using the baked tile layer chunks of the given map, and unload them.
+ *
+ * @param map The map that was cached with EnableTMXCache().
+ */
+void DisableTMXCache(tmx_map *map) {
+    RaylibTMXState *state = GetTMXState(map, false);
+    if (state == NULL) return;
+    UnloadTMXLayerCaches(state);
+    state->cacheEnabled = false;
+}
+
+/**
+ * Add a quad for a tile cell to the batch of its texture.
+ *
+ * Flipped tiles are handled by permuting the texture coordinates of the quad corners, in the same
+ * way the rotations of DrawTMXTile() place them.
+ *
+ * @internal
+ */
+void AddTMXMeshQuad(RaylibTMXMeshRegion *region, tmx_tile *tile, unsigned int baseGid, float posX, float posY) {
+    Texture2D *texture = GetTMXTileTexture(tile);
+    if (texture == NULL || texture->width == 0 || texture->height == 0) return;
+
+    RaylibTMXMeshBatch *batch = NULL;
+    for (int i = 0; i < region->batchCount; i++) {
+        if (region->batches[i].texture == texture) {
+            batch = &region->batches[i];
+            break;
+        }
+    }
+    if (batch == NULL) {
+        region->batches = (RaylibTMXMeshBatch *)MemRealloc(region->batches, (unsigned int)(region->batchCount + 1) * sizeof(RaylibTMXMeshBatch));
+        batch = &region->batches[region->batchCount++];
+        *batch = (RaylibTMXMeshBatch){0};
+        batch->texture = texture;
+    }
+    if (batch->quadCount == batch->quadCapacity) {
+        batch->quadCapacity = (batch->quadCapacity == 0) ? 64 : batch->quadCapacity * 2;
+        batch->vertices = (float *)MemRealloc(batch->vertices, (unsigned int)batch->quadCapacity * 8 * sizeof(float));
+        batch->texcoords = (float *)MemRealloc(batch->texcoords, (unsigned int)batch->quadCapacity * 8 * sizeof(float));
+    }
+
+    float width = (float)tile->width;
+    float height = (float)tile->height;
+    float u[2] = {(float)tile->ul_x / (float)texture->width, ((float)tile->ul_x + width) / (float)texture->width};
+    float v[2] = {(float)tile->ul_y / (float)texture->height, ((float)tile->ul_y + height) / (float)texture->height};
+
+    // Diagonally flipped tiles are rotated around their center, which swaps their extents.
+    Rectangle dest = {posX, posY, width, height};
+    if (baseGid & TMX_FLIPPED_DIAGONALLY) {
+        dest = (Rectangle){posX + (width - height) / 2.0f, posY + (height - width) / 2.0f, height, width};
+    }
+
+    // Corners in the order rlgl expects quads: top-left, bottom-left, bottom-right, top-right.
+    const int corners[4][2] = {{0, 0}, {0, 1}, {1, 1}, {1, 0}};
+    float *vertices = &batch->vertices[batch->quadCount * 8];
+    float *texcoords = &batch->texcoords[batch->quadCount * 8];
+    for (int i = 0; i < 4; i++) {
+        int cornerX = corners[i][0];
+        int cornerY = corners[i][1];
+        vertices[i * 2] = dest.x + (float)cornerX * dest.width;
+        vertices[i * 2 + 1] = dest.y + (float)cornerY * dest.height;
+
+        // Tiled applies the diagonal flip first, then the horizontal and vertical flips.
+        int sourceX = (baseGid & TMX_FLIPPED_HORIZONTALLY) ? 1 - cornerX : cornerX;
+        int sourceY = (baseGid & TMX_FLIPPED_VERTICALLY) ? 1 - cornerY : cornerY;
+        if (baseGid & TMX_FLIPPED_DIAGONALLY) {
+            int swap = sourceX;
+            sourceX = sourceY;
+            sourceY = swap;
+        }
+        texcoords[i * 2] = u[sourceX];
+        texcoords[i * 2 + 1] = v[sourceY];
+    }
+    batch->quadCount++;
+}
+
+/**
+ * Build the vertex batches for one region of a layer mesh.
+ *
+ * @internal
+ */
+void BuildTMXMeshRegion(tmx_map *map, RaylibTMXLayerMesh *mesh, int regionX, int regionY) {
+    RaylibTMXMeshRegion *region = &mesh->regions[regionY * mesh->regionsX + regionX];
+    UnloadTMXMeshRegion(region);
+
+    int startX = regionX * RAYLIB_TMX_CHUNK_SIZE;
+    int startY = regionY * RAYLIB_TMX_CHUNK_SIZE;
+    int endX = (startX + RAYLIB_TMX_CHUNK_SIZE < (int)map->width) ? startX + RAYLIB_TMX_CHUNK_SIZE : (int)map->width;
+    int endY = (startY + RAYLIB_TMX_CHUNK_SIZE < (int)map->height) ? startY + RAYLIB_TMX_CHUNK_SIZE : (int)map->height;
+
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            int cellIndex = (y * (int)map->width) + x;
+            unsigned int baseGid = mesh->layer->content.gids[cellIndex];
+            tmx_tile *tile = map->tiles[baseGid & TMX_FLIP_BITS_REMOVAL];
+            if (!tile) continue;
+            if (!IsTMXTileInsideCell(map, tile, baseGid)) region->overlapping = true;
+
+            if (tile->animation) {
+                region->animatedCells = (int *)MemRealloc(region->animatedCells, (unsigned int)(region->animatedCount + 1) * sizeof(int));
+                region->animatedCells[region->animatedCount++] = cellIndex;
+                continue;
+            }
+
+            AddTMXMeshQuad(region, tile, baseGid, (float)(x * (int)map->tile_width), (float)(y * (int)map->tile_height));
+        }
+    }
+}
+
+/**
+ * Build vertex batches for the given tile layer, so it is drawn with a few rlgl batches per frame.
+ *
+ * The layer is split into regions of RAYLIB_TMX_CHUNK_SIZE by RAYLIB_TMX_CHUNK_SIZE cells, each
+ * holding one contiguous vertex and texture coordinate buffer per tileset texture. Once built, the
+ * layer is drawn from the batches of its visible regions instead of tile by tile. Building again
+ * replaces the previous batches. Only layers of orthogonal maps are meshed. As the batches don't
+ * keep the render order, layers holding tiles that reach out of their cell keep being drawn tile by
+ * tile, so that overlapping tiles stack the same way.
+ *
+ * @param map The map that holds the layer.
+ * @param layer The tile layer to build the batches of.
+ *
+ * @see UnloadTMXLayerMesh()
+ * @see InvalidateTMXCache()
+ */
+void BuildTMXLayerMesh(tmx_map *map, tmx_layer *layer) {
+    if (map == NULL || layer == NULL || layer->type != L_LAYER || !IsTMXOrthogonal(map)) return;
+    UnloadTMXLayerMesh(map, layer);
+
+    RaylibTMXState *state = GetTMXState(map, true);
+    RaylibTMXLayerMesh *mesh = (RaylibTMXLayerMesh *)MemAlloc(sizeof(RaylibTMXLayerMesh));
+    mesh->layer = layer;
+    mesh->regionsX = ((int)map->width + RAYLIB_TMX_CHUNK_SIZE - 1) / RAYLIB_TMX_CHUNK_SIZE;
+    mesh->regionsY = ((int)map->height + RAYLIB_TMX_CHUNK_SIZE - 1) / RAYLIB_TMX_CHUNK_SIZE;
+    mesh->regions = (RaylibTMXMeshRegion *)MemAlloc((unsigned int)(mesh->regionsX * mesh->regionsY) * sizeof(RaylibTMXMeshRegion));
+    for (int regionY = 0; regionY < mesh->regionsY; regionY++) {
+        for (int regionX = 0; regionX < mesh->regionsX; regionX++) {
+            BuildTMXMeshRegion(map, mesh, regionX, regionY);
+        }
+    }
+
+    mesh->next = state->layerMeshes;
+    state->layerMeshes = mesh;
+}
+
+/**
+ * Unload the vertex batches of the given tile layer, so it is drawn tile by tile again.
+ *
+ * @param map The map that holds the layer.
+ * @param layer The tile layer built with BuildTMXLayerMesh().
+ */
+void UnloadTMXLayerMesh(tmx_map *map, tmx_layer *layer) {
+    RaylibTMXState *state = GetTMXState(map, false);
+    if (state == NULL) return;
+
+    RaylibTMXLayerMesh **link = &state->layerMeshes;
+    while (*link) {
+        RaylibTMXLayerMesh *mesh = *link;
+        if (mesh->layer == layer) {
+            *link = mesh->next;
+            UnloadTMXMesh(mesh);
+            return;
+        }
+        link = &mesh->next;
+    }
+}
+
+/**
+ * Submit the batches of a mesh region to rlgl.
+ *
+ * @internal
+ */
+void DrawTMXMeshRegion(RaylibTMXMeshRegion *region, float posX, float posY, Color tint) {
+    for (int i = 0; i < region->batchCount; i++) {
+        RaylibTMXMeshBatch *batch = &region->batches[i];
+        RAYLIB_TMX_STAT(tilesDrawn, batch->quadCount);
+        RAYLIB_TMX_STAT_TEXTURE(batch->texture->id);
+        rlSetTexture(batch->texture->id);
+        for (int first = 0; first < batch->quadCount; first += RAYLIB_TMX_MESH_BATCH_QUADS) {
+            int count = batch->quadCount - first;
+            if (count > RAYLIB_TMX_MESH_BATCH_QUADS) count = RAYLIB_TMX_MESH_BATCH_QUADS;
+
+            // Flush the current batch up front when the quads would not fit in it.
+            rlCheckRenderBatchLimit(count * 4);
+            rlBegin(RL_QUADS);
+            rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            const float *vertices = &batch->vertices[first * 8];
+            const float *texcoords = &batch->texcoords[first * 8];
+            for (int vertex = 0; vertex < count * 4; vertex++) {
+                rlTexCoord2f(texcoords[vertex * 2], texcoords[vertex * 2 + 1]);
+                rlVertex2f(posX + vertices[vertex * 2], posY + vertices[vertex * 2 + 1]);
+            }
+            rlEnd();
+        }
+    }
+    rlSetTexture(0);
+}
+
+/**
+ * Render a tile layer through the batches of its visible mesh regions.
+ *
+ * @return True when the layer has a mesh and was drawn.
+ *
+ * @internal
+ */
+bool DrawTMXLayerMesh(tmx_map *map, RaylibTMXState *state, tmx_layer *layer, int posX, int posY, Rectangle bounds, Color tint) {
+    RaylibTMXLayerMesh *mesh = state->layerMeshes;
+    while (mesh && mesh->layer != layer) mesh = mesh->next;
+    if (mesh == NULL) return false;
+
+    // Overlapping tiles anywhere in the layer may reach into the view, so check every region.
+    for (int regionY = 0; regionY < mesh->regionsY; regionY++) {
+        for (int regionX = 0; regionX < mesh->regionsX; regionX++) {
+            RaylibTMXMeshRegion *region = &mesh->regions[regionY * mesh->regionsX + regionX];
+            if (region->dirty) BuildTMXMeshRegion(map, mesh, regionX, regionY);
+            if (region->overlapping) return false;
+        }
+    }
+
+    int minX, minY, maxX, maxY;
+    GetTMXLayerCellRange(map, posX, posY, bounds, &minX, &minY, &maxX, &maxY);
+    if (minX == maxX || minY == maxY) return true;
+
+    Color newTint = ColorAlpha(tint, (float)layer->opacity);
+    LoadTMXTables(map);
+    for (int regionY = minY / RAYLIB_TMX_CHUNK_SIZE; regionY <= (maxY - 1) / RAYLIB_TMX_CHUNK_SIZE; regionY++) {
+        for (int regionX = minX / RAYLIB_TMX_CHUNK_SIZE; regionX <= (maxX - 1) / RAYLIB_TMX_CHUNK_SIZE; regionX++) {
+            RaylibTMXMeshRegion *region = &mesh->regions[regionY * mesh->regionsX + regionX];
+            RAYLIB_TMX_STAT(chunksDrawn, 1);
+            DrawTMXMeshRegion(region, (float)posX, (float)posY, newTint);
+
+            for (int i = 0; i < region->animatedCount; i++) {
+                int cellIndex = region->animatedCells[i];
+                unsigned int baseGid = layer->content.gids[cellIndex];
+                tmx_tile *tile = state->animationFrames[baseGid & TMX_FLIP_BITS_REMOVAL];
+                RAYLIB_TMX_STAT(tilesDrawn, 1);
+                int drawX = posX + (cellIndex % (int)map->width) * (int)map->tile_width;
+                int drawY = posY + (cellIndex / (int)map->width) * (int)map->tile_height;
+                DrawTMXTile(tile, baseGid, drawX, drawY, newTint);
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Find the index of a texture in the map's texture table, adding it when it's not there yet.
+ *
+ * @return The index of the texture plus one.
+ *
+ * @internal
+ */
+unsigned short GetTMXTextureIndex(RaylibTMXState *state, Texture2D *texture) {
+    for (int i = 0; i < state->textureCount; i++) {
+        if (state->textures[i] == texture) return (unsigned short)(i + 1);
+    }
+    state->textures = (Texture2D **)MemRealloc(state->textures, (unsigned int)(state->textureCount + 1) * sizeof(Texture2D *));
+    state->textures[state->textureCount++] = texture;
+    return (unsigned short)state->textureCount;
+}
+
+/**
+ * Decode the GID of a single cell into its draw record, the same way DrawTMXTile() does.
+ *
+ * @internal
+ */
+void CompileTMXCell(tmx_map *map, RaylibTMXState *state, RaylibTMXCompiledLayer *compiled, int cellIndex) {
+    unsigned int baseGid = compiled->layer->content.gids[cellIndex];
+    tmx_tile *tile = map->tiles[baseGid & TMX_FLIP_BITS_REMOVAL];
+    Texture2D *texture = tile ? GetTMXTileTexture(tile) : NULL;
+
+    compiled->texture[cellIndex] = 0;
+    compiled->rotation[cellIndex] = RAYLIB_TMX_ROTATE_NONE;
+    compiled->offset[cellIndex] = (Vector2){0.0f, 0.0f};
+    if (texture == NULL) return;
+
+    compiled->texture[cellIndex] = GetTMXTextureIndex(state, texture);
+    if (tile->animation) {
+        compiled->rotation[cellIndex] = RAYLIB_TMX_ROTATE_ANIMATED;
+        return;
+    }
+
+    Rectangle source = {
+        (float)tile->ul_x,
+        (float)tile->ul_y,
+        (float)tile->width,
+        (float)tile->height
+    };
+    unsigned char rotation = RAYLIB_TMX_ROTATE_NONE;
+    bool horizontal = (baseGid & TMX_FLIPPED_HORIZONTALLY) != 0;
+    bool vertical = (baseGid & TMX_FLIPPED_VERTICALLY) != 0;
+
+    if (baseGid & TMX_FLIPPED_DIAGONALLY) {
+        if (horizontal && vertical) {
+            source.height = -source.height;
+            rotation = RAYLIB_TMX_ROTATE_270;
+        } else if (horizontal) {
+            rotation = RAYLIB_TMX_ROTATE_90;
+        } else if (vertical) {
+            rotation = RAYLIB_TMX_ROTATE_270;
+        } else {
+            source.height = -source.height;
+            rotation = RAYLIB_TMX_ROTATE_MINUS_270;
+        }
+        // Rotated tiles are placed by their center.
+        compiled->offset[cellIndex] = (Vector2){fabsf(source.width) * 0.5f, fabsf(source.height) * 0.5f};
+    } else {
+        if (horizontal) source.width = -source.width;
+        if (vertical) source.height = -source.height;
+    }
+
+    compiled->source[cellIndex] = source;
+    compiled->rotation[cellIndex] = rotation;
+}
+
+/**
+ * Precompute the draw records of every cell in the tile layers of the given map.
+ *
+ * Each cell gets its texture, source rectangle, rotation and destination offset decoded once, stored
+ * as packed arrays. Drawing the layers then skips the GID decoding done by DrawTMXTile(). Call this
+ * right after LoadTMX(); calling it again recompiles every layer. Only orthogonal maps are compiled.
+ *
+ * @param map The map to compile.
+ *
+ * @see InvalidateTMXCache()
+ */
+void CompileTMX(tmx_map *map) {
+    if (map == NULL || !IsTMXOrthogonal(map)) return;
+    RaylibTMXState *state = GetTMXState(map, true);
+    UnloadTMXCompiledLayers(state);
+
+    // Walk the layers, including the ones nested in groups, with an explicit stack.
+    tmx_layer *stack[64];
+    int depth = 0;
+    tmx_layer *layer = map->ly_head;
+    while (layer || depth > 0) {
+        if (layer == NULL) {
+            layer = stack[--depth];
+            continue;
+        }
+        if (layer->type == L_GROUP && depth < 64) {
+            stack[depth++] = layer->next;
+            layer = layer->content.group_head;
+            continue;
+        }
+        if (layer->type == L_LAYER) {
+            unsigned int cells = map->width * map->height;
+            RaylibTMXCompiledLayer *compiled = (RaylibTMXCompiledLayer *)MemAlloc(sizeof(RaylibTMXCompiledLayer));
+            compiled->layer = layer;
+            compiled->texture = (unsigned short *)MemAlloc(cells * sizeof(unsigned short));
+            compiled->rotation = (unsigned char *)MemAlloc(cells * sizeof(unsigned char));
+            compiled->source = (Rectangle *)MemAlloc(cells * sizeof(Rectangle));
+            compiled->offset = (Vector2 *)MemAlloc(cells * sizeof(Vector2));
+            for (unsigned int i = 0; i < cells; i++) {
+                CompileTMXCell(map, state, compiled, (int)i);
+            }
+            compiled->next = state->compiledLayers;
+            state->compiledLayers = compiled;
+        }
+        layer = layer->next;
+    }
+}
+
+/**
+ * Check whether a tile is solid, from its collisions or from the property chosen with SetTMXSolidProperty().
+ *
+ * @internal
+ */
+bool IsTMXTileBlocking(tmx_map *map, tmx_tile *tile, const char *property) {
+    if (tile == NULL) return false;
+    if (property == NULL) return tile->collision != NULL;
+    tmx_property *value = GetTMXTileProperty(map, tile, property);
+    if (value == NULL) return false;
+    if (value->type == PT_BOOL) return value->value.boolean != 0;
+    if (value->type == PT_INT) return value->value.integer != 0;
+    return false;
+}
+
+/**
+ * Set or clear the bit of a cell in a solid mask.
+ *
+ * @internal
+ */
+void SetTMXSolidMaskCell(RaylibTMXSolidMask *mask, int x, int y, bool solid) {
+    uint64_t *word = &mask->bits[y * mask->stride + (x >> 6)];
+    uint64_t bit = (uint64_t)1 << (x & 63);
+    *word = solid ? (*word | bit) : (*word & ~bit);
+}
+
+/**
+ * Check the bit of a cell in a solid mask. Cells outside of the map are never solid.
+ *
+ * @internal
+ */
+bool IsTMXSolidMaskCell(const RaylibTMXSolidMask *mask, int x, int y) {
+    if (x < 0 || y < 0 || x >= mask->width || y >= mask->height) return false;
+    return (mask->bits[y * mask->stride + (x >> 6)] >> (x & 63)) & 1;
+}
+
+/**
+ * Allocate an empty solid mask covering the map.
+ *
+ * @internal
+ */
+RaylibTMXSolidMask *LoadTMXSolidMask(tmx_map *map, tmx_layer *layer) {
+    RaylibTMXSolidMask *mask = (RaylibTMXSolidMask *)MemAlloc(sizeof(RaylibTMXSolidMask));
+    mask->layer = layer;
+    mask->width = (int)map->width;
+    mask->height = (int)map->height;
+    mask->cellWidth = (float)map->tile_width;
+    mask->cellHeight = (float)map->tile_height;
+    mask->stride = (mask->width + 63) / 64;
+    mask->bits = (uint64_t *)MemAlloc((unsigned int)(mask->stride * mask->height + 1) * sizeof(uint64_t));
+    return mask;
+}
+
+/**
+ * Build the solid masks of the given tile layers, and of the tile layers in their groups.
+ *
+ * @return Where to link the next mask.
+ *
+ * @internal
+ */
+RaylibTMXSolidMask **LoadTMXLayerSolidMasks(tmx_map *map, RaylibTMXState *state, tmx_layer *layer, bool visible, RaylibTMXSolidMask **link) {
+    RaylibTMXSolidMask *any = state->solidMasks;
+    for (; layer != NULL; layer = layer->next) {
+        if (layer->type == L_GROUP) {
+            link = LoadTMXLayerSolidMasks(map, state, layer->content.group_head, visible && layer->visible, link);
+            continue;
+        }
+        if (layer->type != L_LAYER) continue;
+        RaylibTMXSolidMask *mask = LoadTMXSolidMask(map, layer);
+        mask->combined = visible && layer->visible;
+        for (int y = 0; y < mask->height; y++) {
+            for (int x = 0; x < mask->width; x++) {
+                unsigned int gid = layer->content.gids[(y * mask->width) + x] & TMX_FLIP_BITS_REMOVAL;
+                if (gid >= map->tilecount || !state->solidTiles[gid]) continue;
+                SetTMXSolidMaskCell(mask, x, y, true);
+                if (mask->combined) SetTMXSolidMaskCell(any, x, y, true);
+            }
+        }
+        *link = mask;
+        link = &mask->next;
+    }
+    return link;
+}
+
+/**
+ * Build the solid masks of the map's tile layers, and the mask of the cells solid in any visible one.
+ *
+ * @internal
+ */
+void LoadTMXSolidMasks(tmx_map *map, RaylibTMXState *state) {
+    state->solidTiles = (unsigned char *)MemAlloc(map->tilecount + 1);
+    for (unsigned int gid = 0; gid < map->tilecount; gid++) {
+        state->solidTiles[gid] = IsTMXTileBlocking(map, map->tiles[gid], state->solidProperty);
+    }
+
+    state->solidMasks = LoadTMXSolidMask(map, NULL);
+    LoadTMXLayerSolidMasks(map, state, map->ly_head, true, &state->solidMasks->next);
+}
+
+/**
+ * Update the solid masks after the tile of a cell changed.
+ *
+ * @internal
+ */
+void UpdateTMXSolidCell(tmx_map *map, RaylibTMXState *state, tmx_layer *layer, int x, int y) {
+    RaylibTMXSolidMask *any = state->solidMasks;
+    bool solid = false;
+    for (RaylibTMXSolidMask *mask = any->next; mask != NULL; mask = mask->next) {
+        if (mask->layer == layer) {
+            unsigned int gid = layer->content.gids[(y * mask->width) + x] & TMX_FLIP_BITS_REMOVAL;
+            SetTMXSolidMaskCell(mask, x, y, gid < map->tilecount && state->solidTiles[gid]);
+        }
+        if (mask->combined && IsTMXSolidMaskCell(mask, x, y)) solid = true;
+    }
+    SetTMXSolidMaskCell(any, x, y, solid);
+
+    // The cluster of the cell is built again, along with its neighbors when the cell is on a border.
+    RaylibTMXPathGraph *graph = state->pathGraph;
+    if (graph == NULL) return;
+    int clusterX = x / RAYLIB_TMX_PATH_CLUSTER_SIZE;
+    int clusterY = y / RAYLIB_TMX_PATH_CLUSTER_SIZE;
+    int localX = x - clusterX * RAYLIB_TMX_PATH_CLUSTER_SIZE;
+    int localY = y - clusterY * RAYLIB_TMX_PATH_CLUSTER_SIZE;
+    graph->clusters[clusterY * graph->clustersX + clusterX].dirty = true;
+    if (localX == 0 && clusterX > 0) graph->clusters[clusterY * graph->clustersX + clusterX - 1].dirty = true;
+    if (localX == RAYLIB_TMX_PATH_CLUSTER_SIZE - 1 && clusterX + 1 < graph->clustersX) graph->clusters[clusterY * graph->clustersX + clusterX + 1].dirty = true;
+    if (localY == 0 && clusterY > 0) graph->clusters[(clusterY - 1) * graph->clustersX + clusterX].dirty = true;
+    if (localY == RAYLIB_TMX_PATH_CLUSTER_SIZE - 1 && clusterY + 1 < graph->clustersY) graph->clusters[(clusterY + 1) * graph->clustersX + clusterX].dirty = true;
+    graph->dirty = true;
+}
+
+/**
+ * Mark the baked chunk, the mesh region and the baked collisions that hold the given cell, so that
+ * they are built again when next used. The compiled draw record and the solid bits of the cell are
+ * updated right away.
+ *
+ * Call this after changing the GIDs of a cached, meshed or compiled tile layer, which SetTMXTile()
+ * does. Placing a tile that can't be baked, such as an animated one, in a baked layer unloads its
+ * chunks.
+ *
+ * @param map The map that holds the layer.
+ * @param layer The tile layer that was changed.
+ * @param x The column of the changed cell.
+ * @param y The row of the changed cell.
+ */
+void InvalidateTMXCache(tmx_map *map, tmx_layer *layer, int x, int y) {
+    RaylibTMXState *state = GetTMXState(map, false);
+    if (state == NULL || x < 0 || y < 0 || x >= (int)map->width || y >= (int)map->height) return;
+
+    int chunkX = x / RAYLIB_TMX_CHUNK_SIZE;
+    int chunkY = y / RAYLIB_TMX_CHUNK_SIZE;
+    for (RaylibTMXLayerCache *cache = state->layerCaches; cache != NULL; cache = cache->next) {
+        if (cache->layer != layer) continue;
+        if (cache->unbaked) break;
+
+        // A tile that can't be baked sends the whole layer back to being drawn tile by tile.
+        if (!IsTMXCellBakeable(map, state, layer->content.gids[(y * (int)map->width) + x])) {
+            rlDrawRenderBatchActive();
+            for (int i = 0; i < cache->chunksX * cache->chunksY; i++) UnloadTMXCacheChunk(state, cache, i);
+            MemFree(cache->chunks);
+            MemFree(cache->dirty);
+            MemFree(cache->entries);
+            cache->chunks = NULL;
+            cache->dirty = NULL;
+            cache->entries = NULL;
+            cache->unbaked = true;
+            break;
+        }
+        cache->dirty[chunkY * cache->chunksX + chunkX] = true;
+        break;
+    }
+    for (RaylibTMXLayerMesh *mesh = state->layerMeshes; mesh != NULL; mesh = mesh->next) {
+        if (mesh->layer != layer) continue;
+        mesh->regions[chunkY * mesh->regionsX + chunkX].dirty = true;
+        break;
+    }
+    for (RaylibTMXCompiledLayer *compiled = state->compiledLayers; compiled != NULL; compiled = compiled->next) {
+        if (compiled->layer != layer) continue;
+        CompileTMXCell(map, state, compiled, (y * (int)map->width) + x);
+        break;
+    }
+    for (RaylibTMXLayerColliders *colliders = state->layerColliders; colliders != NULL; colliders = colliders->next) {
+        if (colliders->layer != layer) continue;
+        colliders->blocks[chunkY * colliders->chunksX + chunkX].dirty = true;
+        break;
+    }
+    if (state->solidMasks) UpdateTMXSolidCell(map, state, layer, x, y);
+}
+
+/**
+ * Change the tile of a cell of a tile layer, keeping the data built from the layer up to date.
+ *
+ * Only the baked chunk, the mesh region and the baked collisions holding the cell are built again,
+ * when next used, and the compiled draw record of the cell is updated right away. The animations are shared by every
+ * cell using a tile, so an animated tile starts on the frame its other cells are showing.
+ *
+ * @param map The map that holds the layer.
+ * @param layer The tile layer to change.
+ * @param x The column of the cell.
+ * @param y The row of the cell.
+ * @param gid The global ID of the new tile, with its flip flags, or 0 to clear the cell.
+ *
+ * @return True when the cell was changed, false when it's outside of the layer or the tile is unknown.
+ *
+ * @see SetTMXTiles()
+ */
+bool SetTMXTile(tmx_map *map, tmx_layer *layer, int x, int y, unsigned int gid) {
+    if (map == NULL || layer == NULL || layer->type != L_LAYER) return false;
+    if (x < 0 || y < 0 || x >= (int)map->width || y >= (int)map->height) return false;
+    unsigned int tileGid = gid & TMX_FLIP_BITS_REMOVAL;
+    if (tileGid != 0 && (tileGid >= map->tilecount || map->tiles[tileGid] == NULL)) return false;
+
+    unsigned int *cell = &layer->content.gids[(y * (int)map->width) + x];
+    if (*cell == gid) return true;
+    *cell = gid;
+    InvalidateTMXCache(map, layer, x, y);
+    return true;
+}
+
+/**
+ * Change the tiles of many cells of a tile layer at once.
+ *
+ * @param map The map that holds the layer.
+ * @param layer The tile layer to change.
+ * @param changes The cells to change, and their new global IDs.
+ * @param count The amount of changes.
+ *
+ * @return The amount of cells that were changed.
+ *
+ * @see SetTMXTile()
+ */
+int SetTMXTiles(tmx_map *map, tmx_layer *layer, const RaylibTMXTileChange *changes, int count) {
+    if (changes == NULL) return 0;
+    int changed = 0;
+    for (int i = 0; i < count; i++) {
+        changed += SetTMXTile(map, layer, changes[i].x, changes[i].y, changes[i].gid);
+    }
+    return changed;
+}
+
+/**
+ * Render a tile layer of an isometric map, visiting only the cells within the given bounds.
+ *
+ * Cells are walked along the diagonals of the map from the back to the front, so tiles taller than
+ * the grid overlap the ones behind them. Tiles are aligned to the bottom of their cell, like Tiled.
+ *
+ * @internal
+ */
+void DrawTMXIsometricTiles(tmx_map *map, tmx_layer *layer, int posX, int posY, Rectangle bounds, Color tint) {
+    float halfWidth = (float)map->tile_width / 2.0f;
+    float halfHeight = (float)map->tile_height / 2.0f;
+    float maxWidth, maxHeight;
+    GetTMXMaxTileSize(map, &maxWidth, &maxHeight);
+
+    // Each diagonal has a constant x + y, and each column of the screen a constant x - y.
+    float originX = (float)posX + (float)(map->height - 1) * halfWidth;
+    float bottom = (float)posY + (float)map->tile_height;
+    float minDiagonal = floorf((bounds.y - bottom) / halfHeight) + 1.0f;
+    float maxDiagonal = ceilf((bounds.y + bounds.height - bottom + maxHeight) / halfHeight) - 1.0f;
+    float minColumn = floorf((bounds.x - originX - maxWidth) / halfWidth) + 1.0f;
+    float maxColumn = ceilf((bounds.x + bounds.width - originX) / halfWidth) - 1.0f;
+    int startDiagonal = (int)fmaxf(minDiagonal, 0.0f);
+    int endDiagonal = (int)fminf(maxDiagonal, (float)(map->width + map->height - 2));
+    int startColumn = (int)fmaxf(minColumn, -(float)map->height);
+    int endColumn = (int)fminf(maxColumn, (float)map->width);
+
+    Color newTint = ColorAlpha(tint, (float)layer->opacity);
+    tmx_tile **animationFrames = GetTMXAnimationFrames(map);
+    for (int diagonal = startDiagonal; diagonal <= endDiagonal; diagonal++) {
+        int startX = (int)ceilf((float)(diagonal + startColumn) / 2.0f);
+        int endX = (int)floorf((float)(diagonal + endColumn) / 2.0f);
+        if (startX < diagonal - (int)map->height + 1) startX = diagonal - (int)map->height + 1;
+        if (startX < 0) startX = 0;
+        if (endX > diagonal) endX = diagonal;
+        if (endX > (int)map->width - 1) endX = (int)map->width - 1;
+
+        int cellBottom = posY + (diagonal + 2) * (int)map->tile_height / 2;
+        for (int x = startX; x <= endX; x++) {
+            int y = diagonal - x;
+            unsigned int baseGid = layer->content.gids[(y * (int)map->width) + x];
+            unsigned int gid = baseGid & TMX_FLIP_BITS_REMOVAL;
+            RAYLIB_TMX_STAT(cellsVisited, 1);
+            if (!map->tiles[gid]) {
+                RAYLIB_TMX_STAT(cellsSkipped, 1);
+                continue;
+            }
+            RAYLIB_TMX_STAT(tilesDrawn, 1);
+
+            tmx_tile *tile = map->tiles[gid];
+            if (tile->animation) tile = animationFrames[gid];
+            int drawX = (int)(originX + (float)(x - y) * halfWidth);
+            DrawTMXTile(tile, baseGid, drawX, cellBottom - (int)tile->height, newTint);
+        }
+    }
+}
+
+/**
+ * Render a tile layer of a staggered or hexagonal map, visiting only the cells within the given bounds.
+ *
+ * Every other row, or column, is shifted by half a cell. Staggered maps are hexagonal maps with
+ * sides of length zero, as in Tiled. When columns are staggered, the upper cells of a row are drawn
+ * before the lower ones.
+ *
+ * @internal
+ */
+void DrawTMXStaggeredTiles(tmx_map *map, tmx_layer *layer, int posX, int posY, Rectangle bounds, Color tint) {
+    bool staggerX = map->stagger_axis == SA_X;
+    int staggerIndex = (map->stagger_index == SI_EVEN) ? 0 : 1;
+    int tileWidth = (int)map->tile_width & ~1;
+    int tileHeight = (int)map->tile_height & ~1;
+    int sideLength = (map->orient == O_HEX) ? map->hexsidelength : 0;
+    int sideLengthX = staggerX ? sideLength : 0;
+    int sideLengthY = staggerX ? 0 : sideLength;
+    int columnWidth = (tileWidth - sideLengthX) / 2 + sideLengthX;
+    int rowHeight = (tileHeight - sideLengthY) / 2 + sideLengthY;
+    int stepX = staggerX ? columnWidth : tileWidth + sideLengthX;
+    int stepY = staggerX ? tileHeight + sideLengthY : rowHeight;
+    int shiftX = staggerX ? 0 : columnWidth;
+    int shiftY = staggerX ? rowHeight : 0;
+    float maxWidth, maxHeight;
+    GetTMXMaxTileSize(map, &maxWidth, &maxHeight);
+
+    // Widen the range by the shift, as either half of the cells may be the one reaching into the bounds.
+    float minX = floorf((bounds.x - (float)posX - maxWidth - (float)shiftX) / (float)stepX) + 1.0f;
+    float maxX = ceilf((bounds.x + bounds.width - (float)posX) / (float)stepX);
+    float minY = floorf((bounds.y - (float)posY - (float)tileHeight - (float)shiftY) / (float)stepY) + 1.0f;
+    float maxY = ceilf((bounds.y + bounds.height - (float)posY - (float)tileHeight + maxHeight) / (float)stepY);
+    int startX = (int)fminf(fmaxf(minX, 0.0f), (float)map->width);
+    int startY = (int)fminf(fmaxf(minY, 0.0f), (float)map->height);
+    int endX = (int)fminf(fmaxf(maxX, (float)startX), (float)map->width);
+    int endY = (int)fminf(fmaxf(maxY, (float)startY), (float)map->height);
+
+    Color newTint = ColorAlpha(tint, (float)layer->opacity);
+    tmx_tile **animationFrames = GetTMXAnimationFrames(map);
+    for (int y = startY; y < endY; y++) {
+        bool staggeredRow = !staggerX && ((y & 1) == staggerIndex);
+        for (int pass = 0; pass < (staggerX ? 2 : 1); pass++) {
+            for (int x = startX; x < endX; x++) {
+                bool staggeredColumn = staggerX && ((x & 1) == staggerIndex);
+                if (staggerX && staggeredColumn != (pass == 1)) continue;
+
+                unsigned int baseGid = layer->content.gids[(y * (int)map->width) + x];
+                unsigned int gid = baseGid & TMX_FLIP_BITS_REMOVAL;
+                RAYLIB_TMX_STAT(cellsVisited, 1);
+                if (!map->tiles[gid]) {
+                    RAYLIB_TMX_STAT(cellsSkipped, 1);
+                    continue;
+                }
+                RAYLIB_TMX_STAT(tilesDrawn, 1);
+
+                tmx_tile *tile = map->tiles[gid];
+                if (tile->animation) tile = animationFrames[gid];
+                int drawX = posX + x * stepX + (staggeredRow ? shiftX : 0);
+                int drawY = posY + y * stepY + (staggeredColumn ? shiftY : 0) + tileHeight - (int)tile->height;
+                DrawTMXTile(tile, baseGid, drawX, drawY, newTint);
+            }
+        }
+    }
+}
+
+/**
+ * @internal
+ */
+void DrawTMXLayerTiles(tmx_map *map, tmx_layer *layer, int posX, int posY, Rectangle bounds, Color tint) {
+    switch (map->orient) {
+        case O_ISO:
+            DrawTMXIsometricTiles(map, layer, posX, posY, bounds, tint);
+            return;
+        case O_STA:
+        case O_HEX:
+            DrawTMXStaggeredTiles(map, layer, posX, posY, bounds, tint);
+            return;
+        case O_ORT:
+        case O_NONE: break;
+    }
+
+    RaylibTMXState *state = GetTMXState(map, false);
+    if (state && state->cacheEnabled && DrawTMXLayerCached(map, state, layer, posX, posY, bounds, tint)) return;
+    if (state && DrawTMXLayerMesh(map, state, layer, posX, posY, bounds, tint)) return;
+
+    int minX, minY, maxX, maxY;
+    GetTMXLayerCellRange(map, posX, posY, bounds, &minX, &minY, &maxX, &maxY);
+    if (minX == maxX || minY == maxY) return;
+
+    int startX = minX, startY = minY;
+    int endX = maxX, endY = maxY;
+    int incX = 1, incY = 1;
+
+    switch (map->renderorder)
+    {
+        case R_RIGHTUP: {
+            startY = maxY - 1;
+            endY = minY - 1;
+            incY = -1;
+        } break;
+        case R_LEFTDOWN: {
+            startX = maxX - 1;
+            endX = minX - 1;
+            incX = -1;
+        }  break;
+        case R_LEFTUP: {
+            startX = maxX - 1;
+            startY = maxY - 1;
+            endX = minX - 1;
+            endY = minY - 1;
+            incX = -1;
+            incY = -1;
+        } break;
+        case R_RIGHTDOWN:
+        case R_NONE: break;
+    }
+
+    Color newTint = ColorAlpha(tint, (float)layer->opacity);
+    tmx_tile **animationFrames = GetTMXAnimationFrames(map);
+
+    RaylibTMXCompiledLayer *compiled = state ? state->compiledLayers : NULL;
+    while (compiled && compiled->layer != layer) compiled = compiled->next;
+    if (compiled) {
+        static const float rotations[4] = {0.0f, 90.0f, 270.0f, -270.0f};
+        Texture2D **textures = state->textures;
+        for (int y = startY; y != endY; y += incY) {
+            float cellY = (float)(posY + y * (int)map->tile_height);
+            for (int x = startX; x != endX; x += incX) {
+                int cellIndex = (y * (int)map->width) + x;
+                unsigned short texture = compiled->texture[cellIndex];
+                RAYLIB_TMX_STAT(cellsVisited, 1);
+                if (texture == 0) {
+                    RAYLIB_TMX_STAT(cellsSkipped, 1);
+                    continue;
+                }
+                RAYLIB_TMX_STAT(tilesDrawn, 1);
+
+                unsigned char rotation = compiled->rotation[cellIndex];
+                float cellX = (float)(posX + x * (int)map->tile_width);
+                if (rotation & RAYLIB_TMX_ROTATE_ANIMATED) {
+                    unsigned int baseGid = layer->content.gids[cellIndex];
+                    tmx_tile *tile = animationFrames[baseGid & TMX_FLIP_BITS_REMOVAL];
+                    DrawTMXTile(tile, baseGid, (int)cellX, (int)cellY, newTint);
+                    continue;
+                }
+
+                Rectangle source = compiled->source[cellIndex];
+                Vector2 offset = compiled->offset[cellIndex];
+                Rectangle dest = {cellX + offset.x, cellY + offset.y, fabsf(source.width), fabsf(source.height)};
+                DrawTMXTexturePro(textures[texture - 1], source, dest, offset, rotations[rotation], newTint);
+            }
+        }
+        return;
+    }
+
+    for (int y = startY; y != endY; y += incY) {
+        for (int x = startX; x != endX; x += incX) {
+            int cellIndex = (y * (int) map->width) + x;
+            unsigned int baseGid = layer->content.gids[cellIndex];
+            unsigned int gid = baseGid & TMX_FLIP_BITS_REMOVAL;
+
+            RAYLIB_TMX_STAT(cellsVisited, 1);
+            if (!map->tiles[gid]) {
+                RAYLIB_TMX_STAT(cellsSkipped, 1);
+                continue;
+            }
+            RAYLIB_TMX_STAT(tilesDrawn, 1);
+
+            tmx_tile* tile = map->tiles[gid];
+            if (tile->animation) tile = animationFrames[gid];
+
+            int drawX = posX + x * (int) map->tile_width;
+            int drawY = posY + y * (int) map->tile_height;
+            DrawTMXTile(tile, baseGid, drawX, drawY, newTint);
+        }
+    }
+}
+
+/**
+ * Render the given layer to the screen.
+ *
+ * @param map The TMX map that holds the layer.
+ * @param layer The layer to render on the screen.
+ * @param posX The X position of the screen.
+ * @param posY The Y position of the screen.
+ * @param tint How to tint the rendering of the layer.
+ */
+void DrawTMXLayer(tmx_map *map, tmx_layer *layer, int posX, int posY, Color tint) {
+    DrawTMXLayerEx(map, layer, posX, posY, RAYLIB_TMX_NO_BOUNDS, tint);
+}
+
+/**
+ * Render the given layer to the screen, only visiting the tiles that overlap the given bounds.
+ *
+ * @param map The TMX map that holds the layer.
+ * @param layer The layer to render on the screen.
+ * @param posX The X position of the layer.
+ * @param posY The Y position of the layer.
+ * @param bounds The visible area, in the same coordinate space as posX and posY.
+ * @param tint How to tint the rendering of the layer.
+ */
+void DrawTMXLayerEx(tmx_map *map, tmx_layer *layer, int posX, int posY, Rectangle bounds, Color tint) {
+#if defined(RAYLIB_TMX_STATS)
+    int cellsVisited = raylibTMXFrameStats.cellsVisited;
+    int drawn = CountTMXStatsDrawn();
+    double start = GetTime();
+#endif
+    switch (layer->type) {
+        case L_GROUP:
+            DrawTMXLayersEx(map, layer->content.group_head, posX + layer->offsetx, posY + layer->offsety, bounds, tint); // recursive call
+            break;
+        case L_OBJGR:
+            DrawTMXLayerObjects(map, layer->content.objgr, posX + layer->offsetx, posY + layer->offsety, bounds, tint);
+            break;
+        case L_IMAGE:
+            DrawTMXLayerImage(layer->content.image, posX + layer->offsetx, posY + layer->offsety, bounds, tint);
+            break;
+        case L_LAYER:
+            DrawTMXLayerTiles(map, layer, posX + layer->offsetx, posY + layer->offsety, bounds, tint);
+            break;
+        case L_NONE:
+            // Nothing.
+            break;
+    }
+#if defined(RAYLIB_TMX_STATS)
+    // Groups are left out, as their layers are counted on their own.
+    if (layer->type != L_GROUP) {
+        RecordTMXLayerStats(layer, raylibTMXFrameStats.cellsVisited - cellsVisited, CountTMXStatsDrawn() - drawn, (GetTime() - start) * 1000.0);
+    }
+#endif
+}
+
+/**
+ * Draws all of the given TMX map layers to the screen.
+ *
+ * @param map The TMX map that holds the layer.
+ * @param layers The layer to render on the screen.
+ * @param posX The X position of the screen.
+ * @param posY The Y position of the screen.
+ * @param tint How to tint the rendering of the layer.
+ */
+void DrawTMXLayers(tmx_map *map, tmx_layer *layers, int posX, int posY, Color tint) {
+    DrawTMXLayersEx(map, layers, posX, posY, RAYLIB_TMX_NO_BOUNDS, tint);
+}
+
+/**
+ * Draws all of the given TMX map layers to the screen, only visiting the tiles that overlap the given bounds.
+ *
+ * @param map The TMX map that holds the layer.
+ * @param layers The layer to render on the screen.
+ * @param posX The X position of the layers.
+ * @param posY The Y position of the layers.
+ * @param bounds The visible area, in the same coordinate space as posX and posY.
+ * @param tint How to tint the rendering of the layer.
+ */
+void DrawTMXLayersEx(tmx_map *map, tmx_layer *layers, int posX, int posY, Rectangle bounds, Color tint) {
+    do {
+		if (layers->visible) DrawTMXLayerEx(map, layers, posX, posY, bounds, tint);
+	} while ((layers = layers->next));
+}
+
+/**
+ * Fill the area covered by the map's cells with its background color.
+ *
+ * @internal
+ */
+void DrawTMXBackground(tmx_map *map, int posX, int posY) {
+    Color background = ColorFromTMX(map->backgroundcolor);
+    DrawRectangle(posX, posY, (int)(map->width * map->tile_width), (int)(map->height * map->tile_height), background);
+}
+
+/**
+ * Render the given map to the screen.
+ *
+ * Unless the application calls UpdateTMXAnimations(), this advances the map's animations by the
+ * time passed since they were last advanced, so drawing the map several times per frame is fine.
+ *
+ * @param map The TMX map to render to the screen.
+ * @param posX The X position of the screen.
+ * @param posY The Y position of the screen.
+ * @param tint How to tint the rendering of the layer.
+ */
+void DrawTMX(tmx_map *map, int posX, int posY, Color tint) {
+    RaylibTMXState *state = LoadTMXTables(map);
+    AdvanceTMXAnimationsOnDraw(map, state);
+
+    // TODO: Apply the tint to the background color.
+    DrawTMXBackground(map, posX, posY);
+	DrawTMXLayers(map, map->ly_head, posX, posY, tint);
+}
+
+/**
+ * Get the area of the world that a camera sees through the given screen viewport.
+ *
+ * @param camera The camera used to render the world.
+ * @param viewport The area of the screen that is being rendered to.
+ *
+ * @return The world-space bounding rectangle of the viewport, taking rotation and zoom into account.
+ */
+Rectangle GetTMXViewBounds(Camera2D camera, Rectangle viewport) {
+    Vector2 corners[4] = {
+        GetScreenToWorld2D((Vector2){viewport.x, viewport.y}, camera),
+        GetScreenToWorld2D((Vector2){viewport.x + viewport.width, viewport.y}, camera),
+        GetScreenToWorld2D((Vector2){viewport.x, viewport.y + viewport.height}, camera),
+        GetScreenToWorld2D((Vector2){viewport.x + viewport.width, viewport.y + viewport.height}, camera)
+    };
+
+    Vector2 min = corners[0];
+    Vector2 max = corners[0];
+    for (int i = 1; i < 4; i++) {
+        min.x = fminf(min.x, corners[i].x);
+        min.y = fminf(min.y, corners[i].y);
+        max.x = fmaxf(max.x, corners[i].x);
+        max.y = fmaxf(max.y, corners[i].y);
+    }
+
+    return (Rectangle){min.x, min.y, max.x - min.x, max.y - min.y};
+}
+
+/**
+ * Render the parts of the given map that are visible through a camera.
+ *
+ * Call this between BeginMode2D(camera) and EndMode2D(). The map is placed at the world origin, and
+ * only the cells that fall within the viewport are visited. Animations are advanced like DrawTMX().
+ *
+ * @param map The TMX map to render to the screen.
+ * @param camera The camera that is used to render the map.
+ * @param viewport The area of the screen the map is rendered to, usually the whole screen.
+ * @param tint How to tint the rendering of the layer.
+ */
+void DrawTMXEx(tmx_map *map, Camera2D camera, Rectangle viewport, Color tint) {
+    RaylibTMXState *state = LoadTMXTables(map);
+    AdvanceTMXAnimationsOnDraw(map, state);
+
+    Rectangle bounds = GetTMXViewBounds(camera, viewport);
+    DrawTMXBackground(map, 0, 0);
+    DrawTMXLayersEx(map, map->ly_head, 0, 0, bounds, tint);
+}
+
+/**
+ * Add the visible layers of the map, flattening its groups, to a draw list in the order they're drawn.
+ *
+ * @internal
+ */
+void AddTMXDrawListLayers(RaylibTMXDrawList *list, RaylibTMXState *state, tmx_layer *layer, int posX, int posY) {
+    for (; layer != NULL; layer = layer->next) {
+        if (!layer->visible) continue;
+        if (layer->type == L_GROUP) {
+            AddTMXDrawListLayers(list, state, layer->content.group_head, posX + layer->offsetx, posY + layer->offsety);
+            continue;
+        }
+
+        if (list->layerCount == list->layerCapacity) {
+            list->layerCapacity = (list->layerCapacity == 0) ? 16 : list->layerCapacity * 2;
+            list->layers = (RaylibTMXDrawLayer *)MemRealloc(list->layers, (unsigned int)list->layerCapacity * sizeof(RaylibTMXDrawLayer));
+        }
+        RaylibTMXDrawLayer *entry = &list->layers[list->layerCount++];
+        memset(entry, 0, sizeof(RaylibTMXDrawLayer));
+        entry->layer = layer;
+        entry->posX = posX;
+        entry->posY = posY;
+
+        // Baked chunks and meshes are drawn through OpenGL, so only the render thread may draw them.
+        RaylibTMXLayerMesh *mesh = state->layerMeshes;
+        while (mesh && mesh->layer != layer) mesh = mesh->next;
+        entry->recorded = layer->type == L_LAYER && mesh == NULL && !(state->cacheEnabled && IsTMXOrthogonal(list->map));
+    }
+}
+
+/**
+ * Record the draw commands of the layers of a draw list, taking the next layer until none are left.
+ *
+ * @internal
+ */
+void RunTMXDrawList(void *work) {
+    RaylibTMXDrawList *list = (RaylibTMXDrawList *)work;
+    for (;;) {
+        long index = RAYLIB_TMX_ATOMIC_INCREMENT(&list->nextLayer);
+        if (index >= list->layerCount) break;
+        RaylibTMXDrawLayer *entry = &list->layers[index];
+        if (!entry->recorded) continue;
+
+        raylibTMXRecorder = entry;
+#if defined(RAYLIB_TMX_STATS)
+        raylibTMXStatsTarget = &entry->stats;
+        double start = GetTime();
+#endif
+        tmx_layer *layer = entry->layer;
+        DrawTMXLayerTiles(list->map, layer, entry->posX + layer->offsetx, entry->posY + layer->offsety, list->bounds, list->tint);
+#if defined(RAYLIB_TMX_STATS)
+        entry->time = (GetTime() - start) * 1000.0;
+        raylibTMXStatsTarget = &raylibTMXFrameStats;
+#endif
+        raylibTMXRecorder = NULL;
+    }
+}
+
+/**
+ * Cull, decode and resolve the animations of the visible tiles of the map on worker threads.
+ *
+ * Each tile layer is recorded into its own command buffer, with the workers and the calling thread
+ * taking the next unrecorded layer until none are left. SubmitTMXDrawList() then draws the buffers
+ * in layer order on the render thread, which gives the same result as DrawTMXEx(). Object and image
+ * layers, and tile layers drawn from baked chunks or meshes, are drawn as usual when submitting.
+ *
+ * The map must not be changed between building the list and submitting it.
+ *
+ * @param map The map to draw.
+ * @param camera The camera used to render the world.
+ * @param viewport The area of the screen that is being rendered to.
+ * @param tint How to tint the rendering of the map.
+ * @param workers The amount of threads recording layers, including the calling thread.
+ *
+ * @return The draw list, to pass to SubmitTMXDrawList() and then UnloadTMXDrawList().
+ *
+ * @see SubmitTMXDrawList()
+ */
+RaylibTMXDrawList *BuildTMXDrawList(tmx_map *map, Camera2D camera, Rectangle viewport, Color tint, int workers) {
+    if (map == NULL) return NULL;
+    RaylibTMXState *state = LoadTMXTables(map);
+    AdvanceTMXAnimationsOnDraw(map, state);
+
+    RaylibTMXDrawList *list = (RaylibTMXDrawList *)MemAlloc(sizeof(RaylibTMXDrawList));
+    list->map = map;
+    list->bounds = GetTMXViewBounds(camera, viewport);
+    list->tint = tint;
+    AddTMXDrawListLayers(list, state, map->ly_head, 0, 0);
+
+    int recorded = 0;
+    for (int i = 0; i < list->layerCount; i++) recorded += list->layers[i].recorded;
+    if (workers > recorded) workers = recorded;
+
+    RunTMXWorkers(RunTMXDrawList, list, workers);
+
+    return list;
+}
+
+/**
+ * Draw a list built by BuildTMXDrawList(), on the render thread.
+ *
+ * @param list The draw list to draw. It can be submitted more than once.
+ *
+ * @see UnloadTMXDrawList()
+ */
+void SubmitTMXDrawList(RaylibTMXDrawList *list) {
+    if (list == NULL) return;
+    tmx_map *map = list->map;
+    DrawTMXBackground(map, 0, 0);
+
+    for (int i = 0; i < list->layerCount; i++) {
+        RaylibTMXDrawLayer *entry = &list->layers[i];
+        if (!entry->recorded) {
+            DrawTMXLayerEx(map, entry->layer, entry->posX, entry->posY, list->bounds, list->tint);
+            continue;
+        }
+
+        for (int c = 0; c < entry->commandCount; c++) {
+            RaylibTMXDrawCommand *command = &entry->commands[c];
+            RAYLIB_TMX_STAT_TEXTURE(command->texture->id);
+            DrawTexturePro(*command->texture, command->source, command->dest, command->origin, command->rotation, command->tint);
+        }
+#if defined(RAYLIB_TMX_STATS)
+        raylibTMXFrameStats.cellsVisited += entry->stats.cellsVisited;
+        raylibTMXFrameStats.cellsSkipped += entry->stats.cellsSkipped;
+        raylibTMXFrameStats.tilesDrawn += entry->stats.tilesDrawn;
+        RecordTMXLayerStats(entry->layer, entry->stats.cellsVisited, entry->stats.tilesDrawn, entry->time);
+#endif
+    }
+}
+
+/**
+ * Unload a draw list built by BuildTMXDrawList().
+ *
+ * @param list The draw list to unload.
+ */
+void UnloadTMXDrawList(RaylibTMXDrawList *list) {
+    if (list == NULL) return;
+    for (int i = 0; i < list->layerCount; i++) MemFree(list->layers[i].commands);
+    MemFree(list->layers);
+    MemFree(list);
+}
+
+/**
+ * Returns an RaylibTMXCollision shape relative to object type
+ *
+ * @param object  The object pointer which the collision will be returned.
+ */
+RaylibTMXCollision HandleTMXCollision(tmx_object* object) {
+    RaylibTMXCollision collision = {0};
+    switch (object->obj_type)
+    {
+	    case OT_SQUARE:
+	    case OT_TILE: {
+            collision.type = COLLISION_RECT;
+            collision.rect = (Rectangle) {
+                .x      = (float) object->x,
+                .y      = (float) object->y,
+                .width  = (float) object->width,
+                .height = (float) object->height
+            };
+	    } break;
+        case OT_POINT: {
+            collision.type  = COLLISION_POINT;
+            collision.point = (Vector2) {
+                .x = (float)object->x,
+                .y = (float)object->y
+            };
+        } break;
+        case OT_POLYLINE:
+        case OT_POLYGON: {
+            collision.type = (object->obj_type == OT_POLYGON) ? COLLISION_POLYGON : COLLISION_POLYLINE;
+            collision.polygon.points = object->content.shape->points;
+            collision.polygon.count  = object->content.shape->points_len;
+        } break;
+        case OT_ELLIPSE: {
+            collision.type = COLLISION_ELLIPSE;
+            collision.rect = (Rectangle) {
+                .x         = (float) (object->x + object->width  / 2.0f),
+                .y         = (float) (object->y + object->height / 2.0f),
+                .width     = (float) (object->width  / 2.0f),
+                .height    = (float) (object->height / 2.0f)
+            };
+        } break;
+        case OT_NONE:
+        case OT_TEXT: {
+            TraceLog(LOG_ERROR, "Unreachable: OT_TEXT and OT_NONE dont have collisions");
+            abort();
+        } break;
+    }
+    return collision;
+}
+
+/**
+ * An image to be packed into an atlas by PackTMXAtlas().
+ *
+ * @internal
+ */
+typedef struct RaylibTMXAtlasEntry {
+    RaylibTMXTexture *source;
+    Image image;                        // The pixels of the source, in R8G8B8A8
+    int atlas;                          // Index of the atlas the image was packed into, -1 if it didn't fit
+    int x, y;
+} RaylibTMXAtlasEntry;
+
+/**
+ * Sort atlas entries from the tallest to the shortest image, which keeps shelves tight.
+ *
+ * @internal
+ */
+int CompareTMXAtlasEntries(const void *a, const void *b) {
+    const RaylibTMXAtlasEntry *first = (const RaylibTMXAtlasEntry *)a;
+    const RaylibTMXAtlasEntry *second = (const RaylibTMXAtlasEntry *)b;
+    if (first->image.height != second->image.height) return second->image.height - first->image.height;
+    return second->image.width - first->image.width;
+}
+
+/**
+ * Add the texture behind the given image to the images to pack, once.
+ *
+ * @internal
+ */
+void AddTMXAtlasEntry(RaylibTMXAtlasEntry **entries, int *count, tmx_image *image) {
+    if (image == NULL || image->resource_image == NULL) return;
+    RaylibTMXTexture *source = (RaylibTMXTexture *)image->resource_image;
+    for (int i = 0; i < *count; i++) {
+        if ((*entries)[i].source == source) return;
+    }
+
+    RaylibTMXAtlasEntry entry = {source, {0}, -1, 0, 0};
+    if (source->image.data != NULL) {
+        entry.image = ImageCopy(source->image);
+    }
+    else if (source->texture.id > 0) {
+        entry.image = LoadImageFromTexture(source->texture);
+    }
+    if (entry.image.data != NULL) ImageFormat(&entry.image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    *entries = (RaylibTMXAtlasEntry *)MemRealloc(*entries, (unsigned int)(*count + 1) * sizeof(RaylibTMXAtlasEntry));
+    (*entries)[(*count)++] = entry;
+}
+
+/**
+ * Point the given image to its packed atlas, releasing its own texture.
+ *
+ * @return The offset of the image in the atlas.
+ *
+ * @internal
+ */
+Vector2 SwapTMXAtlasImage(RaylibTMXAtlasEntry *entry, RaylibTMXTexture **atlases, tmx_image *image) {
+    RaylibTMXTexture *atlas = atlases[entry->atlas];
+    atlas->refCount++;
+    UnloadTMXImage(image->resource_image);
+    image->resource_image = atlas;
+    return (Vector2){(float)entry->x, (float)entry->y};
+}
+
+/**
+ * Pack the images of image collection tilesets, and optionally small tileset sheets, into atlases.
+ *
+ * Tiles of image collection tilesets each have their own texture, so drawing them breaks batching
+ * on every tile. Once packed, tiles sharing an atlas are drawn in the same batch. The source
+ * rectangles of the tiles are moved into the atlases, and the original textures are released.
+ *
+ * Call this after loading the map, and before drawing it. Compiled layers and meshes are rebuilt.
+ *
+ * @param map The map to pack the images of.
+ * @param maxSheetSize Tileset sheets no wider or taller than this are packed too. 0 only packs image collections.
+ *
+ * @return The number of atlases created.
+ */
+int PackTMXAtlas(tmx_map *map, int maxSheetSize) {
+    if (map == NULL) return 0;
+
+    // Gather the images, along with their pixels.
+    RaylibTMXAtlasEntry *entries = NULL;
+    int entryCount = 0;
+    for (tmx_tileset_list *list = map->ts_head; list != NULL; list = list->next) {
+        tmx_tileset *tileset = list->tileset;
+        if (tileset->image != NULL) {
+            if ((int)tileset->image->width <= maxSheetSize && (int)tileset->image->height <= maxSheetSize) {
+                AddTMXAtlasEntry(&entries, &entryCount, tileset->image);
+            }
+            continue;
+        }
+        for (unsigned int i = 0; tileset->tiles != NULL && i < tileset->tilecount; i++) {
+            AddTMXAtlasEntry(&entries, &entryCount, tileset->tiles[i].image);
+        }
+    }
+    if (entryCount == 0) return 0;
+
+    // Place the images on shelves, tallest first, starting a new atlas when one fills up.
+    qsort(entries, (size_t)entryCount, sizeof(RaylibTMXAtlasEntry), CompareTMXAtlasEntries);
+    int atlasCount = 0;
+    int *atlasHeights = NULL;
+    int shelfX = 0, shelfY = 0, shelfHeight = 0;
+    for (int i = 0; i < entryCount; i++) {
+        RaylibTMXAtlasEntry *entry = &entries[i];
+        int width = entry->image.width + RAYLIB_TMX_ATLAS_PADDING;
+        int height = entry->image.height + RAYLIB_TMX_ATLAS_PADDING;
+        if (entry->image.data == NULL || width > RAYLIB_TMX_ATLAS_SIZE || height > RAYLIB_TMX_ATLAS_SIZE) continue;
+        if (atlasCount > 0 && shelfX + width > RAYLIB_TMX_ATLAS_SIZE) {
+            shelfX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (atlasCount == 0 || shelfY + height > RAYLIB_TMX_ATLAS_SIZE) {
+            atlasHeights = (int *)MemRealloc(atlasHeights, (unsigned int)(atlasCount + 1) * sizeof(int));
+            atlasHeights[atlasCount++] = 0;
+            shelfX = shelfY = shelfHeight = 0;
+        }
+        entry->atlas = atlasCount - 1;
+        entry->x = shelfX;
+        entry->y = shelfY;
+        shelfX += width;
+        if (height > shelfHeight) shelfHeight = height;
+        if (shelfY + entry->image.height > atlasHeights[entry->atlas]) atlasHeights[entry->atlas] = shelfY + entry->image.height;
+    }
+
+    // Copy the pixels into the atlases, and upload them.
+    RaylibTMXTexture **atlases = (RaylibTMXTexture **)MemAlloc((unsigned int)(atlasCount + 1) * sizeof(RaylibTMXTexture *));
+    for (int a = 0; a < atlasCount; a++) {
+        Image atlas = {0};
+        atlas.width = RAYLIB_TMX_ATLAS_SIZE;
+        atlas.height = atlasHeights[a];
+        atlas.mipmaps = 1;
+        atlas.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        atlas.data = MemAlloc((unsigned int)(atlas.width * atlas.height * 4));
+        for (int i = 0; i < entryCount; i++) {
+            if (entries[i].atlas != a) continue;
+            for (int row = 0; row < entries[i].image.height; row++) {
+                memcpy((unsigned char *)atlas.data + ((size_t)(entries[i].y + row) * (size_t)atlas.width + (size_t)entries[i].x) * 4,
+                    (unsigned char *)entries[i].image.data + (size_t)row * (size_t)entries[i].image.width * 4,
+                    (size_t)entries[i].image.width * 4);
+            }
+        }
+        atlases[a] = (RaylibTMXTexture *)MemAlloc(sizeof(RaylibTMXTexture));
+        atlases[a]->texture = LoadTextureFromImage(atlas);
+        UnloadImage(atlas);
+    }
+
+    // Point the tiles to the atlases.
+    for (tmx_tileset_list *list = map->ts_head; list != NULL; list = list->next) {
+        tmx_tileset *tileset = list->tileset;
+        for (int i = 0; i < entryCount; i++) {
+            if (entries[i].atlas < 0) continue;
+            if (tileset->image != NULL && tileset->image->resource_image == entries[i].source) {
+                Vector2 offset = SwapTMXAtlasImage(&entries[i], atlases, tileset->image);
+                for (unsigned int t = 0; tileset->tiles != NULL && t < tileset->tilecount; t++) {
+                    tileset->tiles[t].ul_x += (unsigned int)offset.x;
+                    tileset->tiles[t].ul_y += (unsigned int)offset.y;
+                }
+            }
+            for (unsigned int t = 0; tileset->image == NULL && tileset->tiles != NULL && t < tileset->tilecount; t++) {
+                tmx_tile *tile = &tileset->tiles[t];
+                if (tile->image == NULL || tile->image->resource_image != entries[i].source) continue;
+                Vector2 offset = SwapTMXAtlasImage(&entries[i], atlases, tile->image);
+                tile->ul_x += (unsigned int)offset.x;
+                tile->ul_y += (unsigned int)offset.y;
+            }
+        }
+    }
+
+    for (int i = 0; i < entryCount; i++) {
+        if (entries[i].image.data != NULL) UnloadImage(entries[i].image);
+    }
+    MemFree(entries);
+    MemFree(atlasHeights);
+    MemFree(atlases);
+
+    // Compiled cells and meshes point to the released textures, so rebuild them.
+    RaylibTMXState *state = GetTMXState(map, false);
+    if (state != NULL) {
+        bool compiled = state->compiledLayers != NULL;
+        UnloadTMXCompiledLayers(state);
+        int meshCount = 0;
+        for (RaylibTMXLayerMesh *mesh = state->layerMeshes; mesh != NULL; mesh = mesh->next) meshCount++;
+        tmx_layer **meshLayers = (tmx_layer **)MemAlloc((unsigned int)(meshCount + 1) * sizeof(tmx_layer *));
+        meshCount = 0;
+        for (RaylibTMXLayerMesh *mesh = state->layerMeshes; mesh != NULL; mesh = mesh->next) meshLayers[meshCount++] = mesh->layer;
+        for (int i = 0; i < meshCount; i++) BuildTMXLayerMesh(map, meshLayers[i]);
+        MemFree(meshLayers);
+        if (compiled) CompileTMX(map);
+    }
+
+    TraceLog(LOG_INFO, "TMX: Packed %i images into %i atlases", entryCount, atlasCount);
+    return atlasCount;
+}
+
+/**
+ * Get the area covered by the collisions reported for an object.
+ *
+ * @internal
+ */
+Rectangle GetTMXObjectBounds(tmx_object *object) {
+    Rectangle bounds = {(float)object->x, (float)object->y, (float)object->width, (float)object->height};
+    switch (object->obj_type)
+    {
+        case OT_POLYGON:
+        case OT_POLYLINE: {
+            double **points = object->content.shape->points;
+            double minX = 0.0, minY = 0.0, maxX = 0.0, maxY = 0.0;
+            for (int i = 0; i < object->content.shape->points_len; i++) {
+                minX = (i == 0 || points[i][0] < minX) ? points[i][0] : minX;
+                minY = (i == 0 || points[i][1] < minY) ? points[i][1] : minY;
+                maxX = (i == 0 || points[i][0] > maxX) ? points[i][0] : maxX;
+                maxY = (i == 0 || points[i][1] > maxY) ? points[i][1] : maxY;
+            }
+            bounds = (Rectangle){(float)(object->x + minX), (float)(object->y + minY), (float)(maxX - minX), (float)(maxY - minY)};
+        } break;
+        case OT_TILE: {
+            // Tile objects are reported both above their position, and with their tile's collisions below it.
+            bounds.y -= bounds.height;
+            bounds.height *= 2.0f;
+        } break;
+        case OT_POINT: {
+            bounds = (Rectangle){bounds.x - 5.0f, bounds.y - 5.0f, 10.0f, 10.0f};
+        } break;
+        default: break;
+    }
+    return bounds;
+}
+
+/**
+ * Check whether two rectangles overlap, including when they only touch.
+ *
+ * @internal
+ */
+bool CheckTMXBoundsOverlap(Rectangle a, Rectangle b) {
+    return a.x <= b.x + b.width && a.x + a.width >= b.x && a.y <= b.y + b.height && a.y + a.height >= b.y;
+}
+
+/**
+ * Add a collision to a block of baked collisions, along with the points of its polygon.
+ *
+ * The polygon only points to its points once the block is complete, see FinishTMXColliderBlock(),
+ * as the points may still move while the block grows.
+ *
+ * @internal
+ */
+void AddTMXCollider(RaylibTMXColliderBlock *block, tmx_object *object, RaylibTMXCollision collision, Rectangle bounds, double x, double y) {
+    if (block->colliderCount == block->colliderCapacity) {
+        block->colliderCapacity = (block->colliderCapacity == 0) ? 64 : block->colliderCapacity * 2;
+        block->colliders = (RaylibTMXCollider *)MemRealloc(block->colliders, (unsigned int)block->colliderCapacity * sizeof(RaylibTMXCollider));
+        block->vertexStarts = (int *)MemRealloc(block->vertexStarts, (unsigned int)block->colliderCapacity * sizeof(int));
+    }
+    block->vertexStarts[block->colliderCount] = -1;
+
+    if (collision.type == COLLISION_POLYGON || collision.type == COLLISION_POLYLINE) {
+        if (block->vertexCount + collision.polygon.count > block->vertexCapacity) {
+            while (block->vertexCount + collision.polygon.count > block->vertexCapacity) {
+                block->vertexCapacity = (block->vertexCapacity == 0) ? 64 : block->vertexCapacity * 2;
+            }
+            block->vertices = (Vector2 *)MemRealloc(block->vertices, (unsigned int)block->vertexCapacity * sizeof(Vector2));
+        }
+        for (int i = 0; i < collision.polygon.count; i++) {
+            block->vertices[block->vertexCount + i] = (Vector2){(float)(x + collision.polygon.points[i][0]), (float)(y + collision.polygon.points[i][1])};
+        }
+        collision.polygon.vertices = NULL;
+        block->vertexStarts[block->colliderCount] = block->vertexCount;
+        block->vertexCount += collision.polygon.count;
+    }
+
+    block->colliders[block->colliderCount++] = (RaylibTMXCollider){object, collision, bounds};
+}
+
+/**
+ * Make room for the given number of bounds. The existing bounds are not kept.
+ *
+ * @internal
+ */
+void ResizeTMXBoxes(RaylibTMXBoxes *boxes, int capacity) {
+    MemFree(boxes->minX);
+    boxes->minX = (float *)MemAlloc((unsigned int)capacity * 4 * sizeof(float));
+    boxes->minY = boxes->minX + capacity;
+    boxes->maxX = boxes->minY + capacity;
+    boxes->maxY = boxes->maxX + capacity;
+}
+
+/**
+ * Store the edges of a rectangle as one of a list of bounds.
+ *
+ * @internal
+ */
+void SetTMXBox(RaylibTMXBoxes *boxes, int index, Rectangle bounds) {
+    boxes->minX[index] = bounds.x;
+    boxes->minY[index] = bounds.y;
+    boxes->maxX[index] = bounds.x + bounds.width;
+    boxes->maxY[index] = bounds.y + bounds.height;
+}
+
+/**
+ * Point the polygons of a complete block of baked collisions to their points, and store their bounds.
+ *
+ * @internal
+ */
+void FinishTMXColliderBlock(RaylibTMXColliderBlock *block) {
+    if (block->colliderCount > block->boxCapacity) {
+        block->boxCapacity = block->colliderCapacity;
+        ResizeTMXBoxes(&block->boxes, block->boxCapacity);
+    }
+    for (int i = 0; i < block->colliderCount; i++) {
+        SetTMXBox(&block->boxes, i, block->colliders[i].bounds);
+        if (block->vertexStarts[i] < 0) continue;
+        block->colliders[i].collision.polygon.vertices = block->vertices + block->vertexStarts[i];
+    }
+    block->dirty = false;
+}
+
+/**
+ * Bake the collisions of the tile in a single cell of a tile layer.
+ *
+ * @internal
+ */
+void BakeTMXCellColliders(tmx_map *map, tmx_layer *layer, unsigned int x, unsigned int y, RaylibTMXColliderBlock *block) {
+    unsigned int index   = (y * map->width) + x;
+    unsigned int baseGid = layer->content.gids[index];
+    unsigned int gid     = baseGid & TMX_FLIP_BITS_REMOVAL;
+    tmx_tile* tile       = map->tiles[gid];
+    if (!tile || !tile->collision) return;
+    tmx_object *collision = tile->collision;
+    do {
+        tmx_object copy = *collision;
+        copy.x += (x * tile->width);
+        copy.y += (y * tile->height);
+        switch (tile->tileset->objectalignment)
+        {
+            // TODO: Rotated collisions shall be handle here
+            case OA_TOPLEFT: /*RAYLIB DEFAULT */ /*TODO*/ break;
+            case OA_NONE:
+            case OA_BOTTOMLEFT:  /* TILED DEFAULT */ /* TODO */  break;
+            case OA_TOP:         /* TODO */ break;
+            case OA_LEFT:        /* TODO */ break;
+            case OA_BOTTOM:      /* TODO */ break;
+            case OA_RIGHT:       /* TODO */ break;
+            case OA_TOPRIGHT:    /* TODO */ break;
+            case OA_BOTTOMRIGHT: /* TODO */ break;
+            case OA_CENTER:      /* TODO */ break;
+        }
+        AddTMXCollider(block, collision, HandleTMXCollision(&copy), GetTMXObjectBounds(&copy), copy.x, copy.y);
+    } while ((collision = collision->next));
+}
+
+/**
+ * Bake the collisions of an object from an object layer, including the ones of its tile.
+ *
+ * @internal
+ */
+void BakeTMXObjectColliders(tmx_map *map, tmx_object *object, RaylibTMXColliderBlock *block) {
+    if (object->obj_type == OT_TEXT || object->obj_type == OT_NONE) return;
+    RaylibTMXCollision raylibCollision = HandleTMXCollision(object);
+    if (object->obj_type != OT_TILE) {
+        AddTMXCollider(block, object, raylibCollision, GetTMXObjectBounds(object), object->x, object->y);
+        return;
+    }
+    int baseGid      = object->content.gid;
+    unsigned int gid = baseGid & TMX_FLIP_BITS_REMOVAL;
+    tmx_tile* tile   = map->tiles[gid];
+    if (!tile) {
+        AddTMXCollider(block, object, raylibCollision, GetTMXObjectBounds(object), object->x, object->y);
+        return;
+    }
+    int is_vertically_fliped   = baseGid & TMX_FLIPPED_VERTICALLY;
+    int is_horizontally_fliped = {
+        (int)((unsigned int)baseGid & TMX_FLIPPED_HORIZONTALLY)
+    };
+    switch (tile->tileset->objectalignment)
+    {
+        // TODO: Rotated collisions shall be handled here
+        case OA_TOPLEFT: /*RAYLIB DEFAULT*/ break;
+        case OA_NONE:
+        case OA_BOTTOMLEFT: /* TILED DEFAULT */ {
+            if (raylibCollision.type == COLLISION_RECT) {
+                raylibCollision.rect.y -= (float) object->height;
+            }
+        } break;
+        case OA_TOP:         /* TODO */ break;
+        case OA_LEFT:        /* TODO */ break;
+        case OA_BOTTOM:      /* TODO */ break;
+        case OA_RIGHT:       /* TODO */ break;
+        case OA_TOPRIGHT:    /* TODO */ break;
+        case OA_BOTTOMRIGHT: /* TODO */ break;
+        case OA_CENTER:      /* TODO */ break;
+    }
+    AddTMXCollider(block, object, raylibCollision, raylibCollision.rect, object->x, object->y);
+
+    tmx_object *collision = tile->collision;
+    if (!collision) return;
+    do {
+        tmx_object copy = *collision;
+        copy.x += object->x;
+        copy.y += object->y;
+        switch (tile->tileset->objectalignment)
+        {
+            // TODO: Rotated collisions shall be handled here
+            case OA_TOPLEFT: /*RAYLIB DEFAULT*/ {
+                if (is_horizontally_fliped) {
+                    copy.x = object->x + object->width - (collision->x + collision->width);
+                }
+                if (is_vertically_fliped) {
+                    copy.y = object->y + object->height - (collision->y + collision->height);
+                }
+            } break;
+            case OA_NONE:
+            case OA_BOTTOMLEFT: /* TILED DEFAULT */ {
+                if (is_horizontally_fliped) {
+                    copy.x += object->width - collision->width;
+                }
+                if (is_vertically_fliped) {
+                    copy.y += object->height - collision->height;
+                }
+            } break;
+            case OA_TOP:         /* TODO */ break;
+            case OA_LEFT:        /* TODO */ break;
+            case OA_BOTTOM:      /* TODO */ break;
+            case OA_RIGHT:       /* TODO */ break;
+            case OA_TOPRIGHT:    /* TODO */ break;
+            case OA_BOTTOMRIGHT: /* TODO */ break;
+            case OA_CENTER:      /* TODO */ break;
+        }
+        AddTMXCollider(block, collision, HandleTMXCollision(&copy), GetTMXObjectBounds(&copy), copy.x, copy.y);
+    } while ((collision = collision->next));
+}
+
+/**
+ * Bake the collisions of the cells of a chunk of a tile layer.
+ *
+ * @internal
+ */
+void BakeTMXColliderChunk(tmx_map *map, RaylibTMXLayerColliders *colliders, int chunkX, int chunkY) {
+    RaylibTMXColliderBlock *block = &colliders->blocks[chunkY * colliders->chunksX + chunkX];
+    if (block->cooked) {
+        // The arrays loaded with a cooked map point into its data, so they can't grow.
+        block->starts = NULL;
+        block->vertices = NULL;
+        block->vertexCapacity = 0;
+        block->boxes = (RaylibTMXBoxes){0};
+        block->boxCapacity = 0;
+        block->cooked = false;
+    }
+    block->colliderCount = 0;
+    block->vertexCount = 0;
+    if (block->starts == NULL) {
+        block->starts = (int *)MemAlloc((RAYLIB_TMX_CHUNK_SIZE * RAYLIB_TMX_CHUNK_SIZE + 1) * sizeof(int));
+    }
+
+    int startX = chunkX * RAYLIB_TMX_CHUNK_SIZE;
+    int startY = chunkY * RAYLIB_TMX_CHUNK_SIZE;
+    for (int y = 0; y < RAYLIB_TMX_CHUNK_SIZE; y++) {
+        for (int x = 0; x < RAYLIB_TMX_CHUNK_SIZE; x++) {
+            block->starts[y * RAYLIB_TMX_CHUNK_SIZE + x] = block->colliderCount;
+            if (startX + x >= (int)map->width || startY + y >= (int)map->height) continue;
+            BakeTMXCellColliders(map, colliders->layer, (unsigned int)(startX + x), (unsigned int)(startY + y), block);
+        }
+    }
+    block->starts[RAYLIB_TMX_CHUNK_SIZE * RAYLIB_TMX_CHUNK_SIZE] = block->colliderCount;
+    FinishTMXColliderBlock(block);
+}
+
+/**
+ * Get the collisions baked for a chunk of a tile layer, baking it again when its tiles changed or
+ * it was unloaded, and move it to the end of the least recently used list.
+ *
+ * @internal
+ */
+RaylibTMXColliderBlock *GetTMXColliderChunk(tmx_map *map, RaylibTMXState *state, RaylibTMXLayerColliders *colliders, int chunkX, int chunkY) {
+    RaylibTMXColliderBlock *block = &colliders->blocks[chunkY * colliders->chunksX + chunkX];
+    if (block->dirty) BakeTMXColliderChunk(map, colliders, chunkX, chunkY);
+    if (block == state->mostUsedBlock) return block;
+    if (block->lessUsed != NULL || block == state->leastUsedBlock) {
+        if (block->lessUsed) block->lessUsed->moreUsed = block->moreUsed;
+        else state->leastUsedBlock = block->moreUsed;
+        block->moreUsed->lessUsed = block->lessUsed;
+    }
+    else {
+        state->colliderResident++;
+    }
+    block->lessUsed = state->mostUsedBlock;
+    block->moreUsed = NULL;
+    if (state->mostUsedBlock) state->mostUsedBlock->moreUsed = block;
+    else state->leastUsedBlock = block;
+    state->mostUsedBlock = block;
+    return block;
+}
+
+/**
+ * Unload the least recently queried chunks of tile layer collisions until they fit the cache budget.
+ *
+ * This only runs as a query starts, so the collisions found by a query stay valid while it runs,
+ * even when it goes through more chunks than the budget.
+ *
+ * @internal
+ */
+void EvictTMXColliderChunks(RaylibTMXState *state) {
+    if (state->cacheBudget <= 0) return;
+    while (state->colliderResident > state->cacheBudget && state->leastUsedBlock != state->mostUsedBlock) {
+        RaylibTMXColliderBlock *block = state->leastUsedBlock;
+        state->leastUsedBlock = block->moreUsed;
+        state->leastUsedBlock->lessUsed = NULL;
+        state->colliderResident--;
+        UnloadTMXColliderBlock(block);
+    }
+}
+
+/**
+ * Sort the colliders of an object layer into bins by the bin holding their top-left corner.
+ *
+ * A collider no larger than a bin only overlaps a rectangle when its corner lies at most a bin
+ * above or to the left of it, so the bins to test form a range of rows, each contiguous in memory.
+ * The larger colliders are kept together after the bins, and are always tested.
+ *
+ * @internal
+ */
+void BinTMXObjectColliders(tmx_map *map, RaylibTMXLayerColliders *colliders) {
+    RaylibTMXColliderBlock *block = colliders->blocks;
+    colliders->binWidth = (float)(map->tile_width * RAYLIB_TMX_INDEX_BUCKET_SIZE);
+    colliders->binHeight = (float)(map->tile_height * RAYLIB_TMX_INDEX_BUCKET_SIZE);
+    colliders->binsX = ((int)map->width + RAYLIB_TMX_INDEX_BUCKET_SIZE - 1) / RAYLIB_TMX_INDEX_BUCKET_SIZE;
+    colliders->binsY = ((int)map->height + RAYLIB_TMX_INDEX_BUCKET_SIZE - 1) / RAYLIB_TMX_INDEX_BUCKET_SIZE;
+    if (colliders->binsX < 1) colliders->binsX = 1;
+    if (colliders->binsY < 1) colliders->binsY = 1;
+    int binCount = colliders->binsX * colliders->binsY;
+
+    // Counting sort, with the larger colliders in an extra bin at the end.
+    int *bins = (int *)MemAlloc((unsigned int)(block->colliderCount + 1) * sizeof(int));
+    colliders->binStarts = (int *)MemAlloc((unsigned int)(binCount + 2) * sizeof(int));
+    for (int i = 0; i < block->colliderCount; i++) {
+        Rectangle bounds = block->colliders[i].bounds;
+        if (bounds.width > colliders->binWidth || bounds.height > colliders->binHeight) {
+            bins[i] = binCount;
+        }
+        else {
+            int x = (int)fminf(fmaxf(floorf(bounds.x / colliders->binWidth), 0.0f), (float)(colliders->binsX - 1));
+            int y = (int)fminf(fmaxf(floorf(bounds.y / colliders->binHeight), 0.0f), (float)(colliders->binsY - 1));
+            bins[i] = y * colliders->binsX + x;
+        }
+        colliders->binStarts[bins[i] + 1]++;
+    }
+    for (int bin = 0; bin <= binCount; bin++) colliders->binStarts[bin + 1] += colliders->binStarts[bin];
+
+    colliders->binColliders = (int *)MemAlloc((unsigned int)(block->colliderCount + 1) * sizeof(int));
+    ResizeTMXBoxes(&colliders->binBoxes, block->colliderCount + 1);
+    for (int i = 0; i < block->colliderCount; i++) {
+        int entry = colliders->binStarts[bins[i]]++;
+        colliders->binColliders[entry] = i;
+        SetTMXBox(&colliders->binBoxes, entry, block->colliders[i].bounds);
+    }
+
+    // Filling moved each start to the next bin's, so shift them back.
+    for (int bin = binCount; bin > 0; bin--) colliders->binStarts[bin] = colliders->binStarts[bin - 1];
+    colliders->binStarts[0] = 0;
+    MemFree(bins);
+}
+
+/**
+ * Bake the collisions of the map's layers, in map coordinates.
+ *
+ * Tile layers are baked per chunk, so that changing a tile only bakes its chunk again.
+ *
+ * @internal
+ */
+void LoadTMXColliders(tmx_map *map, RaylibTMXState *state) {
+    RaylibTMXLayerColliders **link = &state->layerColliders;
+    for (tmx_layer *layer = map->ly_head; layer != NULL; layer = layer->next) {
+        if (layer->type != L_LAYER && layer->type != L_OBJGR) continue;
+
+        RaylibTMXLayerColliders *colliders = (RaylibTMXLayerColliders *)MemAlloc(sizeof(RaylibTMXLayerColliders));
+        colliders->layer = layer;
+        if (layer->type == L_LAYER) {
+            colliders->chunksX = ((int)map->width + RAYLIB_TMX_CHUNK_SIZE - 1) / RAYLIB_TMX_CHUNK_SIZE;
+            colliders->chunksY = ((int)map->height + RAYLIB_TMX_CHUNK_SIZE - 1) / RAYLIB_TMX_CHUNK_SIZE;
+            colliders->blocks = (RaylibTMXColliderBlock *)MemAlloc((unsigned int)(colliders->chunksX * colliders->chunksY) * sizeof(RaylibTMXColliderBlock));
+            // With a cache budget, only the chunks that are queried get baked.
+            for (int chunkY = 0; chunkY < colliders->chunksY; chunkY++) {
+                for (int chunkX = 0; chunkX < colliders->chunksX; chunkX++) {
+                    RaylibTMXColliderBlock *block = &colliders->blocks[chunkY * colliders->chunksX + chunkX];
+                    block->dirty = true;
+                    if (state->cacheBudget == 0) GetTMXColliderChunk(map, state, colliders, chunkX, chunkY);
+                }
+            }
+        }
+        else {
+            colliders->chunksX = 1;
+            colliders->chunksY = 1;
+            colliders->blocks = (RaylibTMXColliderBlock *)MemAlloc(sizeof(RaylibTMXColliderBlock));
+            RaylibTMXColliderBlock *block = colliders->blocks;
+            int objectCount = 0;
+            for (tmx_object *object = layer->content.objgr->head; object != NULL; object = object->next) objectCount++;
+            block->starts = (int *)MemAlloc((unsigned int)(objectCount + 1) * sizeof(int));
+            int i = 0;
+            for (tmx_object *object = layer->content.objgr->head; object != NULL; object = object->next) {
+                block->starts[i++] = block->colliderCount;
+                BakeTMXObjectColliders(map, object, block);
+            }
+            block->starts[objectCount] = block->colliderCount;
+            FinishTMXColliderBlock(block);
+            BinTMXObjectColliders(map, colliders);
+        }
+
+        *link = colliders;
+        link = &colliders->next;
+    }
+}
+
+/**
+ * Find the collisions baked for a layer, loading them first when the map has none.
+ *
+ * @internal
+ */
+RaylibTMXLayerColliders *GetTMXLayerColliders(tmx_map *map, tmx_layer *layer) {
+    RaylibTMXState *state = GetTMXState(map, true);
+    if (!state->indexLoaded) UpdateTMXCollisionIndex(map);
+    EvictTMXColliderChunks(state);
+    RaylibTMXLayerColliders *colliders = state->layerColliders;
+    while (colliders && colliders->layer != layer) colliders = colliders->next;
+    return colliders;
+}
+
+/**
+ * Get the collisions baked for a cell of a tile layer, baking its chunk again when it changed.
+ *
+ * @internal
+ */
+const RaylibTMXCollider *GetTMXChunkCellColliders(tmx_map *map, RaylibTMXState *state, RaylibTMXLayerColliders *colliders, int x, int y, int *count) {
+    int chunkX = x / RAYLIB_TMX_CHUNK_SIZE;
+    int chunkY = y / RAYLIB_TMX_CHUNK_SIZE;
+    RaylibTMXColliderBlock *block = GetTMXColliderChunk(map, state, colliders, chunkX, chunkY);
+    int cell = (y - chunkY * RAYLIB_TMX_CHUNK_SIZE) * RAYLIB_TMX_CHUNK_SIZE + (x - chunkX * RAYLIB_TMX_CHUNK_SIZE);
+    *count = block->starts[cell + 1] - block->starts[cell];
+    return block->colliders + block->starts[cell];
+}
+
+/**
+ * Call the callback with each of the given collisions.
+ *
+ * @param filter When not NULL, only the collisions overlapping this area are reported.
+ *
+ * @internal
+ */
+void ReportTMXColliders(const RaylibTMXCollider *colliders, int count, const Rectangle *filter, tmx_collision_functor callback, void* userdata) {
+    for (int i = 0; i < count; i++) {
+        if (filter && !CheckTMXBoundsOverlap(colliders[i].bounds, *filter)) continue;
+        RAYLIB_TMX_STAT(collisionCallbacks, 1);
+        callback(colliders[i].object, colliders[i].collision, userdata);
+    }
+}
+
+/**
+ * Get the collisions of a cell of a tile layer.
+ *
+ * The collisions are baked in map coordinates by LoadTMX(), and the points of polygons and
+ * polylines are available as floats in collision.polygon.vertices.
+ *
+ * @param map   The map holding the layer.
+ * @param layer The tile layer.
+ * @param x     The column of the cell.
+ * @param y     The row of the cell.
+ * @param count Where to store the number of collisions returned.
+ *
+ * @return The collisions of the cell, which stay valid until its tile changes or the collision index is updated.
+ */
+const RaylibTMXCollider *GetTMXCellColliders(tmx_map *map, tmx_layer *layer, int x, int y, int *count) {
+    *count = 0;
+    if (map == NULL || layer == NULL || layer->type != L_LAYER) return NULL;
+    if (x < 0 || y < 0 || x >= (int)map->width || y >= (int)map->height) return NULL;
+    RaylibTMXLayerColliders *colliders = GetTMXLayerColliders(map, layer);
+    if (colliders == NULL) return NULL;
+    return GetTMXChunkCellColliders(map, GetTMXState(map, false), colliders, x, y, count);
+}
+
+/**
+ * Get the collisions of the objects of an object layer, in the order of the objects.
+ *
+ * @param map   The map holding the layer.
+ * @param layer The object layer.
+ * @param count Where to store the number of collisions returned.
+ *
+ * @return The collisions of the layer, which stay valid until the collision index is updated.
+ *
+ * @see UpdateTMXCollisionIndex()
+ */
+const RaylibTMXCollider *GetTMXObjectColliders(tmx_map *map, tmx_layer *layer, int *count) {
+    *count = 0;
+    if (map == NULL || layer == NULL || layer->type != L_OBJGR) return NULL;
+    RaylibTMXLayerColliders *colliders = GetTMXLayerColliders(map, layer);
+    if (colliders == NULL) return NULL;
+    *count = colliders->blocks->colliderCount;
+    return colliders->blocks->colliders;
+}
+
+/**
+ * Returns each tmx_object on a given map and their collisions on a callback
+ *
+ * The collisions come from the colliders baked for the map, so objects that were changed since
+ * LoadTMX() are only seen after calling UpdateTMXCollisionIndex().
+ *
+ * @param map       The map where collisions will be collected and calculated.
+ * @param callback  The callback function that the user wants to receive the collisions.
+ * @param userdata  The userdata that the user wnats to utilize within the callback.
+ */
+void CollisionsTMXForeach(tmx_map *map, tmx_collision_functor callback, void* userdata) {
+    tmx_layer *layer = map->ly_head;
+    do {
+        if (!layer->visible) continue;
+        switch (layer->type)
+        {
+            case L_LAYER: {
+                RaylibTMXLayerColliders *colliders = GetTMXLayerColliders(map, layer);
+                if (!colliders) continue;
+                RaylibTMXState *state = GetTMXState(map, false);
+                for (unsigned int y = 0; y < map->height; y++) {
+                    for (unsigned int x = 0; x < map->width; x++) {
+                        int count;
+                        const RaylibTMXCollider *cell = GetTMXChunkCellColliders(map, state, colliders, (int)x, (int)y, &count);
+                        ReportTMXColliders(cell, count, NULL, callback, userdata);
+                    }
+                }
+            } break;
+            case L_OBJGR: {
+                RaylibTMXLayerColliders *colliders = GetTMXLayerColliders(map, layer);
+                if (!colliders) continue;
+                ReportTMXColliders(colliders->blocks->colliders, colliders->blocks->colliderCount, NULL, callback, userdata);
+            } break;
+            
+            default: continue;
+        }
+    } while ((layer = layer->next));
+}
+
+/**
+ * Get the range of index buckets that a rectangle overlaps, clamped to the grid.
+ *
+ * @internal
+ */
+void GetTMXIndexBucketRange(RaylibTMXState *state, Rectangle bounds, int *minX, int *minY, int *maxX, int *maxY) {
+    *minX = (int)fminf(fmaxf(floorf(bounds.x / state->indexBucketWidth), 0.0f), (float)(state->indexBucketsX - 1));
+    *minY = (int)fminf(fmaxf(floorf(bounds.y / state->indexBucketHeight), 0.0f), (float)(state->indexBucketsY - 1));
+    *maxX = (int)fminf(fmaxf(floorf((bounds.x + bounds.width) / state->indexBucketWidth), 0.0f), (float)(state->indexBucketsX - 1));
+    *maxY = (int)fminf(fmaxf(floorf((bounds.y + bounds.height) / state->indexBucketHeight), 0.0f), (float)(state->indexBucketsY - 1));
+}
+
+/**
+ * Build the collision index of the map's object layers, and the drawing grids of the larger ones,
+ * from the collisions baked for the map.
+ *
+ * @internal
+ */
+void LoadTMXCollisionIndex(tmx_map *map, RaylibTMXState *state) {
+    state->indexLoaded = true;
+
+    state->indexBucketWidth = (float)(map->tile_width * RAYLIB_TMX_INDEX_BUCKET_SIZE);
+    state->indexBucketHeight = (float)(map->tile_height * RAYLIB_TMX_INDEX_BUCKET_SIZE);
+    state->indexBucketsX = ((int)map->width + RAYLIB_TMX_INDEX_BUCKET_SIZE - 1) / RAYLIB_TMX_INDEX_BUCKET_SIZE;
+    state->indexBucketsY = ((int)map->height + RAYLIB_TMX_INDEX_BUCKET_SIZE - 1) / RAYLIB_TMX_INDEX_BUCKET_SIZE;
+    if (state->indexBucketsX < 1) state->indexBucketsX = 1;
+    if (state->indexBucketsY < 1) state->indexBucketsY = 1;
+    int bucketCount = state->indexBucketsX * state->indexBucketsY;
+
+    // Gather the objects of the visible object layers, the same ones CollisionsTMXForeach() reports.
+    int capacity = 0;
+    for (RaylibTMXLayerColliders *colliders = state->layerColliders; colliders != NULL; colliders = colliders->next) {
+        tmx_layer *layer = colliders->layer;
+        if (!layer->visible || layer->type != L_OBJGR) continue;
+        RaylibTMXColliderBlock *block = colliders->blocks;
+        int i = 0;
+        for (tmx_object *object = layer->content.objgr->head; object != NULL; object = object->next, i++) {
+            if (object->obj_type == OT_TEXT || object->obj_type == OT_NONE) continue;
+            if (state->indexObjectCount == capacity) {
+                capacity = (capacity == 0) ? 64 : capacity * 2;
+                state->indexObjects = (tmx_object **)MemRealloc(state->indexObjects, (unsigned int)capacity * sizeof(tmx_object *));
+                state->indexBounds = (Rectangle *)MemRealloc(state->indexBounds, (unsigned int)capacity * sizeof(Rectangle));
+                state->indexColliders = (const RaylibTMXCollider **)MemRealloc((void *)state->indexColliders, (unsigned int)capacity * sizeof(RaylibTMXCollider *));
+                state->indexColliderCounts = (int *)MemRealloc(state->indexColliderCounts, (unsigned int)capacity * sizeof(int));
+            }
+            state->indexObjects[state->indexObjectCount] = object;
+            state->indexBounds[state->indexObjectCount] = GetTMXObjectBounds(object);
+            state->indexColliders[state->indexObjectCount] = block->colliders + block->starts[i];
+            state->indexColliderCounts[state->indexObjectCount] = block->starts[i + 1] - block->starts[i];
+            state->indexObjectCount++;
+        }
+    }
+    state->indexStamps = (unsigned int *)MemAlloc((unsigned int)(state->indexObjectCount + 1) * sizeof(unsigned int));
+
+    // Count the entries of each bucket, then fill them in, so all entries share one array.
+    state->indexBucketStarts = (int *)MemAlloc((unsigned int)(bucketCount + 1) * sizeof(int));
+    for (int i = 0; i < state->indexObjectCount; i++) {
+        int minX, minY, maxX, maxY;
+        GetTMXIndexBucketRange(state, state->indexBounds[i], &minX, &minY, &maxX, &maxY);
+        for (int y = minY; y <= maxY; y++) {
+            for (int x = minX; x <= maxX; x++) state->indexBucketStarts[y * state->indexBucketsX + x + 1]++;
+        }
+    }
+    for (int i = 0; i < bucketCount; i++) {
+        state->indexBucketStarts[i + 1] += state->indexBucketStarts[i];
+    }
+    state->indexEntries = (int *)MemAlloc((unsigned int)(state->indexBucketStarts[bucketCount] + 1) * sizeof(int));
+    int *fill = (int *)MemAlloc((unsigned int)bucketCount * sizeof(int));
+    for (int i = 0; i < state->indexObjectCount; i++) {
+        int minX, minY, maxX, maxY;
+        GetTMXIndexBucketRange(state, state->indexBounds[i], &minX, &minY, &maxX, &maxY);
+        for (int y = minY; y <= maxY; y++) {
+            for (int x = minX; x <= maxX; x++) {
+                int bucket = y * state->indexBucketsX + x;
+                state->indexEntries[state->indexBucketStarts[bucket] + fill[bucket]++] = i;
+            }
+        }
+    }
+    MemFree(fill);
+
+    LoadTMXObjectGrids(map, state, map->ly_head);
+}
+
+/**
+ * Rebuild the collision index of the map's object layers, and the grids used to draw only the
+ * visible objects of the larger object layers.
+ *
+ * The index, the collisions of every layer baked in map coordinates, and the solid cell masks of the
+ * tile layers, are built by LoadTMX(). Call this after moving, adding or removing objects or layers,
+ * or after changing the visibility of layers, so that the collision queries and the drawing see the
+ * changes. Changing the GIDs of tile layers only needs SetTMXTile(), or InvalidateTMXCache(), which
+ * bake their chunk again.
+ *
+ * @param map The map to index.
+ *
+ * @see QueryTMXCollisionsRect()
+ */
+void UpdateTMXCollisionIndex(tmx_map *map) {
+    if (map == NULL) return;
+    RaylibTMXState *state = GetTMXState(map, true);
+    UnloadTMXCollisionIndex(state);
+    LoadTMXColliders(map, state);
+    LoadTMXSolidMasks(map, state);
+    LoadTMXCollisionIndex(map, state);
+}
+
+/**
+ * Number a layer of the map for the cooked format, counting the layers depth first, groups included.
+ *
+ * @return The number of the layer, or -1 when it's not one of the given layers.
+ *
+ * @internal
+ */
+int FindTMXCookedLayerIndex(tmx_layer *head, tmx_layer *layer, int *index) {
+    for (; head != NULL; head = head->next) {
+        if (head == layer) return *index;
+        (*index)++;
+        if (head->type != L_GROUP) continue;
+        int found = FindTMXCookedLayerIndex(head->content.group_head, layer, index);
+        if (found >= 0) return found;
+    }
+    return -1;
+}
+
+/**
+ * Find the layer of a cooked map with the given number, see FindTMXCookedLayerIndex().
+ *
+ * @internal
+ */
+tmx_layer *GetTMXCookedLayer(tmx_layer *head, int *index) {
+    for (; head != NULL; head = head->next) {
+        if ((*index)-- == 0) return head;
+        if (head->type != L_GROUP) continue;
+        tmx_layer *found = GetTMXCookedLayer(head->content.group_head, index);
+        if (found != NULL) return found;
+    }
+    return NULL;
+}
+
+/**
+ * Get the tile whose collisions a cell of a chunk of baked collisions, or an object, holds.
+ *
+ * @param owner The cell within the chunk, or the index of the object.
+ *
+ * @internal
+ */
+tmx_tile *GetTMXCookedColliderTile(tmx_map *map, RaylibTMXLayerColliders *colliders, int block, int owner, tmx_object *object) {
+    unsigned int gid = 0;
+    if (colliders->layer->type == L_LAYER) {
+        int x = (block % colliders->chunksX) * RAYLIB_TMX_CHUNK_SIZE + owner % RAYLIB_TMX_CHUNK_SIZE;
+        int y = (block / colliders->chunksX) * RAYLIB_TMX_CHUNK_SIZE + owner / RAYLIB_TMX_CHUNK_SIZE;
+        if (x >= (int)map->width || y >= (int)map->height) return NULL;
+        gid = colliders->layer->content.gids[y * (int)map->width + x] & TMX_FLIP_BITS_REMOVAL;
+    }
+    else if (object->obj_type == OT_TILE) {
+        gid = (unsigned int)object->content.gid & TMX_FLIP_BITS_REMOVAL;
+    }
+    return (gid < map->tilecount) ? map->tiles[gid] : NULL;
+}
+
+/**
+ * Append the collisions baked for the map, and its solid cell masks, to a cooked map.
+ *
+ * The arrays are written as they're laid out in memory, so they're used in place when loading the
+ * map. The colliders themselves point to their objects, so they're written with the position of
+ * their object in the collisions of its tile instead, -1 for the object of the layer itself.
+ *
+ * @internal
+ */
+void WriteTMXCookedCollisions(RaylibTMXWriter *writer, tmx_map *map) {
+    RaylibTMXState *state = GetTMXState(map, true);
+    UpdateTMXCollisionIndex(map);
+    WriteTMXCookedString(writer, state->solidProperty);
+    WriteTMXCookedU32(writer, RAYLIB_TMX_CHUNK_SIZE);
+    WriteTMXCookedBytes(writer, state->solidTiles, map->tilecount);
+    WriteTMXCookedBytes(writer, NULL, (4 - map->tilecount % 4) % 4);
+
+    unsigned int maskCount = 0;
+    for (RaylibTMXSolidMask *mask = state->solidMasks; mask != NULL; mask = mask->next) maskCount++;
+    WriteTMXCookedU32(writer, maskCount);
+    for (RaylibTMXSolidMask *mask = state->solidMasks; mask != NULL; mask = mask->next) {
+        int index = 0;
+        WriteTMXCookedI32(writer, (mask->layer != NULL) ? FindTMXCookedLayerIndex(map->ly_head, mask->layer, &index) : -1);
+        WriteTMXCookedI32(writer, mask->combined);
+        // Aligned to eight bytes, for the bits to be used in place as 64-bit words.
+        WriteTMXCookedBytes(writer, NULL, writer->size % 8);
+        for (int i = 0; i < mask->stride * mask->height + 1; i++) {
+            WriteTMXCookedU32(writer, (uint32_t)mask->bits[i]);
+            WriteTMXCookedU32(writer, (uint32_t)(mask->bits[i] >> 32));
+        }
+    }
+
+    unsigned int layerCount = 0;
+    for (RaylibTMXLayerColliders *colliders = state->layerColliders; colliders != NULL; colliders = colliders->next) layerCount++;
+    WriteTMXCookedU32(writer, layerCount);
+    for (RaylibTMXLayerColliders *colliders = state->layerColliders; colliders != NULL; colliders = colliders->next) {
+        int index = 0;
+        WriteTMXCookedI32(writer, FindTMXCookedLayerIndex(map->ly_head, colliders->layer, &index));
+        int owners = RAYLIB_TMX_CHUNK_SIZE * RAYLIB_TMX_CHUNK_SIZE;
+        if (colliders->layer->type == L_OBJGR) {
+            owners = 0;
+            for (tmx_object *object = colliders->layer->content.objgr->head; object != NULL; object = object->next) owners++;
+        }
+        for (int b = 0; b < colliders->chunksX * colliders->chunksY; b++) {
+            // With a cache budget, the chunks of tile layers are only baked once queried.
+            RaylibTMXColliderBlock *block = &colliders->blocks[b];
+            if (colliders->layer->type == L_LAYER) block = GetTMXColliderChunk(map, state, colliders, b % colliders->chunksX, b / colliders->chunksX);
+            WriteTMXCookedU32(writer, (uint32_t)block->colliderCount);
+            WriteTMXCookedU32(writer, (uint32_t)block->vertexCount);
+            for (int i = 0; i <= owners; i++) WriteTMXCookedI32(writer, block->starts[i]);
+            for (int i = 0; i < block->vertexCount; i++) {
+                WriteTMXCookedF32(writer, block->vertices[i].x);
+                WriteTMXCookedF32(writer, block->vertices[i].y);
+            }
+            const float *edges[4] = {block->boxes.minX, block->boxes.minY, block->boxes.maxX, block->boxes.maxY};
+            for (int edge = 0; edge < 4; edge++) {
+                for (int i = 0; i < block->colliderCount; i++) WriteTMXCookedF32(writer, edges[edge][i]);
+            }
+
+            tmx_object *object = (colliders->layer->type == L_OBJGR) ? colliders->layer->content.objgr->head : NULL;
+            for (int owner = 0; owner < owners; owner++) {
+                tmx_tile *tile = GetTMXCookedColliderTile(map, colliders, b, owner, object);
+                for (int i = block->starts[owner]; i < block->starts[owner + 1]; i++) {
+                    const RaylibTMXCollider *collider = &block->colliders[i];
+                    int source = -1;
+                    if (collider->object != object) {
+                        source = 0;
+                        for (tmx_object *collision = (tile != NULL) ? tile->collision : NULL; collision != NULL && collision != collider->object; collision = collision->next) source++;
+                    }
+                    Rectangle shape = {0};
+                    if (collider->collision.type == COLLISION_RECT || collider->collision.type == COLLISION_ELLIPSE) shape = collider->collision.rect;
+                    else if (collider->collision.type == COLLISION_POINT) shape = (Rectangle){collider->collision.point.x, collider->collision.point.y, 0.0f, 0.0f};
+                    WriteTMXCookedI32(writer, source);
+                    WriteTMXCookedI32(writer, (int)collider->collision.type);
+                    WriteTMXCookedI32(writer, block->vertexStarts[i]);
+                    WriteTMXCookedF32(writer, shape.x);
+                    WriteTMXCookedF32(writer, shape.y);
+                    WriteTMXCookedF32(writer, shape.width);
+                    WriteTMXCookedF32(writer, shape.height);
+                    WriteTMXCookedF32(writer, collider->bounds.x);
+                    WriteTMXCookedF32(writer, collider->bounds.y);
+                    WriteTMXCookedF32(writer, collider->bounds.width);
+                    WriteTMXCookedF32(writer, collider->bounds.height);
+                }
+                if (object != NULL) object = object->next;
+            }
+        }
+    }
+}
+
+/**
+ * Read a block of baked collisions from a cooked map, using its arrays in place.
+ *
+ * @internal
+ */
+void ReadTMXCookedColliderBlock(RaylibTMXReader *reader, tmx_map *map, RaylibTMXLayerColliders *colliders, int b) {
+    RaylibTMXColliderBlock *block = &colliders->blocks[b];
+    tmx_object *object = (colliders->layer->type == L_OBJGR) ? colliders->layer->content.objgr->head : NULL;
+    int owners = RAYLIB_TMX_CHUNK_SIZE * RAYLIB_TMX_CHUNK_SIZE;
+    if (colliders->layer->type == L_OBJGR) {
+        owners = 0;
+        for (tmx_object *counted = object; counted != NULL; counted = counted->next) owners++;
+    }
+    uint32_t colliderCount = ReadTMXCookedU32(reader);
+    uint32_t vertexCount = ReadTMXCookedU32(reader);
+    if (colliderCount > (reader->size - reader->at) / 44 || vertexCount > (reader->size - reader->at) / 8) reader->failed = true;
+    int *starts = (int *)ReadTMXCookedWords(reader, (size_t)owners + 1);
+    Vector2 *vertices = (Vector2 *)ReadTMXCookedWords(reader, (size_t)vertexCount * 2);
+    float *boxes = (float *)ReadTMXCookedWords(reader, (size_t)colliderCount * 4);
+    if (reader->failed) return;
+    for (int owner = 0; owner < owners; owner++) {
+        if (starts[owner] > starts[owner + 1]) reader->failed = true;
+    }
+    if (starts[0] != 0 || starts[owners] != (int)colliderCount || reader->failed) {
+        reader->failed = true;
+        return;
+    }
+
+    block->cooked = true;
+    block->starts = starts;
+    block->vertices = vertices;
+    block->vertexCount = block->vertexCapacity = (int)vertexCount;
+    block->boxes = (RaylibTMXBoxes){boxes, boxes + colliderCount, boxes + colliderCount * 2, boxes + colliderCount * 3};
+    block->boxCapacity = (int)colliderCount;
+    block->colliders = (RaylibTMXCollider *)MemAlloc((colliderCount + 1) * sizeof(RaylibTMXCollider));
+    block->vertexStarts = (int *)MemAlloc((colliderCount + 1) * sizeof(int));
+    block->colliderCount = block->colliderCapacity = (int)colliderCount;
+
+    for (int owner = 0; owner < owners && !reader->failed; owner++) {
+        tmx_tile *tile = GetTMXCookedColliderTile(map, colliders, b, owner, object);
+        for (int i = starts[owner]; i < starts[owner + 1] && !reader->failed; i++) {
+            RaylibTMXCollider *collider = &block->colliders[i];
+            int source = ReadTMXCookedI32(reader);
+            int type = ReadTMXCookedI32(reader);
+            int vertexStart = ReadTMXCookedI32(reader);
+            // The order of the reads within an initializer isn't defined, so read them one by one.
+            float values[8];
+            for (int v = 0; v < 8; v++) values[v] = ReadTMXCookedF32(reader);
+            Rectangle shape = {values[0], values[1], values[2], values[3]};
+            collider->bounds = (Rectangle){values[4], values[5], values[6], values[7]};
+            collider->object = (source < 0) ? object : ((tile != NULL) ? tile->collision : NULL);
+            for (int s = 0; s < source && collider->object != NULL; s++) collider->object = collider->object->next;
+            block->vertexStarts[i] = vertexStart;
+            if (collider->object == NULL) {
+                reader->failed = true;
+                break;
+            }
+
+            collider->collision.type = type;
+            switch (type) {
+                case COLLISION_RECT:
+                case COLLISION_ELLIPSE:
+                    collider->collision.rect = shape;
+                    break;
+                case COLLISION_POINT:
+                    collider->collision.point = (Vector2){shape.x, shape.y};
+                    break;
+                case COLLISION_POLYGON:
+                case COLLISION_POLYLINE: {
+                    // The points are the ones of the object, or of the collision of its tile.
+                    tmx_object *shapeObject = collider->object;
+                    bool polygon = shapeObject->obj_type == OT_POLYGON || shapeObject->obj_type == OT_POLYLINE;
+                    if (!polygon || shapeObject->content.shape == NULL || vertexStart < 0 || shapeObject->content.shape->points_len > (int)vertexCount - vertexStart) {
+                        reader->failed = true;
+                        break;
+                    }
+                    collider->collision.polygon.points = shapeObject->content.shape->points;
+                    collider->collision.polygon.count = shapeObject->content.shape->points_len;
+                    collider->collision.polygon.vertices = block->vertices + vertexStart;
+                } break;
+                default:
+                    reader->failed = true;
+                    break;
+            }
+        }
+        if (object != NULL) object = object->next;
+    }
+}
+
+/**
+ * Read the collisions baked for a cooked map, and its solid cell masks, into the state of the map.
+ *
+ * Nothing is read when the map was cooked with another RAYLIB_TMX_CHUNK_SIZE, so that the
+ * collisions are baked again instead.
+ *
+ * @internal
+ */
+void ReadTMXCookedCollisions(RaylibTMXReader *reader, tmx_map *map, RaylibTMXState *state) {
+    char *property = ReadTMXCookedString(reader);
+    if (property != NULL) {
+        state->solidProperty = (char *)MemAlloc((unsigned int)strlen(property) + 1);
+        strcpy(state->solidProperty, property);
+    }
+    if (ReadTMXCookedU32(reader) != RAYLIB_TMX_CHUNK_SIZE || reader->failed) return;
+    unsigned char *solidTiles = ReadTMXCookedBytes(reader, map->tilecount);
+    ReadTMXCookedBytes(reader, (4 - map->tilecount % 4) % 4);
+    if (solidTiles == NULL) return;
+    state->solidTiles = (unsigned char *)MemAlloc(map->tilecount + 1);
+    memcpy(state->solidTiles, solidTiles, map->tilecount);
+
+    // The first mask is the one of all visible tile layers, then come the masks of each tile layer.
+    int stride = ((int)map->width + 63) / 64;
+    size_t words = (size_t)stride * map->height + 1;
+    uint32_t maskCount = ReadTMXCookedU32(reader);
+    if (maskCount == 0 || maskCount > (reader->size - reader->at) / 8) reader->failed = true;
+    RaylibTMXSolidMask **maskLink = &state->solidMasks;
+    for (uint32_t m = 0; m < maskCount && !reader->failed; m++) {
+        int index = ReadTMXCookedI32(reader);
+        bool combined = ReadTMXCookedI32(reader) != 0;
+        tmx_layer *layer = (index >= 0) ? GetTMXCookedLayer(map->ly_head, &index) : NULL;
+        if ((m == 0) != (layer == NULL) || (layer != NULL && layer->type != L_LAYER)) reader->failed = true;
+        ReadTMXCookedBytes(reader, reader->at % 8);
+        if (words > (reader->size - reader->at) / 8) reader->failed = true;
+        unsigned char *bytes = ReadTMXCookedBytes(reader, words * 8);
+        if (reader->failed) break;
+        uint64_t *bits = (uint64_t *)bytes;
+        const uint16_t endianness = 1;
+        if (*(const unsigned char *)&endianness == 0) {
+            for (size_t i = 0; i < words; i++) {
+                uint64_t word = 0;
+                for (int k = 7; k >= 0; k--) word = (word << 8) | bytes[i * 8 + (size_t)k];
+                bits[i] = word;
+            }
+        }
+
+        RaylibTMXSolidMask *mask = (RaylibTMXSolidMask *)MemAlloc(sizeof(RaylibTMXSolidMask));
+        mask->layer = layer;
+        mask->width = (int)map->width;
+        mask->height = (int)map->height;
+        mask->cellWidth = (float)map->tile_width;
+        mask->cellHeight = (float)map->tile_height;
+        mask->stride = stride;
+        mask->bits = bits;
+        mask->combined = combined;
+        mask->cooked = true;
+        *maskLink = mask;
+        maskLink = &mask->next;
+    }
+
+    uint32_t layerCount = ReadTMXCookedU32(reader);
+    RaylibTMXLayerColliders **link = &state->layerColliders;
+    for (uint32_t l = 0; l < layerCount && !reader->failed; l++) {
+        int index = ReadTMXCookedI32(reader);
+        tmx_layer *layer = (index >= 0) ? GetTMXCookedLayer(map->ly_head, &index) : NULL;
+        if (layer == NULL || (layer->type != L_LAYER && layer->type != L_OBJGR)) {
+            reader->failed = true;
+            break;
+        }
+        RaylibTMXLayerColliders *colliders = (RaylibTMXLayerColliders *)MemAlloc(sizeof(RaylibTMXLayerColliders));
+        colliders->layer = layer;
+        colliders->chunksX = (layer->type == L_LAYER) ? ((int)map->width + RAYLIB_TMX_CHUNK_SIZE - 1) / RAYLIB_TMX_CHUNK_SIZE : 1;
+        colliders->chunksY = (layer->type == L_LAYER) ? ((int)map->height + RAYLIB_TMX_CHUNK_SIZE - 1) / RAYLIB_TMX_CHUNK_SIZE : 1;
+        colliders->blocks = (RaylibTMXColliderBlock *)MemAlloc((unsigned int)(colliders->chunksX * colliders->chunksY) * sizeof(RaylibTMXColliderBlock));
+        *link = colliders;
+        link = &colliders->next;
+        for (int b = 0; b < colliders->chunksX * colliders->chunksY && !reader->failed; b++) {
+            ReadTMXCookedColliderBlock(reader, map, colliders, b);
+            // The chunks are unloaded like baked ones once a cache budget is set.
+            if (layer->type == L_LAYER && !reader->failed) GetTMXColliderChunk(map, state, colliders, b % colliders->chunksX, b / colliders->chunksX);
+        }
+        if (layer->type == L_OBJGR && !reader->failed) BinTMXObjectColliders(map, colliders);
+    }
+}
+
+/**
+ * Report the collisions of the map that overlap the given rectangle.
+ *
+ * Only the tile layer cells under the rectangle, and the objects indexed in the grid buckets it
+ * touches, are visited. The callback receives the same values as with CollisionsTMXForeach().
+ *
+ * @param map       The map holding the collisions.
+ * @param rect      The area to look for collisions in, in map coordinates.
+ * @param callback  The function called for each collision found.
+ * @param userdata  The userdata passed to the callback.
+ *
+ * @see UpdateTMXCollisionIndex()
+ */
+void QueryTMXCollisionsRect(tmx_map *map, Rectangle rect, tmx_collision_functor callback, void* userdata) {
+    if (map == NULL || callback == NULL) return;
+    RaylibTMXState *state = GetTMXState(map, true);
+    if (!state->indexLoaded) UpdateTMXCollisionIndex(map);
+    EvictTMXColliderChunks(state);
+
+    for (RaylibTMXLayerColliders *colliders = state->layerColliders; colliders != NULL; colliders = colliders->next) {
+        if (!colliders->layer->visible || colliders->layer->type != L_LAYER) continue;
+
+        // Tile collisions stay within their tile, which may be larger than the map grid.
+        int startX, startY, endX, endY;
+        GetTMXLayerCellRange(map, 0, 0, rect, &startX, &startY, &endX, &endY);
+        for (int y = startY; y < endY; y++) {
+            for (int x = startX; x < endX; x++) {
+                int count;
+                const RaylibTMXCollider *cell = GetTMXChunkCellColliders(map, state, colliders, x, y, &count);
+                ReportTMXColliders(cell, count, &rect, callback, userdata);
+            }
+        }
+    }
+
+    // Objects spanning several buckets are only reported once, thanks to the query stamps.
+    unsigned int stamp = ++state->indexStamp;
+    if (stamp == 0) {
+        for (int i = 0; i < state->indexObjectCount; i++) state->indexStamps[i] = 0;
+        stamp = ++state->indexStamp;
+    }
+    int minX, minY, maxX, maxY;
+    GetTMXIndexBucketRange(state, rect, &minX, &minY, &maxX, &maxY);
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x++) {
+            int bucket = y * state->indexBucketsX + x;
+            for (int entry = state->indexBucketStarts[bucket]; entry < state->indexBucketStarts[bucket + 1]; entry++) {
+                int i = state->indexEntries[entry];
+                if (state->indexStamps[i] == stamp) continue;
+                state->indexStamps[i] = stamp;
+                if (!CheckTMXBoundsOverlap(state->indexBounds[i], rect)) continue;
+                ReportTMXColliders(state->indexColliders[i], state->indexColliderCounts[i], &rect, callback, userdata);
+            }
+        }
+    }
+}
+
+/**
+ * Report the collisions of the map whose bounds hold the given point.
+ *
+ * The callback still has to check the exact shape of each collision, for example with
+ * CheckCollisionPointPoly().
+ *
+ * @param map       The map holding the collisions.
+ * @param point     The point to look for collisions at, in map coordinates.
+ * @param callback  The function called for each collision found.
+ * @param userdata  The userdata passed to the callback.
+ */
+void QueryTMXCollisionsPoint(tmx_map *map, Vector2 point, tmx_collision_functor callback, void* userdata) {
+    QueryTMXCollisionsRect(map, (Rectangle){point.x, point.y, 0.0f, 0.0f}, callback, userdata);
+}
+
+/**
+ * The hits found by a batched collision query, and the rectangle being tested.
+ *
+ * @internal
+ */
+typedef struct RaylibTMXHitList {
+    RaylibTMXCollisionHit *hits;
+    int maxHits;
+    int count;                          // Hits found, which may be more than the hits stored
+    int index;                          // Index of the rectangle being tested
+} RaylibTMXHitList;
+
+/**
+ * Get the position of the lowest set bit of a mask that isn't zero.
+ *
+ * @internal
+ */
+int GetTMXLowestBit(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/**
+ * Add the collider of a bounds entry to the hits of a batched query.
+ *
+ * @param indices The collider of each entry, or NULL when the entries are the colliders.
+ *
+ * @internal
+ */
+void AddTMXCollisionHit(RaylibTMXHitList *list, const RaylibTMXCollider *colliders, const int *indices, int entry) {
+    if (list->count < list->maxHits) {
+        list->hits[list->count] = (RaylibTMXCollisionHit){list->index, colliders + (indices ? indices[entry] : entry)};
+    }
+    list->count++;
+}
+
+/**
+ * Add the hits of the bounds entries, from start to end, that overlap a rectangle.
+ *
+ * The bounds are tested eight at a time with AVX, or four at a time with SSE2, and the rest one at a
+ * time. The test matches CheckTMXBoundsOverlap(), so the hits are the ones QueryTMXCollisionsRect() reports.
+ *
+ * @internal
+ */
+void FindTMXBoxOverlaps(const RaylibTMXBoxes *boxes, int start, int end, Rectangle rect, const RaylibTMXCollider *colliders, const int *indices, RaylibTMXHitList *list) {
+    float rectMinX = rect.x;
+    float rectMinY = rect.y;
+    float rectMaxX = rect.x + rect.width;
+    float rectMaxY = rect.y + rect.height;
+    int i = start;
+
+#if defined(RAYLIB_TMX_AVX)
+    __m256 minX8 = _mm256_set1_ps(rectMinX);
+    __m256 minY8 = _mm256_set1_ps(rectMinY);
+    __m256 maxX8 = _mm256_set1_ps(rectMaxX);
+    __m256 maxY8 = _mm256_set1_ps(rectMaxY);
+    for (; i + 8 <= end; i += 8) {
+        __m256 overlapX = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(boxes->minX + i), maxX8, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(boxes->maxX + i), minX8, _CMP_GE_OQ));
+        __m256 overlapY = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(boxes->minY + i), maxY8, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(boxes->maxY + i), minY8, _CMP_GE_OQ));
+        unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_and_ps(overlapX, overlapY));
+        while (mask != 0) {
+            AddTMXCollisionHit(list, colliders, indices, i + GetTMXLowestBit(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+#if defined(RAYLIB_TMX_SSE)
+    __m128 minX4 = _mm_set1_ps(rectMinX);
+    __m128 minY4 = _mm_set1_ps(rectMinY);
+    __m128 maxX4 = _mm_set1_ps(rectMaxX);
+    __m128 maxY4 = _mm_set1_ps(rectMaxY);
+    for (; i + 4 <= end; i += 4) {
+        __m128 overlapX = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes->minX + i), maxX4), _mm_cmpge_ps(_mm_loadu_ps(boxes->maxX + i), minX4));
+        __m128 overlapY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes->minY + i), maxY4), _mm_cmpge_ps(_mm_loadu_ps(boxes->maxY + i), minY4));
+        unsigned int mask = (unsigned int)_mm_movemask_ps(_mm_and_ps(overlapX, overlapY));
+        while (mask != 0) {
+            AddTMXCollisionHit(list, colliders, indices, i + GetTMXLowestBit(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for (; i < end; i++) {
+        if (boxes->minX[i] <= rectMaxX && boxes->maxX[i] >= rectMinX && boxes->minY[i] <= rectMaxY && boxes->maxY[i] >= rectMinY) {
+            AddTMXCollisionHit(list, colliders, indices, i);
+        }
+    }
+}
+
+/**
+ * Add the hits of the map's collisions that overlap a rectangle.
+ *
+ * The colliders of a row of cells within a chunk, and of a row of object bins, are contiguous, so
+ * each row is a single run of bounds tests.
+ *
+ * @internal
+ */
+void FindTMXCollisionHits(tmx_map *map, RaylibTMXState *state, Rectangle rect, RaylibTMXHitList *list) {
+    for (RaylibTMXLayerColliders *colliders = state->layerColliders; colliders != NULL; colliders = colliders->next) {
+        if (!colliders->layer->visible) continue;
+
+        if (colliders->layer->type == L_LAYER) {
+            int startX, startY, endX, endY;
+            GetTMXLayerCellRange(map, 0, 0, rect, &startX, &startY, &endX, &endY);
+            for (int y = startY; y < endY; y++) {
+                int chunkY = y / RAYLIB_TMX_CHUNK_SIZE;
+                int row = (y - chunkY * RAYLIB_TMX_CHUNK_SIZE) * RAYLIB_TMX_CHUNK_SIZE;
+                for (int x = startX; x < endX; ) {
+                    int chunkX = x / RAYLIB_TMX_CHUNK_SIZE;
+                    int last = (chunkX + 1) * RAYLIB_TMX_CHUNK_SIZE;
+                    if (last > endX) last = endX;
+                    RaylibTMXColliderBlock *block = GetTMXColliderChunk(map, state, colliders, chunkX, chunkY);
+                    int first = block->starts[row + x - chunkX * RAYLIB_TMX_CHUNK_SIZE];
+                    int end = block->starts[row + last - chunkX * RAYLIB_TMX_CHUNK_SIZE];
+                    FindTMXBoxOverlaps(&block->boxes, first, end, rect, block->colliders, NULL, list);
+                    x = last;
+                }
+            }
+        }
+        else if (colliders->binStarts != NULL) {
+            int minX = (int)fminf(fmaxf(floorf((rect.x - colliders->binWidth) / colliders->binWidth), 0.0f), (float)(colliders->binsX - 1));
+            int minY = (int)fminf(fmaxf(floorf((rect.y - colliders->binHeight) / colliders->binHeight), 0.0f), (float)(colliders->binsY - 1));
+            int maxX = (int)fminf(fmaxf(floorf((rect.x + rect.width) / colliders->binWidth), 0.0f), (float)(colliders->binsX - 1));
+            int maxY = (int)fminf(fmaxf(floorf((rect.y + rect.height) / colliders->binHeight), 0.0f), (float)(colliders->binsY - 1));
+            for (int y = minY; y <= maxY; y++) {
+                int first = colliders->binStarts[y * colliders->binsX + minX];
+                int end = colliders->binStarts[y * colliders->binsX + maxX + 1];
+                FindTMXBoxOverlaps(&colliders->binBoxes, first, end, rect, colliders->blocks->colliders, colliders->binColliders, list);
+            }
+            int binCount = colliders->binsX * colliders->binsY;
+            FindTMXBoxOverlaps(&colliders->binBoxes, colliders->binStarts[binCount], colliders->binStarts[binCount + 1], rect, colliders->blocks->colliders, colliders->binColliders, list);
+        }
+    }
+}
+
+/**
+ * Find the collisions of the map that overlap each of the given rectangles, in a single call.
+ *
+ * Meant for testing many entities every frame: the bounds of the colliders are tested several at a
+ * time with SSE2 or AVX, when available, and no callback is called. The hits of each rectangle
+ * are stored in order, and hold the same collisions QueryTMXCollisionsRect() reports for it,
+ * without the check against the whole bounds of the objects.
+ *
+ * @param map     The map holding the collisions.
+ * @param rects   The areas to look for collisions in, in map coordinates.
+ * @param count   The number of rectangles.
+ * @param hits    Where to store the hits, as pairs of rectangle index and collision.
+ * @param maxHits The number of hits that fit in hits.
+ *
+ * @return The number of hits found, which is larger than maxHits when they didn't all fit.
+ *
+ * @see QueryTMXCollisionsPoints()
+ */
+int QueryTMXCollisionsRects(tmx_map *map, const Rectangle *rects, int count, RaylibTMXCollisionHit *hits, int maxHits) {
+    if (map == NULL || rects == NULL) return 0;
+    RaylibTMXState *state = GetTMXState(map, true);
+    if (!state->indexLoaded) UpdateTMXCollisionIndex(map);
+    EvictTMXColliderChunks(state);
+
+    RaylibTMXHitList list = {hits, (hits != NULL) ? maxHits : 0, 0, 0};
+    for (list.index = 0; list.index < count; list.index++) {
+        FindTMXCollisionHits(map, state, rects[list.index], &list);
+    }
+    return list.count;
+}
+
+/**
+ * Find the collisions of the map whose bounds hold each of the given points, in a single call.
+ *
+ * @param map     The map holding the collisions.
+ * @param points  The points to look for collisions at, in map coordinates.
+ * @param count   The number of points.
+ * @param hits    Where to store the hits, as pairs of point index and collision.
+ * @param maxHits The number of hits that fit in hits.
+ *
+ * @return The number of hits found, which is larger than maxHits when they didn't all fit.
+ *
+ * @see QueryTMXCollisionsRects()
+ */
+int QueryTMXCollisionsPoints(tmx_map *map, const Vector2 *points, int count, RaylibTMXCollisionHit *hits, int maxHits) {
+    if (map == NULL || points == NULL) return 0;
+    RaylibTMXState *state = GetTMXState(map, true);
+    if (!state->indexLoaded) UpdateTMXCollisionIndex(map);
+    EvictTMXColliderChunks(state);
+
+    RaylibTMXHitList list = {hits, (hits != NULL) ? maxHits : 0, 0, 0};
+    for (list.index = 0; list.index < count; list.index++) {
+        FindTMXCollisionHits(map, state, (Rectangle){points[list.index].x, points[list.index].y, 0.0f, 0.0f}, &list);
+    }
+    return list.count;
+}
+
+/**
+ * Make the tiles holding the given tile property solid, rather than the tiles with collisions.
+ *
+ * The property is true for solid tiles, either as a boolean or as a non-zero integer. The solid cell
+ * masks of the map are built again right away.
+ *
+ * @param map      The map to change.
+ * @param property The name of the tile property, or NULL to use the tile collisions again.
+ *
+ * @see IsTMXCellSolid()
+ */
+void SetTMXSolidProperty(tmx_map *map, const char *property) {
+    if (map == NULL) return;
+    RaylibTMXState *state = GetTMXState(map, true);
+    MemFree(state->solidProperty);
+    state->solidProperty = NULL;
+    if (property != NULL) {
+        state->solidProperty = (char *)MemAlloc((unsigned int)strlen(property) + 1);
+        strcpy(state->solidProperty, property);
+    }
+    if (!state->indexLoaded) return;
+    UnloadTMXSolidMasks(state);
+    LoadTMXSolidMasks(map, state);
+}
+
+/**
+ * Find the solid mask of a tile layer, or of all visible tile layers, loading the masks when needed.
+ *
+ * @internal
+ */
+const RaylibTMXSolidMask *GetTMXSolidMask(tmx_map *map, tmx_layer *layer) {
+    if (map == NULL) return NULL;
+    RaylibTMXState *state = GetTMXState(map, true);
+    if (!state->indexLoaded) UpdateTMXCollisionIndex(map);
+    RaylibTMXSolidMask *mask = state->solidMasks;
+    while (mask && mask->layer != layer) mask = mask->next;
+    return mask;
+}
+
+/**
+ * Check whether a cell holds a solid tile.
+ *
+ * A tile is solid when it has collisions, or the property set with SetTMXSolidProperty(). The
+ * answer comes from a bit mask built with the collisions, so it doesn't look at the tile at all.
+ * Tile layers within groups are included, and are part of the visible layers when their groups are too.
+ *
+ * @param map   The map holding the layer.
+ * @param layer The tile layer, or NULL for any of the tile layers that were visible when loading the map.
+ * @param x     The column of the cell.
+ * @param y     The row of the cell.
+ *
+ * @return True when the cell is solid, false when it's not or it's outside of the map.
+ */
+bool IsTMXCellSolid(tmx_map *map, tmx_layer *layer, int x, int y) {
+    const RaylibTMXSolidMask *mask = GetTMXSolidMask(map, layer);
+    return mask != NULL && IsTMXSolidMaskCell(mask, x, y);
+}
+
+/**
+ * Find the first solid cell that a line crosses, walking the grid one cell at a time.
+ *
+ * The line is clipped to the map first, so only the cells it crosses within the map are visited.
+ * Cells are in map coordinates, with the tile size of the map, as with IsTMXCellSolid(). Only
+ * orthogonal maps are laid out this way, so the line never hits anything on other maps.
+ *
+ * @param map   The map holding the layer.
+ * @param layer The tile layer, or NULL for any of the visible tile layers.
+ * @param start Where the line starts, in map coordinates.
+ * @param end   Where the line ends, in map coordinates.
+ *
+ * @return The first solid cell crossed, with hit set to false when the line of sight is clear.
+ */
+RaylibTMXRayHit RaycastTMX(tmx_map *map, tmx_layer *layer, Vector2 start, Vector2 end) {
+    RaylibTMXRayHit result = {0};
+    const RaylibTMXSolidMask *mask = GetTMXSolidMask(map, layer);
+    if (mask == NULL || !IsTMXOrthogonal(map) || mask->width == 0 || mask->height == 0) return result;
+
+    float origin[2] = {start.x, start.y};
+    float delta[2] = {end.x - start.x, end.y - start.y};
+    float size[2] = {mask->cellWidth, mask->cellHeight};
+    int cells[2] = {mask->width, mask->height};
+
+    // Clip the line to the map, remembering the side it enters through.
+    float enter = 0.0f;
+    float leave = 1.0f;
+    int axis = -1;
+    for (int i = 0; i < 2; i++) {
+        float extent = (float)cells[i] * size[i];
+        if (delta[i] == 0.0f) {
+            if (origin[i] < 0.0f || origin[i] >= extent) return result;
+            continue;
+        }
+        float near = (((delta[i] > 0.0f) ? 0.0f : extent) - origin[i]) / delta[i];
+        float far = (((delta[i] > 0.0f) ? extent : 0.0f) - origin[i]) / delta[i];
+        if (near > enter) {
+            enter = near;
+            axis = i;
+        }
+        if (far < leave) leave = far;
+    }
+    if (enter > leave) return result;
+
+    int cell[2], step[2];
+    float next[2], span[2];
+    for (int i = 0; i < 2; i++) {
+        float position = origin[i] + delta[i] * enter;
+        cell[i] = (int)fminf(fmaxf(floorf(position / size[i]), 0.0f), (float)(cells[i] - 1));
+        if (i == axis) cell[i] = (delta[i] > 0.0f) ? 0 : cells[i] - 1;
+        step[i] = (delta[i] > 0.0f) ? 1 : -1;
+        next[i] = (delta[i] != 0.0f) ? ((float)(cell[i] + (delta[i] > 0.0f)) * size[i] - origin[i]) / delta[i] : FLT_MAX;
+        span[i] = (delta[i] != 0.0f) ? size[i] / fabsf(delta[i]) : FLT_MAX;
+    }
+
+    float t = enter;
+    for (;;) {
+        if (IsTMXSolidMaskCell(mask, cell[0], cell[1])) {
+            result.hit = true;
+            result.distance = t * sqrtf(delta[0] * delta[0] + delta[1] * delta[1]);
+            result.point = (Vector2){start.x + delta[0] * t, start.y + delta[1] * t};
+            if (axis == 0) result.normal.x = (float)-step[0];
+            if (axis == 1) result.normal.y = (float)-step[1];
+            result.x = cell[0];
+            result.y = cell[1];
+            return result;
+        }
+        axis = (next[0] < next[1]) ? 0 : 1;
+        t = next[axis];
+        if (t > leave) break;
+        cell[axis] += step[axis];
+        if (cell[axis] < 0 || cell[axis] >= cells[axis]) break;
+        next[axis] += span[axis];
+    }
+    return result;
+}
+
+/**
+ * Check whether any cell of a column, or of a row, of a solid mask is solid.
+ *
+ * @internal
+ */
+bool IsTMXSolidMaskLine(const RaylibTMXSolidMask *mask, bool row, int line, int from, int to) {
+    for (int i = from; i <= to; i++) {
+        if (row ? IsTMXSolidMaskCell(mask, i, line) : IsTMXSolidMaskCell(mask, line, i)) return true;
+    }
+    return false;
+}
+
+/**
+ * Move a span along one axis of a solid mask, stopping it against the first solid line of cells.
+ *
+ * @param vertical Whether the span moves along the rows, rather than the columns.
+ * @param position Where the span starts, on the axis it moves along.
+ * @param size     The length of the span on that axis.
+ * @param across   Where the span starts on the other axis.
+ * @param width    The length of the span on the other axis.
+ * @param motion   How far to move the span along its axis, negative to move it backwards.
+ * @param blocked  Set to true when a solid cell stopped the span.
+ *
+ * @return The position the span moved to.
+ *
+ * @internal
+ */
+float SweepTMXSolidMask(const RaylibTMXSolidMask *mask, bool vertical, float position, float size, float across, float width, float motion, bool *blocked) {
+    float cell = vertical ? mask->cellHeight : mask->cellWidth;
+    float crossCell = vertical ? mask->cellWidth : mask->cellHeight;
+    int lines = vertical ? mask->height : mask->width;
+    int crossLines = vertical ? mask->width : mask->height;
+
+    // Cells the span only touches, within the epsilon, don't stop it.
+    int from = (int)fmaxf(floorf((across + RAYLIB_TMX_MOVE_EPSILON) / crossCell), 0.0f);
+    int to = (int)fminf(ceilf((across + width - RAYLIB_TMX_MOVE_EPSILON) / crossCell) - 1.0f, (float)(crossLines - 1));
+    if (to < from && width <= 2.0f * RAYLIB_TMX_MOVE_EPSILON) to = from;
+    if (motion == 0.0f || from > to) return position + motion;
+
+    if (motion > 0.0f) {
+        float edge = position + size;
+        int first = (int)fmaxf(ceilf((edge - RAYLIB_TMX_MOVE_EPSILON) / cell), 0.0f);
+        int last = (int)fminf(ceilf((edge + motion - RAYLIB_TMX_MOVE_EPSILON) / cell) - 1.0f, (float)(lines - 1));
+        for (int line = first; line <= last; line++) {
+            if (!IsTMXSolidMaskLine(mask, vertical, line, from, to)) continue;
+            *blocked = true;
+            return (float)line * cell - size;
+        }
+    }
+    else {
+        int first = (int)fminf(floorf((position + RAYLIB_TMX_MOVE_EPSILON) / cell) - 1.0f, (float)(lines - 1));
+        int last = (int)fmaxf(floorf((position + motion + RAYLIB_TMX_MOVE_EPSILON) / cell), 0.0f);
+        for (int line = first; line >= last; line--) {
+            if (!IsTMXSolidMaskLine(mask, vertical, line, from, to)) continue;
+            *blocked = true;
+            return (float)(line + 1) * cell;
+        }
+    }
+    return position + motion;
+}
+
+/**
+ * Move a rectangle by the given motion, stopping it against the solid cells it would run into.
+ *
+ * The rectangle moves along x first, then along y, checking every line of cells it sweeps over,
+ * so fast movements don't pass through thin walls. A rectangle stopped by a cell is placed flush
+ * against it, and cells it's already overlapping don't stop it, so it can move out of them. The
+ * cells are only laid out on a grid of tiles in orthogonal maps, so on other maps the rectangle
+ * doesn't move at all.
+ *
+ * @param map    The map holding the layer.
+ * @param layer  The tile layer, or NULL for any of the visible tile layers.
+ * @param rect   The rectangle to move, in map coordinates.
+ * @param motion How far to move the rectangle.
+ * @param normal When not NULL, set to the sides of the cells that stopped the rectangle, zero when it moved freely.
+ *
+ * @return The rectangle at its new position.
+ */
+Rectangle MoveTMXRect(tmx_map *map, tmx_layer *layer, Rectangle rect, Vector2 motion, Vector2 *normal) {
+    Vector2 hitNormal = {0.0f, 0.0f};
+    const RaylibTMXSolidMask *mask = GetTMXSolidMask(map, layer);
+    if (mask == NULL) {
+        rect.x += motion.x;
+        rect.y += motion.y;
+    }
+    else if (IsTMXOrthogonal(map)) {
+        bool blocked = false;
+        rect.x = SweepTMXSolidMask(mask, false, rect.x, rect.width, rect.y, rect.height, motion.x, &blocked);
+        if (blocked) hitNormal.x = (motion.x > 0.0f) ? -1.0f : 1.0f;
+        blocked = false;
+        rect.y = SweepTMXSolidMask(mask, true, rect.y, rect.height, rect.x, rect.width, motion.y, &blocked);
+        if (blocked) hitNormal.y = (motion.y > 0.0f) ? -1.0f : 1.0f;
+    }
+    if (normal != NULL) *normal = hitNormal;
+    return rect;
+}
+
+/**
+ * Check whether a path can go through a cell of a search grid.
+ *
+ * @internal
+ */
+bool IsTMXPathOpen(const RaylibTMXPathGrid *grid, int x, int y) {
+    if (x < grid->minX || y < grid->minY || x > grid->maxX || y > grid->maxY) return false;
+    return !IsTMXSolidMaskCell(grid->mask, x, y);
+}
+
+/**
+ * Check whether a path can step from a cell to its neighbor in the given direction. Diagonal steps
+ * need both cells beside them to be open, so that paths don't cut the corners of solid cells.
+ *
+ * @internal
+ */
+bool CanTMXPathStep(const RaylibTMXPathGrid *grid, int x, int y, int dx, int dy) {
+    if (!IsTMXPathOpen(grid, x + dx, y + dy)) return false;
+    return dx == 0 || dy == 0 || (IsTMXPathOpen(grid, x + dx, y) && IsTMXPathOpen(grid, x, y + dy));
+}
+
+/**
+ * Get the length of the shortest path between two cells with no solid cells in the way.
+ *
+ * @internal
+ */
+float GetTMXPathDistance(int fromX, int fromY, int toX, int toY) {
+    int dx = abs(toX - fromX);
+    int dy = abs(toY - fromY);
+    return (dx > dy) ? (float)dx + 0.41421356f * (float)dy : (float)dy + 0.41421356f * (float)dx;
+}
+
+/**
+ * Prepare a search over the given amount of cells or graph nodes, forgetting the previous one.
+ *
+ * @internal
+ */
+void BeginTMXPathSearch(RaylibTMXPathSearch *search, int capacity) {
+    if (capacity > search->capacity) {
+        MemFree(search->costs);
+        MemFree(search->parents);
+        MemFree(search->stamps);
+        search->capacity = capacity;
+        search->costs = (float *)MemAlloc((unsigned int)capacity * sizeof(float));
+        search->parents = (int *)MemAlloc((unsigned int)capacity * sizeof(int));
+        search->stamps = (unsigned int *)MemAlloc((unsigned int)capacity * sizeof(unsigned int));
+        search->stamp = 0;
+    }
+    if (search->stamp >= 0xFFFFFFFFu - 2) {
+        memset(search->stamps, 0, (size_t)search->capacity * sizeof(unsigned int));
+        search->stamp = 0;
+    }
+    search->stamp += 2;
+    search->heapCount = 0;
+}
+
+/**
+ * Reach a node of a search, keeping the cheaper cost when it was reached before.
+ *
+ * @internal
+ */
+void VisitTMXPathNode(RaylibTMXPathSearch *search, int node, float cost, int parent, float estimate) {
+    if (search->stamps[node] == search->stamp + 1) return;
+    if (search->stamps[node] == search->stamp && cost >= search->costs[node]) return;
+    search->stamps[node] = search->stamp;
+    search->costs[node] = cost;
+    search->parents[node] = parent;
+
+    if (search->heapCount == search->heapCapacity) {
+        search->heapCapacity = (search->heapCapacity == 0) ? 256 : search->heapCapacity * 2;
+        search->heap = (RaylibTMXPathHeapItem *)MemRealloc(search->heap, (unsigned int)search->heapCapacity * sizeof(RaylibTMXPathHeapItem));
+    }
+    int i = search->heapCount++;
+    RaylibTMXPathHeapItem item = {cost + estimate, node};
+    while (i > 0 && search->heap[(i - 1) / 2].estimate > item.estimate) {
+        search->heap[i] = search->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    search->heap[i] = item;
+}
+
+/**
+ * Take the open node with the lowest estimate out of a search, and close it.
+ *
+ * @return The node, or -1 when none are left.
+ *
+ * @internal
+ */
+int PopTMXPathNode(RaylibTMXPathSearch *search) {
+    while (search->heapCount > 0) {
+        int node = search->heap[0].node;
+        RaylibTMXPathHeapItem last = search->heap[--search->heapCount];
+        int i = 0;
+        for (;;) {
+            int child = i * 2 + 1;
+            if (child >= search->heapCount) break;
+            if (child + 1 < search->heapCount && search->heap[child + 1].estimate < search->heap[child].estimate) child++;
+            if (search->heap[child].estimate >= last.estimate) break;
+            search->heap[i] = search->heap[child];
+            i = child;
+        }
+        if (search->heapCount > 0) search->heap[i] = last;
+
+        // Nodes reached again at a lower cost leave their older entries behind.
+        if (search->stamps[node] == search->stamp + 1) continue;
+        search->stamps[node] = search->stamp + 1;
+        return node;
+    }
+    return -1;
+}
+
+/**
+ * Find the cost of the shortest path from a cell to every cell of a grid it can reach.
+ *
+ * @internal
+ */
+void FloodTMXPathGrid(RaylibTMXPathSearch *search, const RaylibTMXPathGrid *grid, int start) {
+    int width = grid->mask->width;
+    BeginTMXPathSearch(search, width * grid->mask->height);
+    VisitTMXPathNode(search, start, 0.0f, -1, 0.0f);
+    for (int cell = PopTMXPathNode(search); cell >= 0; cell = PopTMXPathNode(search)) {
+        int x = cell % width;
+        int y = cell / width;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if ((dx == 0 && dy == 0) || !CanTMXPathStep(grid, x, y, dx, dy)) continue;
+                float step = (dx != 0 && dy != 0) ? 1.41421356f : 1.0f;
+                VisitTMXPathNode(search, cell + dy * width + dx, search->costs[cell] + step, cell, 0.0f);
+            }
+        }
+    }
+}
+
+/**
+ * Get the cost found for a cell by the last search, FLT_MAX when it wasn't reached.
+ *
+ * @internal
+ */
+float GetTMXPathCost(const RaylibTMXPathSearch *search, int node) {
+    return (search->stamps[node] == search->stamp + 1) ? search->costs[node] : FLT_MAX;
+}
+
+/**
+ * Walk from a cell in the given direction until reaching the goal, a solid cell, or a cell where the
+ * path may have to turn, as in jump point search with no corner cutting.
+ *
+ * @return The cell the walk stopped at, or -1 when it ran into a solid cell.
+ *
+ * @internal
+ */
+int JumpTMXPath(const RaylibTMXPathGrid *grid, int x, int y, int dx, int dy, int goalX, int goalY) {
+    for (;;) {
+        if (!IsTMXPathOpen(grid, x, y)) return -1;
+        if (x == goalX && y == goalY) break;
+        if (dx != 0 && dy != 0) {
+            // Diagonal walks stop where one of the straight walks they pass would stop.
+            if (JumpTMXPath(grid, x + dx, y, dx, 0, goalX, goalY) >= 0 || JumpTMXPath(grid, x, y + dy, 0, dy, goalX, goalY) >= 0) break;
+            if (!IsTMXPathOpen(grid, x + dx, y) || !IsTMXPathOpen(grid, x, y + dy)) return -1;
+        }
+        else if (dx != 0) {
+            if ((IsTMXPathOpen(grid, x, y - 1) && !IsTMXPathOpen(grid, x - dx, y - 1)) ||
+                (IsTMXPathOpen(grid, x, y + 1) && !IsTMXPathOpen(grid, x - dx, y + 1))) break;
+        }
+        else {
+            if ((IsTMXPathOpen(grid, x - 1, y) && !IsTMXPathOpen(grid, x - 1, y - dy)) ||
+                (IsTMXPathOpen(grid, x + 1, y) && !IsTMXPathOpen(grid, x + 1, y - dy))) break;
+        }
+        x += dx;
+        y += dy;
+    }
+    return y * grid->mask->width + x;
+}
+
+/**
+ * Walk from a cell of a jump point search in one direction, and reach the cell the walk stops at.
+ *
+ * @internal
+ */
+void JumpTMXPathFrom(RaylibTMXPathSearch *search, const RaylibTMXPathGrid *grid, int cell, int dx, int dy, int goalX, int goalY) {
+    int width = grid->mask->width;
+    int x = cell % width;
+    int y = cell / width;
+    if (!CanTMXPathStep(grid, x, y, dx, dy)) return;
+    int jump = JumpTMXPath(grid, x + dx, y + dy, dx, dy, goalX, goalY);
+    if (jump < 0) return;
+    float cost = search->costs[cell] + GetTMXPathDistance(x, y, jump % width, jump / width);
+    VisitTMXPathNode(search, jump, cost, cell, GetTMXPathDistance(jump % width, jump / width, goalX, goalY));
+}
+
+/**
+ * Find the shortest path between two cells of a grid with jump point search.
+ *
+ * Only the cells where the path may turn are visited, and kept as the parents of the cells of the
+ * path, so each step of the path from a cell to its parent is straight or diagonal.
+ *
+ * @return Whether the goal was reached.
+ *
+ * @internal
+ */
+bool SearchTMXPathGrid(RaylibTMXPathSearch *search, const RaylibTMXPathGrid *grid, int start, int goal) {
+    int width = grid->mask->width;
+    int goalX = goal % width;
+    int goalY = goal / width;
+    BeginTMXPathSearch(search, width * grid->mask->height);
+    VisitTMXPathNode(search, start, 0.0f, -1, GetTMXPathDistance(start % width, start / width, goalX, goalY));
+    for (int cell = PopTMXPathNode(search); cell >= 0; cell = PopTMXPathNode(search)) {
+        if (cell == goal) return true;
+        int x = cell % width;
+        int y = cell / width;
+        int parent = search->parents[cell];
+        if (parent < 0) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if (dx != 0 || dy != 0) JumpTMXPathFrom(search, grid, cell, dx, dy, goalX, goalY);
+                }
+            }
+            continue;
+        }
+
+        // Only the directions that a path coming from the parent may need to take are followed.
+        int dx = (x > parent % width) - (x < parent % width);
+        int dy = (y > parent / width) - (y < parent / width);
+        if (dx != 0 && dy != 0) {
+            JumpTMXPathFrom(search, grid, cell, 0, dy, goalX, goalY);
+            JumpTMXPathFrom(search, grid, cell, dx, 0, goalX, goalY);
+            JumpTMXPathFrom(search, grid, cell, dx, dy, goalX, goalY);
+        }
+        else if (dx != 0) {
+            JumpTMXPathFrom(search, grid, cell, dx, 0, goalX, goalY);
+            JumpTMXPathFrom(search, grid, cell, dx, 1, goalX, goalY);
+            JumpTMXPathFrom(search, grid, cell, dx, -1, goalX, goalY);
+            JumpTMXPathFrom(search, grid, cell, 0, 1, goalX, goalY);
+            JumpTMXPathFrom(search, grid, cell, 0, -1, goalX, goalY);
+        }
+        else {
+            JumpTMXPathFrom(search, grid, cell, 0, dy, goalX, goalY);
+            JumpTMXPathFrom(search, grid, cell, 1, dy, goalX, goalY);
+            JumpTMXPathFrom(search, grid, cell, -1, dy, goalX, goalY);
+            JumpTMXPathFrom(search, grid, cell, 1, 0, goalX, goalY);
+            JumpTMXPathFrom(search, grid, cell, -1, 0, goalX, goalY);
+        }
+    }
+    return false;
+}
+
+/**
+ * Add a cell to the route of a search, skipping it when it's already the last one.
+ *
+ * @internal
+ */
+void AddTMXPathRoute(RaylibTMXPathSearch *search, int cell) {
+    if (search->routeCount > 0 && search->route[search->routeCount - 1] == cell) return;
+    if (search->routeCount == search->routeCapacity) {
+        search->routeCapacity = (search->routeCapacity == 0) ? 64 : search->routeCapacity * 2;
+        search->route = (int *)MemRealloc(search->route, (unsigned int)search->routeCapacity * sizeof(int));
+    }
+    search->route[search->routeCount++] = cell;
+}
+
+/**
+ * Add the cells of the path found by the last jump point search, from its start to the given goal.
+ *
+ * @internal
+ */
+void AddTMXPathRouteCells(RaylibTMXPathSearch *search, int goal) {
+    int length = 0;
+    for (int cell = goal; cell >= 0; cell = search->parents[cell]) length++;
+    while (search->routeCount + length > search->routeCapacity) {
+        search->routeCapacity = (search->routeCapacity == 0) ? 64 : search->routeCapacity * 2;
+        search->route = (int *)MemRealloc(search->route, (unsigned int)search->routeCapacity * sizeof(int));
+    }
+    // Written back to front, then the start is dropped when it ends the route already.
+    int first = search->routeCount;
+    int i = first + length;
+    for (int cell = goal; cell >= 0; cell = search->parents[cell]) search->route[--i] = cell;
+    if (first > 0 && search->route[first - 1] == search->route[first]) {
+        memmove(&search->route[first], &search->route[first + 1], (size_t)(length - 1) * sizeof(int));
+        length--;
+    }
+    search->routeCount = first + length;
+}
+
+/**
+ * Get the rectangle of cells of a cluster of the pathfinding graph.
+ *
+ * @internal
+ */
+RaylibTMXPathGrid GetTMXPathClusterGrid(const RaylibTMXPathGraph *graph, int cluster) {
+    RaylibTMXPathGrid grid = {graph->mask, 0, 0, 0, 0};
+    grid.minX = (cluster % graph->clustersX) * RAYLIB_TMX_PATH_CLUSTER_SIZE;
+    grid.minY = (cluster / graph->clustersX) * RAYLIB_TMX_PATH_CLUSTER_SIZE;
+    grid.maxX = (int)fminf((float)(grid.minX + RAYLIB_TMX_PATH_CLUSTER_SIZE - 1), (float)(graph->mask->width - 1));
+    grid.maxY = (int)fminf((float)(grid.minY + RAYLIB_TMX_PATH_CLUSTER_SIZE - 1), (float)(graph->mask->height - 1));
+    return grid;
+}
+
+/**
+ * Get the cluster of the pathfinding graph holding a cell.
+ *
+ * @internal
+ */
+int GetTMXPathCluster(const RaylibTMXPathGraph *graph, int cell) {
+    int x = cell % graph->mask->width;
+    int y = cell / graph->mask->width;
+    return (y / RAYLIB_TMX_PATH_CLUSTER_SIZE) * graph->clustersX + (x / RAYLIB_TMX_PATH_CLUSTER_SIZE);
+}
+
+/**
+ * Get the cluster across a border of a cluster, north, east, south or west, or -1 at the edge of the map.
+ *
+ * @internal
+ */
+int GetTMXPathNeighbor(const RaylibTMXPathGraph *graph, int cluster, int border) {
+    int x = cluster % graph->clustersX;
+    int y = cluster / graph->clustersX;
+    if (border == 0) y--;
+    if (border == 1) x++;
+    if (border == 2) y++;
+    if (border == 3) x--;
+    if (x < 0 || y < 0 || x >= graph->clustersX || y >= graph->clustersY) return -1;
+    return y * graph->clustersX + x;
+}
+
+/**
+ * Add the entrances on a border of a cluster to its nodes.
+ *
+ * An entrance is placed in each opening where the cells on both sides of the border are open: in the
+ * middle of narrow openings, and at both ends of wider ones. Both clusters find the same entrances,
+ * in the same order, so the nth entrance of a border links to the nth entrance of the other side.
+ *
+ * @internal
+ */
+void AddTMXPathEntrances(RaylibTMXPathGraph *graph, int cluster, int border) {
+    RaylibTMXPathCluster *node = &graph->clusters[cluster];
+    if (GetTMXPathNeighbor(graph, cluster, border) < 0) return;
+
+    RaylibTMXPathGrid grid = GetTMXPathClusterGrid(graph, cluster);
+    bool vertical = (border == 1 || border == 3);
+    int line = (border == 0) ? grid.minY : (border == 1) ? grid.maxX : (border == 2) ? grid.maxY : grid.minX;
+    int across = (border == 0 || border == 3) ? -1 : 1;
+    int first = vertical ? grid.minY : grid.minX;
+    int last = vertical ? grid.maxY : grid.maxX;
+    int width = graph->mask->width;
+
+    int run = -1;
+    for (int i = first; i <= last + 1; i++) {
+        bool open = false;
+        if (i <= last) {
+            int x = vertical ? line : i;
+            int y = vertical ? i : line;
+            open = !IsTMXSolidMaskCell(graph->mask, x, y) && !IsTMXSolidMaskCell(graph->mask, vertical ? x + across : x, vertical ? y : y + across);
+        }
+        if (open && run < 0) run = i;
+        if (open || run < 0) continue;
+
+        int end = i - 1;
+        int entrances[2] = {run + (end - run) / 2, end};
+        int count = 1;
+        if (end - run + 1 >= RAYLIB_TMX_PATH_ENTRANCE_SPLIT) {
+            entrances[0] = run;
+            count = 2;
+        }
+        for (int e = 0; e < count; e++) {
+            node->nodeCells[node->nodeCount++] = vertical ? entrances[e] * width + line : line * width + entrances[e];
+        }
+        run = -1;
     }
+}
 
-    int flags = baseGid & ~TMX_FLIP_BITS_REMOVAL;
-    if  (flags) {
-        int is_horizontally_fliped = {
-            (int)((unsigned int)baseGid & TMX_FLIPPED_HORIZONTALLY)
-        };
-        if (is_horizontally_fliped) {
-		    srcRect.width = (float) -fabs(srcRect.width);
-	    }
-        int is_vertically_fliped = baseGid & TMX_FLIPPED_VERTICALLY;
-        if (is_vertically_fliped) {
-		    srcRect.height = (float) -fabs(srcRect.height);
-	    }
+/**
+ * Find the entrances of a cluster, and the shortest paths between them within the cluster.
+ *
+ * @internal
+ */
+void BuildTMXPathCluster(RaylibTMXPathGraph *graph, int cluster, RaylibTMXPathSearch *search) {
+    RaylibTMXPathCluster *node = &graph->clusters[cluster];
+    node->nodeCount = 0;
+    for (int border = 0; border < 4; border++) {
+        node->borderStarts[border] = node->nodeCount;
+        AddTMXPathEntrances(graph, cluster, border);
     }
+    node->borderStarts[4] = node->nodeCount;
 
-    // Find the image
-    tmx_image *im = tile->image;
+    int count = node->nodeCount;
+    MemFree(node->distances);
+    node->distances = (float *)MemAlloc((unsigned int)(count * count + 1) * sizeof(float));
+    RaylibTMXPathGrid grid = GetTMXPathClusterGrid(graph, cluster);
+    for (int i = 0; i < count; i++) {
+        FloodTMXPathGrid(search, &grid, node->nodeCells[i]);
+        for (int j = 0; j < count; j++) node->distances[i * count + j] = GetTMXPathCost(search, node->nodeCells[j]);
+    }
+    node->dirty = false;
+}
+
+/**
+ * Get the pathfinding graph of a map, building it, or the clusters that changed, as needed.
+ *
+ * @internal
+ */
+RaylibTMXPathGraph *GetTMXPathGraph(tmx_map *map) {
+    const RaylibTMXSolidMask *mask = GetTMXSolidMask(map, NULL);
+    if (mask == NULL || !IsTMXOrthogonal(map) || mask->width == 0 || mask->height == 0) return NULL;
+    RaylibTMXState *state = GetTMXState(map, false);
 
-    if (im && im->resource_image) {
-        image = (Texture*)im->resource_image;
-    } else if (tile->tileset->image->resource_image) {
-        image = (Texture*)tile->tileset->image->resource_image;
+    RaylibTMXPathGraph *graph = state->pathGraph;
+    if (graph == NULL) {
+        graph = (RaylibTMXPathGraph *)MemAlloc(sizeof(RaylibTMXPathGraph));
+        graph->mask = mask;
+        graph->clustersX = (mask->width + RAYLIB_TMX_PATH_CLUSTER_SIZE - 1) / RAYLIB_TMX_PATH_CLUSTER_SIZE;
+        graph->clustersY = (mask->height + RAYLIB_TMX_PATH_CLUSTER_SIZE - 1) / RAYLIB_TMX_PATH_CLUSTER_SIZE;
+        graph->clusters = (RaylibTMXPathCluster *)MemAlloc((unsigned int)(graph->clustersX * graph->clustersY) * sizeof(RaylibTMXPathCluster));
+        for (int i = 0; i < graph->clustersX * graph->clustersY; i++) graph->clusters[i].dirty = true;
+        graph->dirty = true;
+        state->pathGraph = graph;
+    }
+    if (graph->dirty) {
+        for (int i = 0; i < graph->clustersX * graph->clustersY; i++) {
+            if (graph->clusters[i].dirty) BuildTMXPathCluster(graph, i, &graph->searches[0]);
+        }
+        graph->dirty = false;
     }
+    return graph;
+}
 
-    if (image) DrawTexturePro(*image, srcRect, destRect, origin, rotation, tint);
+/**
+ * Get the node across the border from an entrance node of the pathfinding graph.
+ *
+ * Nodes are numbered cluster * RAYLIB_TMX_PATH_MAX_NODES + entrance.
+ *
+ * @internal
+ */
+int GetTMXPathLink(const RaylibTMXPathGraph *graph, int node) {
+    int cluster = node / RAYLIB_TMX_PATH_MAX_NODES;
+    int entrance = node % RAYLIB_TMX_PATH_MAX_NODES;
+    const RaylibTMXPathCluster *from = &graph->clusters[cluster];
+    int border = 0;
+    while (entrance >= from->borderStarts[border + 1]) border++;
+    int neighbor = GetTMXPathNeighbor(graph, cluster, border);
+    const RaylibTMXPathCluster *to = &graph->clusters[neighbor];
+    return neighbor * RAYLIB_TMX_PATH_MAX_NODES + to->borderStarts[(border + 2) % 4] + (entrance - from->borderStarts[border]);
 }
 
 /**
+ * Find a path between two cells through the clusters of the pathfinding graph, then refine each of
+ * its steps into cells with jump point searches within a single cluster.
+ *
+ * @return Whether a path was found, with its cells added to the route of the search.
+ *
  * @internal
  */
-void DrawTMXLayerTiles(tmx_map *map, tmx_layer *layer, int posX, int posY, Color tint) {
-    int startX = 0, startY = 0;
-    int endX = (int)map->width, endY = (int)map->height;
-    int incX = 1, incY = 1;
+bool SearchTMXPathGraph(RaylibTMXPathGraph *graph, RaylibTMXPathSearch *search, int start, int goal) {
+    int width = graph->mask->width;
+    int startCluster = GetTMXPathCluster(graph, start);
+    int goalCluster = GetTMXPathCluster(graph, goal);
+    const RaylibTMXPathCluster *from = &graph->clusters[startCluster];
+    const RaylibTMXPathCluster *to = &graph->clusters[goalCluster];
 
-    switch (map->renderorder)
-    {
-        case R_RIGHTUP: {
-            startY = (int)map->height - 1;
-            endY = -1;
-            incY = -1;
-        } break;
-        case R_LEFTDOWN: {
-            startX = (int)map->width - 1;
-            endX = -1;
-            incX = -1;
-        }  break;
-        case R_LEFTUP: {
-            startX = (int)map->width - 1;
-            startY = (int)map->height - 1;
-            endX = -1;
-            endY = -1;
-            incX = -1;
-            incY = -1;
-        } break;
-        case R_RIGHTDOWN:
-        case R_NONE: break;
+    // The start and the goal are linked to the entrances of their clusters, and to each other when they share one.
+    RaylibTMXPathGrid grid = GetTMXPathClusterGrid(graph, startCluster);
+    FloodTMXPathGrid(search, &grid, start);
+    for (int i = 0; i < from->nodeCount; i++) search->startCosts[i] = GetTMXPathCost(search, from->nodeCells[i]);
+    float direct = (startCluster == goalCluster) ? GetTMXPathCost(search, goal) : FLT_MAX;
+    grid = GetTMXPathClusterGrid(graph, goalCluster);
+    FloodTMXPathGrid(search, &grid, goal);
+    for (int i = 0; i < to->nodeCount; i++) search->goalCosts[i] = GetTMXPathCost(search, to->nodeCells[i]);
+
+    int nodeCount = graph->clustersX * graph->clustersY * RAYLIB_TMX_PATH_MAX_NODES;
+    int startNode = nodeCount;
+    int goalNode = nodeCount + 1;
+    int goalX = goal % width;
+    int goalY = goal / width;
+    BeginTMXPathSearch(search, nodeCount + 2);
+    VisitTMXPathNode(search, startNode, 0.0f, -1, GetTMXPathDistance(start % width, start / width, goalX, goalY));
+    int node;
+    while ((node = PopTMXPathNode(search)) >= 0 && node != goalNode) {
+        float cost = search->costs[node];
+        if (node == startNode) {
+            for (int i = 0; i < from->nodeCount; i++) {
+                if (search->startCosts[i] == FLT_MAX) continue;
+                int cell = from->nodeCells[i];
+                VisitTMXPathNode(search, startCluster * RAYLIB_TMX_PATH_MAX_NODES + i, search->startCosts[i], node, GetTMXPathDistance(cell % width, cell / width, goalX, goalY));
+            }
+            if (direct != FLT_MAX) VisitTMXPathNode(search, goalNode, direct, node, 0.0f);
+            continue;
+        }
+
+        int cluster = node / RAYLIB_TMX_PATH_MAX_NODES;
+        int entrance = node % RAYLIB_TMX_PATH_MAX_NODES;
+        const RaylibTMXPathCluster *current = &graph->clusters[cluster];
+        for (int i = 0; i < current->nodeCount; i++) {
+            float distance = current->distances[entrance * current->nodeCount + i];
+            if (i == entrance || distance == FLT_MAX) continue;
+            int cell = current->nodeCells[i];
+            VisitTMXPathNode(search, cluster * RAYLIB_TMX_PATH_MAX_NODES + i, cost + distance, node, GetTMXPathDistance(cell % width, cell / width, goalX, goalY));
+        }
+        int link = GetTMXPathLink(graph, node);
+        int linkCell = graph->clusters[link / RAYLIB_TMX_PATH_MAX_NODES].nodeCells[link % RAYLIB_TMX_PATH_MAX_NODES];
+        VisitTMXPathNode(search, link, cost + 1.0f, node, GetTMXPathDistance(linkCell % width, linkCell / width, goalX, goalY));
+        if (cluster == goalCluster && search->goalCosts[entrance] != FLT_MAX) {
+            VisitTMXPathNode(search, goalNode, cost + search->goalCosts[entrance], node, 0.0f);
+        }
     }
+    if (node != goalNode) return false;
 
-    Color newTint = ColorAlpha(tint, (float)layer->opacity);
+    // The cells of the graph nodes, from the start to the goal.
+    int length = 0;
+    for (node = goalNode; node >= 0; node = search->parents[node]) length++;
+    if (length > search->nodeCapacity) {
+        search->nodeCapacity = length;
+        search->nodes = (int *)MemRealloc(search->nodes, (unsigned int)length * sizeof(int));
+    }
+    int i = length;
+    for (node = goalNode; node >= 0; node = search->parents[node]) {
+        search->nodes[--i] = (node == startNode) ? start : (node == goalNode) ? goal :
+            graph->clusters[node / RAYLIB_TMX_PATH_MAX_NODES].nodeCells[node % RAYLIB_TMX_PATH_MAX_NODES];
+    }
 
-    for (int y = startY; y != endY; y += incY) {
-        for (int x = startX; x != endX; x += incX) {
-            int cellIndex = (y * (int) map->width) + x;
-            unsigned int baseGid = layer->content.gids[cellIndex];
-            unsigned int gid = baseGid & TMX_FLIP_BITS_REMOVAL;
+    // Steps across a border go to the next cell, the others are searched for within their cluster.
+    AddTMXPathRoute(search, start);
+    for (i = 1; i < length; i++) {
+        int cell = search->nodes[i];
+        int previous = search->nodes[i - 1];
+        int cluster = GetTMXPathCluster(graph, cell);
+        if (cell == previous) continue;
+        if (cluster != GetTMXPathCluster(graph, previous)) {
+            AddTMXPathRoute(search, cell);
+            continue;
+        }
+        grid = GetTMXPathClusterGrid(graph, cluster);
+        if (!SearchTMXPathGrid(search, &grid, previous, cell)) return false;
+        AddTMXPathRouteCells(search, cell);
+    }
+    return true;
+}
 
-            if (!map->tiles[gid]) continue;
+/**
+ * Find the waypoints of a path between two points of a map.
+ *
+ * @internal
+ */
+Vector2 *FindTMXPath(RaylibTMXPathGraph *graph, RaylibTMXPathSearch *search, Vector2 start, Vector2 goal, int *count) {
+    *count = 0;
+    const RaylibTMXSolidMask *mask = graph->mask;
+    int startX = (int)floorf(start.x / mask->cellWidth);
+    int startY = (int)floorf(start.y / mask->cellHeight);
+    int goalX = (int)floorf(goal.x / mask->cellWidth);
+    int goalY = (int)floorf(goal.y / mask->cellHeight);
+    if (startX < 0 || startY < 0 || startX >= mask->width || startY >= mask->height) return NULL;
+    if (goalX < 0 || goalY < 0 || goalX >= mask->width || goalY >= mask->height) return NULL;
+    if (IsTMXSolidMaskCell(mask, startX, startY) || IsTMXSolidMaskCell(mask, goalX, goalY)) return NULL;
 
-            tmx_tile* tile = map->tiles[gid];
-            if (tile->animation) UpdateTMXTileAnimation(map, &tile);
+    int startCell = startY * mask->width + startX;
+    int goalCell = goalY * mask->width + goalX;
+    search->routeCount = 0;
+    bool found = false;
 
-            int drawX = posX + x * (int) map->tile_width;
-            int drawY = posY + y * (int) map->tile_height;
-            DrawTMXTile(tile, baseGid, drawX, drawY, newTint);
+    // Short paths are searched on the grid around both ends, before going through the clusters.
+    if (GetTMXPathDistance(startX, startY, goalX, goalY) <= (float)RAYLIB_TMX_PATH_SHORT) {
+        RaylibTMXPathGrid grid = {mask, 0, 0, 0, 0};
+        grid.minX = (int)fmaxf((float)(((startX < goalX) ? startX : goalX) - RAYLIB_TMX_PATH_CLUSTER_SIZE), 0.0f);
+        grid.minY = (int)fmaxf((float)(((startY < goalY) ? startY : goalY) - RAYLIB_TMX_PATH_CLUSTER_SIZE), 0.0f);
+        grid.maxX = (int)fminf((float)(((startX > goalX) ? startX : goalX) + RAYLIB_TMX_PATH_CLUSTER_SIZE), (float)(mask->width - 1));
+        grid.maxY = (int)fminf((float)(((startY > goalY) ? startY : goalY) + RAYLIB_TMX_PATH_CLUSTER_SIZE), (float)(mask->height - 1));
+        found = SearchTMXPathGrid(search, &grid, startCell, goalCell);
+        if (found) AddTMXPathRouteCells(search, goalCell);
+    }
+    if (!found) {
+        search->routeCount = 0;
+        found = SearchTMXPathGraph(graph, search, startCell, goalCell);
+    }
+    if (!found) return NULL;
+
+    // Only the cells where the path turns are kept.
+    Vector2 *path = (Vector2 *)MemAlloc((unsigned int)search->routeCount * sizeof(Vector2));
+    int lastX = 0, lastY = 0;
+    for (int i = 0; i < search->routeCount; i++) {
+        int x = search->route[i] % mask->width;
+        int y = search->route[i] / mask->width;
+        if (i > 0 && i + 1 < search->routeCount) {
+            int nextX = search->route[i + 1] % mask->width;
+            int nextY = search->route[i + 1] / mask->width;
+            int dx = (x > lastX) - (x < lastX), dy = (y > lastY) - (y < lastY);
+            if (dx == (nextX > x) - (nextX < x) && dy == (nextY > y) - (nextY < y)) continue;
         }
+        path[(*count)++] = (Vector2){((float)x + 0.5f) * mask->cellWidth, ((float)y + 0.5f) * mask->cellHeight};
+        lastX = x;
+        lastY = y;
     }
+    return path;
 }
 
 /**
- * Render the given layer to the screen.
+ * Find a path between two points of a map, going around the solid cells of its visible tile layers.
  *
- * @param map The TMX map that holds the layer.
- * @param layer The layer to render on the screen.
- * @param posX The X position of the screen.
- * @param posY The Y position of the screen.
- * @param tint How to tint the rendering of the layer.
+ * Paths move between neighboring cells, diagonally only when both cells beside the move are open.
+ * Short paths are searched for on the grid with jump point search. Longer ones go through a graph
+ * of the openings between clusters of RAYLIB_TMX_PATH_CLUSTER_SIZE cells (HPA*), which is built
+ * by the first search, so their cost depends on the number of clusters crossed rather than the
+ * area of the map. Such paths are close to the shortest, but not always the shortest.
+ *
+ * Changing tiles with SetTMXTile() only builds the clusters holding them again, on the next search.
+ * The points are placed on the grid of an orthogonal map, so there are no paths on other maps.
+ *
+ * @param map   The map to find a path in.
+ * @param start Where the path starts, in map coordinates.
+ * @param goal  Where the path ends, in map coordinates.
+ * @param count Where to store the number of waypoints, 0 when there's no path.
+ *
+ * @return The centers of the cells where the path starts, turns and ends, to be unloaded with UnloadTMXPath(), or NULL when there's no path.
+ *
+ * @see LoadTMXPaths()
  */
-void DrawTMXLayer(tmx_map *map, tmx_layer *layer, int posX, int posY, Color tint) {
-    switch (layer->type) {
-        case L_GROUP:
-            DrawTMXLayers(map, layer->content.group_head, posX + layer->offsetx, posY + layer->offsety, tint); // recursive call
-            break;
-        case L_OBJGR:
-            DrawTMXLayerObjects(map, layer->content.objgr, posX + layer->offsetx, posY + layer->offsety, tint);
-            break;
-        case L_IMAGE:
-            DrawTMXLayerImage(layer->content.image, posX + layer->offsetx, posY + layer->offsety, tint);
-            break;
-        case L_LAYER:
-	        DrawTMXLayerTiles(map, layer, posX + layer->offsetx, posY + layer->offsety, tint);
-            break;
-        case L_NONE:
-            // Nothing.
-            break;
-    }
+Vector2 *LoadTMXPath(tmx_map *map, Vector2 start, Vector2 goal, int *count) {
+    *count = 0;
+    RaylibTMXPathGraph *graph = GetTMXPathGraph(map);
+    if (graph == NULL) return NULL;
+    return FindTMXPath(graph, &graph->searches[0], start, goal, count);
 }
 
 /**
- * Draws all of the given TMX map layers to the screen.
+ * Unload the waypoints of a path loaded by LoadTMXPath() or LoadTMXPaths().
  *
- * @param map The TMX map that holds the layer.
- * @param layers The layer to render on the screen.
- * @param posX The X position of the screen.
- * @param posY The Y position of the screen.
- * @param tint How to tint the rendering of the layer.
+ * @param path The waypoints to unload.
  */
-void DrawTMXLayers(tmx_map *map, tmx_layer *layers, int posX, int posY, Color tint) {
-    do {
-		if (layers->visible) DrawTMXLayer(map, layers, posX, posY, tint);
-	} while ((layers = layers->next));
+void UnloadTMXPath(Vector2 *path) {
+    MemFree(path);
 }
 
 /**
- * Render the given map to the screen.
+ * The path requests shared by the workers of LoadTMXPaths().
  *
- * @param map The TMX map to render to the screen.
- * @param posX The X position of the screen.
- * @param posY The Y position of the screen.
- * @param tint How to tint the rendering of the layer.
+ * @internal
  */
-void DrawTMX(tmx_map *map, int posX, int posY, Color tint) {
-    Color background = ColorFromTMX(map->backgroundcolor);
-    // TODO: Apply the tint to the background color.
-    DrawRectangle(posX, posY, (int)map->width, (int)map->height, background);
-	DrawTMXLayers(map, map->ly_head, posX, posY, tint);
+typedef struct RaylibTMXPathBatch {
+    RaylibTMXPathGraph *graph;
+    RaylibTMXPathRequest *requests;
+    int count;
+    long nextRequest;                   // Next request to search for, shared by the workers
+    long nextSearch;                    // Next search memory to take, one per worker
+} RaylibTMXPathBatch;
+
+/**
+ * Search for the paths of a batch, taking the next request until none are left.
+ *
+ * @internal
+ */
+void RunTMXPathBatch(void *work) {
+    RaylibTMXPathBatch *batch = (RaylibTMXPathBatch *)work;
+    RaylibTMXPathSearch *search = &batch->graph->searches[RAYLIB_TMX_ATOMIC_INCREMENT(&batch->nextSearch)];
+    for (;;) {
+        long index = RAYLIB_TMX_ATOMIC_INCREMENT(&batch->nextRequest);
+        if (index >= batch->count) break;
+        RaylibTMXPathRequest *request = &batch->requests[index];
+        request->path = FindTMXPath(batch->graph, search, request->start, request->goal, &request->count);
+    }
 }
 
 /**
- * Returns an RaylibTMXCollision shape relative to object type
+ * Find the paths of many agents at once, on worker threads.
  *
- * @param object  The object pointer which the collision will be returned.
+ * Each request is searched for as with LoadTMXPath(). The graph is brought up to date first, so
+ * the workers only read it, and each worker keeps its own search memory between calls.
+ *
+ * @param map      The map to find the paths in.
+ * @param requests The start and goal of each path, where the waypoints found are stored.
+ * @param count    The number of requests.
+ * @param workers  The amount of threads searching, including the calling thread.
+ *
+ * @see UnloadTMXPath()
  */
-RaylibTMXCollision HandleTMXCollision(tmx_object* object) {
-    RaylibTMXCollision collision = {0};
-    switch (object->obj_type)
-    {
-	    case OT_SQUARE:
-	    case OT_TILE: {
-            collision.type = COLLISION_RECT;
-            collision.rect = (Rectangle) {
-                .x      = (float) object->x,
-                .y      = (float) object->y,
-                .width  = (float) object->width,
-                .height = (float) object->height
-            };
-	    } break;
-        case OT_POINT: {
-            collision.type  = COLLISION_POINT;
-            collision.point = (Vector2) {
-                .x = (float)object->x,
-                .y = (float)object->y
-            };
-        } break;
-        case OT_POLYLINE:
-        case OT_POLYGON: {
-            collision.type = (object->obj_type == OT_POLYGON) ? COLLISION_POLYGON : COLLISION_POLYLINE;
-            collision.polygon.points = object->content.shape->points;
-            collision.polygon.count  = object->content.shape->points_len;
-        } break;
-        case OT_ELLIPSE: {
-            collision.type = COLLISION_ELLIPSE;
-            collision.rect = (Rectangle) {
-                .x         = (float) (object->x + object->width  / 2.0f),
-                .y         = (float) (object->y + object->height / 2.0f),
-                .width     = (float) (object->width  / 2.0f),
-                .height    = (float) (object->height / 2.0f)
-            };
-        } break;
-        case OT_NONE:
-        case OT_TEXT: {
-            TraceLog(LOG_ERROR, "Unreachable: OT_TEXT and OT_NONE dont have collisions");
-            abort();
-        } break;
+void LoadTMXPaths(tmx_map *map, RaylibTMXPathRequest *requests, int count, int workers) {
+    if (requests == NULL) return;
+    for (int i = 0; i < count; i++) {
+        requests[i].path = NULL;
+        requests[i].count = 0;
     }
-    return collision;
+    RaylibTMXPathGraph *graph = GetTMXPathGraph(map);
+    if (graph == NULL) return;
+
+    RaylibTMXPathBatch batch = {graph, requests, count, 0, 0};
+    if (workers > count) workers = count;
+    if (workers < 1) workers = 1;
+    RunTMXWorkers(RunTMXPathBatch, &batch, workers);
 }
 
 /**
- * Returns each tmx_object on a given map and their collisions on a callback
+ * Check whether the collision of a tile is a single rectangle covering a whole map cell.
  *
- * @param map       The map where collisions will be collected and calculated.
- * @param callback  The callback function that the user wants to receive the collisions.
- * @param userdata  The userdata that the user wnats to utilize within the callback.
+ * @internal
  */
-void CollisionsTMXForeach(tmx_map *map, tmx_collision_functor callback, void* userdata) {
-    tmx_layer *layer = map->ly_head;
-    do {
-        if (!layer->visible) continue;
-        switch (layer->type)
-        {
-            case L_LAYER: {
-                for (unsigned int y = 0; y < map->height; y++) {
-                    for (unsigned int x = 0; x < map->width; x++) {
-                        unsigned int index   = (y * map->width) + x;
-                        unsigned int baseGid = layer->content.gids[index];
-                        unsigned int gid     = baseGid & TMX_FLIP_BITS_REMOVAL;
-                        tmx_tile* tile       = map->tiles[gid];
-                        if (!tile || !tile->collision) continue;
-                        tmx_object *collision = tile->collision;
-                        do {
-                            tmx_object copy = *collision;
-                            copy.x += (x * tile->width);
-                            copy.y += (y * tile->height);
-                            switch (tile->tileset->objectalignment)
-                            {
-                                // TODO: Rotated collisions shall be handle here
-                                case OA_TOPLEFT: /*RAYLIB DEFAULT */ /*TODO*/ break;
-                                case OA_NONE:
-                                case OA_BOTTOMLEFT:  /* TILED DEFAULT */ /* TODO */  break;
-                                case OA_TOP:         /* TODO */ break;
-                                case OA_LEFT:        /* TODO */ break;
-                                case OA_BOTTOM:      /* TODO */ break;
-                                case OA_RIGHT:       /* TODO */ break;
-                                case OA_TOPRIGHT:    /* TODO */ break;
-                                case OA_BOTTOMRIGHT: /* TODO */ break;
-                                case OA_CENTER:      /* TODO */ break;
-                            }
-                            callback(collision, HandleTMXCollision(&copy), userdata);
-                        } while ((collision = collision->next));
-                    }
+bool IsTMXTileSolid(tmx_map *map, tmx_tile *tile) {
+    if (tile == NULL || tile->collision == NULL || tile->collision->next != NULL) return false;
+    tmx_object *collision = tile->collision;
+    return collision->obj_type == OT_SQUARE && collision->x == 0.0 && collision->y == 0.0 &&
+        tile->width == map->tile_width && tile->height == map->tile_height &&
+        collision->width == (double)tile->width && collision->height == (double)tile->height;
+}
+
+/**
+ * Load the rectangle collisions of a tile layer, merging adjacent solid tiles into larger rectangles.
+ *
+ * Tiles whose collision is a single rectangle covering the whole tile are merged greedily, row by
+ * row, into the largest rectangles they form. The other rectangle collisions of the layer are
+ * returned as they are. Ellipse, point and polygon collisions are left out, use
+ * CollisionsTMXForeach() for those.
+ *
+ * @param map   The map holding the layer.
+ * @param layer The tile layer to load the collisions of.
+ * @param count Where to store the number of rectangles returned.
+ *
+ * @return The rectangles in map coordinates, to be unloaded with UnloadTMXLayerColliders(), or NULL when there are none.
+ */
+Rectangle *LoadTMXLayerColliders(tmx_map *map, tmx_layer *layer, int *count) {
+    *count = 0;
+    if (map == NULL || layer == NULL || layer->type != L_LAYER) return NULL;
+
+    unsigned int cellCount = map->width * map->height;
+    bool *solid = (bool *)MemAlloc(cellCount * sizeof(bool));
+    Rectangle *colliders = NULL;
+    int capacity = 0;
+
+    for (unsigned int y = 0; y < map->height; y++) {
+        for (unsigned int x = 0; x < map->width; x++) {
+            unsigned int index = (y * map->width) + x;
+            tmx_tile *tile = map->tiles[layer->content.gids[index] & TMX_FLIP_BITS_REMOVAL];
+            if (IsTMXTileSolid(map, tile)) {
+                solid[index] = true;
+                continue;
+            }
+            if (tile == NULL) continue;
+            for (tmx_object *collision = tile->collision; collision != NULL; collision = collision->next) {
+                if (collision->obj_type != OT_SQUARE) continue;
+                if (*count == capacity) {
+                    capacity = (capacity == 0) ? 64 : capacity * 2;
+                    colliders = (Rectangle *)MemRealloc(colliders, (unsigned int)capacity * sizeof(Rectangle));
                 }
-            } break;
-            case L_OBJGR: {
-                tmx_object *object = layer->content.objgr->head;
-                if (!object) continue;
-                do {
-                    if (object->obj_type == OT_TEXT || object->obj_type == OT_NONE) continue;
-                    RaylibTMXCollision raylibCollision = HandleTMXCollision(object);
-                    if (object->obj_type != OT_TILE) {
-                        callback(object, raylibCollision, userdata);
-                        continue;
-                    }
-                    int baseGid      = object->content.gid;
-                    unsigned int gid = baseGid & TMX_FLIP_BITS_REMOVAL;
-                    tmx_tile* tile   = map->tiles[gid];
-                    if (!tile) {
-                        callback(object, raylibCollision, userdata);
-                        continue;
-                    }
-                    int flags                  = baseGid & ~TMX_FLIP_BITS_REMOVAL;
-                    int is_diagonally_fliped   = baseGid & TMX_FLIPPED_DIAGONALLY;
-                    int is_vertically_fliped   = baseGid & TMX_FLIPPED_VERTICALLY;
-                    int is_horizontally_fliped = {
-                        (int)((unsigned int)baseGid & TMX_FLIPPED_HORIZONTALLY)
-                    };
-                    switch (tile->tileset->objectalignment)
-                    {
-                        // TODO: Rotated collisions shall be handled here
-                        case OA_TOPLEFT: /*RAYLIB DEFAULT*/ break;
-                        case OA_NONE:
-                        case OA_BOTTOMLEFT: /* TILED DEFAULT */ {
-                            if (raylibCollision.type == COLLISION_RECT) {
-                                raylibCollision.rect.y -= (float) object->height;
-                            }
-                        } break;
-                        case OA_TOP:         /* TODO */ break;
-                        case OA_LEFT:        /* TODO */ break;
-                        case OA_BOTTOM:      /* TODO */ break;
-                        case OA_RIGHT:       /* TODO */ break;
-                        case OA_TOPRIGHT:    /* TODO */ break;
-                        case OA_BOTTOMRIGHT: /* TODO */ break;
-                        case OA_CENTER:      /* TODO */ break;
-                    }
-                    callback(object, raylibCollision, userdata);
-
-                    tmx_object *collision = tile->collision;
-                    if (!collision) continue;
-                    do {
-                        tmx_object copy = *collision;
-                        copy.x += object->x;
-                        copy.y += object->y;
-                        switch (tile->tileset->objectalignment)
-                        {
-                            // TODO: Rotated collisions shall be handled here
-                            case OA_TOPLEFT: /*RAYLIB DEFAULT*/ {
-                                if (is_horizontally_fliped) {
-                                    int objectXOffset    = object->x + object->width;
-                                    int collisionXOffset = collision->x + collision->width;
-                                    copy.x = objectXOffset - collisionXOffset;
-                                }
-                                if (is_vertically_fliped) {
-                                    int objectYOffset    = object->y + object->height;
-                                    int collisionYOffset = collision->y + collision->height;
-                                    copy.y = objectYOffset - collisionYOffset;
-                                }
-                            } break;
-                            case OA_NONE:
-                            case OA_BOTTOMLEFT: /* TILED DEFAULT */ {
-                                if (is_horizontally_fliped) {
-                                    copy.x += object->width - collision->width;
-                                }
-                                if (is_vertically_fliped) {
-                                    copy.y += object->height - collision->height;
-                                }
-                            } break;
-                            case OA_TOP:         /* TODO */ break;
-                            case OA_LEFT:        /* TODO */ break;
-                            case OA_BOTTOM:      /* TODO */ break;
-                            case OA_RIGHT:       /* TODO */ break;
-                            case OA_TOPRIGHT:    /* TODO */ break;
-                            case OA_BOTTOMRIGHT: /* TODO */ break;
-                            case OA_CENTER:      /* TODO */ break;
-                        }
-                        callback(collision, HandleTMXCollision(&copy), userdata);
-                    } while ((collision = collision->next));
-                } while ((object = object->next));
-            } break;
-            
-            default: continue;
+                colliders[(*count)++] = (Rectangle){
+                    (float)(collision->x + x * tile->width), (float)(collision->y + y * tile->height),
+                    (float)collision->width, (float)collision->height
+                };
+            }
         }
-    } while ((layer = layer->next));
+    }
+
+    // Grow each rectangle to the right first, then down for as long as whole rows are solid.
+    for (unsigned int y = 0; y < map->height; y++) {
+        for (unsigned int x = 0; x < map->width; x++) {
+            if (!solid[(y * map->width) + x]) continue;
+            unsigned int width = 1;
+            while (x + width < map->width && solid[(y * map->width) + x + width]) width++;
+            unsigned int height = 1;
+            while (y + height < map->height) {
+                unsigned int i = 0;
+                while (i < width && solid[((y + height) * map->width) + x + i]) i++;
+                if (i < width) break;
+                height++;
+            }
+            for (unsigned int j = 0; j < height; j++) {
+                for (unsigned int i = 0; i < width; i++) solid[((y + j) * map->width) + x + i] = false;
+            }
+            if (*count == capacity) {
+                capacity = (capacity == 0) ? 64 : capacity * 2;
+                colliders = (Rectangle *)MemRealloc(colliders, (unsigned int)capacity * sizeof(Rectangle));
+            }
+            colliders[(*count)++] = (Rectangle){
+                (float)(x * map->tile_width), (float)(y * map->tile_height),
+                (float)(width * map->tile_width), (float)(height * map->tile_height)
+            };
+        }
+    }
+
+    MemFree(solid);
+    return colliders;
+}
+
+/**
+ * Unload the rectangles loaded with LoadTMXLayerColliders().
+ */
+void UnloadTMXLayerColliders(Rectangle *colliders) {
+    MemFree(colliders);
+}
+
+/**
+ * Get what drawing and collision queries cost since the last call to ResetTMXFrameStats().
+ *
+ * The statistics are only gathered when raylib-tmx is built with RAYLIB_TMX_STATS defined, as
+ * they slow down drawing. Otherwise, this returns zeroed statistics. Layer times are measured on
+ * the CPU, and don't include the time the GPU takes to render.
+ *
+ * @return The statistics of every map drawn or queried since the last reset.
+ *
+ * @see ResetTMXFrameStats()
+ */
+RaylibTMXFrameStats GetTMXFrameStats(void) {
+#if defined(RAYLIB_TMX_STATS)
+    return raylibTMXFrameStats;
+#else
+    return (RaylibTMXFrameStats){0};
+#endif
+}
+
+/**
+ * Clear the statistics returned by GetTMXFrameStats(), usually once per frame.
+ */
+void ResetTMXFrameStats(void) {
+#if defined(RAYLIB_TMX_STATS)
+    raylibTMXFrameStats = (RaylibTMXFrameStats){0};
+    raylibTMXStatsTexture = 0;
+#endif
 }
 
 #ifdef __cplusplus
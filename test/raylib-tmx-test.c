@@ -2,6 +2,7 @@
 
 #include "raylib.h"
 
+#define RAYLIB_TMX_STATS
 #define RAYLIB_TMX_IMPLEMENTATION
 #include "raylib-tmx.h"
 
@@ -11,6 +12,48 @@ void trace(const char* text) {
     TraceLog(LOG_INFO, "================================");
 }
 
+void CountCollisions(tmx_object *object, RaylibTMXCollision collision, void* userdata) {
+    (void)object;
+    (void)collision;
+    (*(int*)userdata)++;
+}
+
+void FindCollision(tmx_object *object, RaylibTMXCollision collision, void* userdata) {
+    (void)collision;
+    *(tmx_object**)userdata = object;
+}
+
+tmx_object *FindObject(tmx_layer *layer, const char *name) {
+    for (tmx_object *object = layer->content.objgr->head; object != NULL; object = object->next) {
+        if (TextIsEqual(object->name, name)) return object;
+    }
+    return NULL;
+}
+
+unsigned char *LoadFileDataCounted(const char *fileName, int *dataSize, void* userdata) {
+    (*(int*)userdata)++;
+    return LoadFileData(fileName, dataSize);
+}
+
+bool IsRenderEqual(RenderTexture2D expected, RenderTexture2D actual) {
+    Image expectedImage = LoadImageFromTexture(expected.texture);
+    Image actualImage = LoadImageFromTexture(actual.texture);
+    bool equal = expectedImage.width == actualImage.width && expectedImage.height == actualImage.height && expectedImage.format == actualImage.format &&
+        memcmp(expectedImage.data, actualImage.data, (size_t)GetPixelDataSize(expectedImage.width, expectedImage.height, expectedImage.format)) == 0;
+    UnloadImage(expectedImage);
+    UnloadImage(actualImage);
+    return equal;
+}
+
+void RenderTMXLayer(RenderTexture2D target, tmx_map *map) {
+    BeginTextureMode(target);
+    {
+        ClearBackground(BLANK);
+        DrawTMXLayerEx(map, map->ly_head, -700, -800, (Rectangle){0, 0, 640, 480}, WHITE);
+    }
+    EndTextureMode();
+}
+
 int main(int argc, char *argv[]) {
     // Initialization
     SetTraceLogLevel(LOG_ALL);
@@ -42,8 +85,683 @@ int main(int argc, char *argv[]) {
 	EndDrawing();
     }
 
+    trace("DrawTMXEx");
+    Camera2D camera = {0};
+    camera.zoom = 2.0f;
+    Rectangle bounds = GetTMXViewBounds(camera, (Rectangle){0, 0, 640, 480});
+    assert(bounds.width == 320 && bounds.height == 240);
+    BeginDrawing();
+    {
+        ClearBackground(RAYWHITE);
+        BeginMode2D(camera);
+        DrawTMXEx(map, camera, (Rectangle){0, 0, 640, 480}, WHITE);
+        EndMode2D();
+        DrawTMXLayerEx(map, map->ly_head, 10, 10, (Rectangle){100, 100, 64, 64}, WHITE);
+    }
+    EndDrawing();
+
+    trace("BuildTMXDrawList");
+    // Each list draws the same pixels as DrawTMXEx(), with the threads of the first kept for the next.
+    RenderTexture2D expected = LoadRenderTexture(640, 480);
+    RenderTexture2D actual = LoadRenderTexture(640, 480);
+    Camera2D listCamera = {{0, 0}, {100, 50}, 0.0f, 2.0f};
+    BeginTextureMode(expected);
+    {
+        ClearBackground(BLANK);
+        BeginMode2D(listCamera);
+        DrawTMXEx(map, listCamera, (Rectangle){0, 0, 640, 480}, WHITE);
+        EndMode2D();
+    }
+    EndTextureMode();
+    const int listWorkers[] = {4, 1, 2, 4};
+    for (size_t i = 0; i < sizeof(listWorkers)/sizeof(listWorkers[0]); i++) {
+        RaylibTMXDrawList *drawList = BuildTMXDrawList(map, listCamera, (Rectangle){0, 0, 640, 480}, WHITE, listWorkers[i]);
+        assert(drawList != NULL);
+        BeginTextureMode(actual);
+        {
+            ClearBackground(BLANK);
+            BeginMode2D(listCamera);
+            SubmitTMXDrawList(drawList);
+            EndMode2D();
+        }
+        EndTextureMode();
+        UnloadTMXDrawList(drawList);
+        assert(IsRenderEqual(expected, actual));
+    }
+    assert(BuildTMXDrawList(NULL, camera, (Rectangle){0, 0, 640, 480}, WHITE, 4) == NULL);
+
+    trace("EnableTMXCache");
+    // The view crosses the corner of four chunks, with flipped tiles on both sides of their borders.
+    assert(SetTMXTile(map, map->ly_head, 31, 31, 5 | TMX_FLIPPED_HORIZONTALLY));
+    assert(SetTMXTile(map, map->ly_head, 32, 32, 6 | TMX_FLIPPED_DIAGONALLY));
+    assert(SetTMXTile(map, map->ly_head, 32, 26, 7 | TMX_FLIPPED_VERTICALLY | TMX_FLIPPED_DIAGONALLY));
+    assert(SetTMXTile(map, map->ly_head, 22, 33, 8 | TMX_FLIPPED_HORIZONTALLY | TMX_FLIPPED_VERTICALLY));
+    RenderTMXLayer(expected, map);
+    EnableTMXCache(map);
+    for (int i = 0; i < 2; i++) {
+        ResetTMXFrameStats();
+        RenderTMXLayer(actual, map);
+        assert(GetTMXFrameStats().chunksDrawn == 4);
+        assert(IsRenderEqual(expected, actual));
+    }
+
+    // Changed cells are baked again.
+    unsigned int changedGid = map->ly_head->content.gids[33 * map->width + 33];
+    assert(SetTMXTile(map, map->ly_head, 33, 33, 9 | TMX_FLIPPED_DIAGONALLY));
+    RenderTMXLayer(actual, map);
+    DisableTMXCache(map);
+    RenderTMXLayer(expected, map);
+    assert(IsRenderEqual(expected, actual));
+    assert(SetTMXTile(map, map->ly_head, 33, 33, changedGid));
+
+    // Tiles larger than the grid overlap their neighbors, so they're drawn one by one.
+    map->tile_width = 24;
+    RenderTMXLayer(expected, map);
+    EnableTMXCache(map);
+    ResetTMXFrameStats();
+    RenderTMXLayer(actual, map);
+    assert(GetTMXFrameStats().chunksDrawn == 0);
+    assert(IsRenderEqual(expected, actual));
+    DisableTMXCache(map);
+    // The same goes for meshes, whose batches don't keep the render order.
+    BuildTMXLayerMesh(map, map->ly_head);
+    ResetTMXFrameStats();
+    RenderTMXLayer(actual, map);
+    assert(GetTMXFrameStats().chunksDrawn == 0);
+    assert(IsRenderEqual(expected, actual));
+    UnloadTMXLayerMesh(map, map->ly_head);
+    map->tile_width = 32;
+    RenderTMXLayer(expected, map);
+    EnableTMXCache(map);
+
+    trace("StreamTMXCache");
+    // Fewer chunks than are visible are kept, so drawing evicts the chunks it already drew.
+    SetTMXCacheBudget(map, 2);
+    StreamTMXCache(map, (Rectangle){700, 800, 640, 480});
+    for (int i = 0; i < 2; i++) {
+        RenderTMXLayer(actual, map);
+        assert(IsRenderEqual(expected, actual));
+    }
+    SetTMXCacheBudget(map, 0);
+
+    trace("BuildTMXLayerMesh");
+    DisableTMXCache(map);
+    BuildTMXLayerMesh(map, map->ly_head);
+    InvalidateTMXCache(map, map->ly_head, 0, 0);
+    RenderTMXLayer(actual, map);
+    assert(IsRenderEqual(expected, actual));
+    UnloadTMXLayerMesh(map, map->ly_head);
+    BuildTMXLayerMesh(map, map->ly_head);
+    UnloadTMXLayerMesh(map, map->ly_head);
+
+    trace("SetTMXTile");
+    EnableTMXCache(map);
+    unsigned int firstGid = map->ly_head->content.gids[0];
+    assert(SetTMXTile(map, map->ly_head, 0, 0, 5));
+    assert(map->ly_head->content.gids[0] == 5);
+    assert(!SetTMXTile(map, map->ly_head, -1, 0, 5));
+    assert(!SetTMXTile(map, map->ly_head, 0, 0, map->tilecount));
+    RaylibTMXTileChange changes[] = {{1, 0, 5}, {0, 0, firstGid}, {(int)map->width, 0, 5}};
+    assert(SetTMXTiles(map, map->ly_head, changes, 3) == 2);
+    assert(map->ly_head->content.gids[0] == firstGid);
+    DisableTMXCache(map);
+
+    trace("GetTMXTileGid");
+    assert(GetTMXTilesetFirstGid(map, map->ts_head->tileset) == map->ts_head->firstgid);
+    assert(GetTMXTileGid(map, map->tiles[5]) == 5);
+
+    trace("UpdateTMXAnimations");
+    UpdateTMXAnimations(map, 0.5f);
+    assert(GetTMXAnimationState(map, map->tiles[5]) == NULL);
+
+    trace("CompileTMX");
+    RenderTMXLayer(expected, map);
+    CompileTMX(map);
+    RenderTMXLayer(actual, map);
+    assert(IsRenderEqual(expected, actual));
+
+    trace("GetTMXFrameStats");
+    ResetTMXFrameStats();
+    BeginDrawing();
+    {
+        ClearBackground(RAYWHITE);
+        DrawTMX(map, 10, 10, WHITE);
+    }
+    EndDrawing();
+    RaylibTMXFrameStats frameStats = GetTMXFrameStats();
+    assert(frameStats.layerCount > 0);
+    assert(frameStats.layers[0].layer == map->ly_head);
+    assert(frameStats.tilesDrawn > 0);
+    assert(frameStats.cellsVisited == frameStats.tilesDrawn + frameStats.cellsSkipped);
+
+    tmx_map *walls = LoadTMX("resources/walls.tmx");
+    assert(walls != NULL);
+    tmx_layer *ground = walls->ly_head;
+    tmx_layer *objects = ground->next;
+    assert(ground->type == L_LAYER && objects != NULL && objects->type == L_OBJGR);
+    tmx_object *crate = FindObject(objects, "Crate");
+    tmx_object *sign = FindObject(objects, "Sign");
+    assert(crate != NULL && sign != NULL);
+    tmx_object *wallCollision = walls->tiles[10]->collision;
+    assert(wallCollision != NULL);
+
+    trace("QueryTMXCollisionsRect");
+    // 27 wall cells, the crate, the sign and the pond.
+    int everywhere = 0, found = 0;
+    tmx_object *hit = NULL;
+    CollisionsTMXForeach(walls, CountCollisions, &everywhere);
+    assert(everywhere == 30);
+    QueryTMXCollisionsRect(walls, (Rectangle){-10000, -10000, 20000, 20000}, CountCollisions, &found);
+    assert(found == everywhere);
+    found = 0;
+    QueryTMXCollisionsRect(walls, (Rectangle){70, 70, 8, 8}, CountCollisions, &found);
+    QueryTMXCollisionsRect(walls, (Rectangle){70, 70, 8, 8}, FindCollision, &hit);
+    assert(found == 1 && hit == crate);
+    found = 0;
+    QueryTMXCollisionsRect(walls, (Rectangle){600, 40, 50, 10}, CountCollisions, &found);
+    QueryTMXCollisionsRect(walls, (Rectangle){600, 40, 50, 10}, FindCollision, &hit);
+    assert(found == 1 && hit == wallCollision);
+    found = 0;
+    QueryTMXCollisionsRect(walls, (Rectangle){200, 200, 10, 10}, CountCollisions, &found);
+    assert(found == 0);
+    hit = NULL;
+    QueryTMXCollisionsPoint(walls, (Vector2){330, 390}, FindCollision, &hit);
+    assert(hit == sign);
+    found = 0;
+    QueryTMXCollisionsPoint(walls, (Vector2){-10000, -10000}, CountCollisions, &found);
+    assert(found == 0);
+
+    trace("QueryTMXCollisionsRects");
+    Rectangle entities[3] = {{70, 70, 8, 8}, {200, 200, 10, 10}, {600, 40, 50, 10}};
+    assert(QueryTMXCollisionsRects(walls, entities, 3, NULL, 0) == 2);
+    RaylibTMXCollisionHit hits[4];
+    int hitCount = QueryTMXCollisionsRects(walls, entities, 3, hits, 4);
+    assert(hitCount == 2);
+    assert(hits[0].index == 0 && hits[0].collider->object == crate);
+    assert(hits[1].index == 2 && hits[1].collider->object == wallCollision);
+    assert(QueryTMXCollisionsRects(walls, (Rectangle[]){{-10000, -10000, 20000, 20000}}, 1, hits, 4) == everywhere);
+    hitCount = QueryTMXCollisionsPoints(walls, (Vector2[]){{-10000, -10000}, {330, 390}}, 2, hits, 4);
+    assert(hitCount == 1 && hits[0].index == 1 && hits[0].collider->object == sign);
+
+    trace("UpdateTMXCollisionIndex");
+    crate->x = 200;
+    crate->y = 200;
+    UpdateTMXCollisionIndex(walls);
+    hit = NULL;
+    QueryTMXCollisionsRect(walls, (Rectangle){200, 200, 10, 10}, FindCollision, &hit);
+    assert(hit == crate);
+    found = 0;
+    QueryTMXCollisionsRect(walls, (Rectangle){70, 70, 8, 8}, CountCollisions, &found);
+    assert(found == 0);
+    hitCount = QueryTMXCollisionsRects(walls, entities, 3, hits, 4);
+    assert(hitCount == 2 && hits[0].index == 1 && hits[0].collider->object == crate);
+
+    trace("GetTMXCellColliders");
+    int cellColliders = 0, bakedColliders = 0;
+    const RaylibTMXCollider *objectColliders = GetTMXObjectColliders(walls, objects, &cellColliders);
+    assert(cellColliders == 3 && objectColliders != NULL);
+    for (int i = 0; i < cellColliders; i++) {
+        if (objectColliders[i].object != crate) continue;
+        assert(objectColliders[i].bounds.x == 200 && objectColliders[i].bounds.y == 200);
+        assert(objectColliders[i].bounds.width == 32 && objectColliders[i].bounds.height == 32);
+    }
+    bakedColliders += cellColliders;
+    for (int y = 0; y < (int)walls->height; y++) {
+        for (int x = 0; x < (int)walls->width; x++) {
+            const RaylibTMXCollider *cell = GetTMXCellColliders(walls, ground, x, y, &cellColliders);
+            assert(cellColliders == 0 || cell != NULL);
+            bakedColliders += cellColliders;
+        }
+    }
+    assert(bakedColliders == everywhere);
+    const RaylibTMXCollider *wallCell = GetTMXCellColliders(walls, ground, 20, 1, &cellColliders);
+    assert(cellColliders == 1 && wallCell->object == wallCollision);
+    assert(wallCell->bounds.x == 640 && wallCell->bounds.y == 32 && wallCell->bounds.width == 32 && wallCell->bounds.height == 32);
+    GetTMXCellColliders(walls, ground, 19, 1, &cellColliders);
+    assert(cellColliders == 0);
+    assert(GetTMXCellColliders(walls, ground, -1, 0, &cellColliders) == NULL && cellColliders == 0);
+
+    trace("SetTMXCacheBudget colliders");
+    // The chunks of collisions are unloaded down to the budget as queries start, and baked again once queried.
+    RaylibTMXState *wallsState = GetTMXState(walls, false);
+    assert(wallsState->colliderResident == 2);
+    SetTMXCacheBudget(walls, 1);
+    assert(wallsState->colliderResident == 1);
+    GetTMXCellColliders(walls, ground, 35, 1, &cellColliders);
+    assert(cellColliders == 0 && wallsState->colliderResident == 2);
+    wallCell = GetTMXCellColliders(walls, ground, 20, 1, &cellColliders);
+    assert(cellColliders == 1 && wallCell->object == wallCollision && wallsState->colliderResident == 2);
+    found = 0;
+    QueryTMXCollisionsRect(walls, (Rectangle){-10000, -10000, 20000, 20000}, CountCollisions, &found);
+    assert(found == everywhere);
+    assert(QueryTMXCollisionsRects(walls, (Rectangle[]){{-10000, -10000, 20000, 20000}}, 1, hits, 4) == everywhere);
+    StreamTMXCache(walls, (Rectangle){1100, 0, 100, 100});
+    assert(wallsState->colliderResident == 1);
+    SetTMXCacheBudget(walls, 0);
+
+    trace("LoadTMXLayerColliders");
+    // The wall is merged into a single column, and the walls around the cell (30, 10) into four rectangles.
+    int colliderCount = 0;
+    Rectangle *colliders = LoadTMXLayerColliders(walls, ground, &colliderCount);
+    assert(colliderCount == 5 && colliders != NULL);
+    assert(colliders[0].x == 640 && colliders[0].y == 0 && colliders[0].width == 32 && colliders[0].height == 608);
+    float colliderArea = 0;
+    for (int i = 0; i < colliderCount; i++) colliderArea += colliders[i].width * colliders[i].height;
+    assert(colliderArea == 27 * 32 * 32);
+    UnloadTMXLayerColliders(colliders);
+    assert(LoadTMXLayerColliders(walls, objects, &colliderCount) == NULL && colliderCount == 0);
+
+    trace("IsTMXCellSolid");
+    for (int y = 0; y < (int)walls->height; y++) {
+        for (int x = 0; x < (int)walls->width; x++) {
+            GetTMXCellColliders(walls, ground, x, y, &cellColliders);
+            assert(IsTMXCellSolid(walls, ground, x, y) == (cellColliders > 0));
+        }
+    }
+    assert(IsTMXCellSolid(walls, NULL, 20, 0) && !IsTMXCellSolid(walls, NULL, 20, 19) && !IsTMXCellSolid(walls, NULL, 30, 10));
+    assert(!IsTMXCellSolid(walls, NULL, -1, 0));
+    assert(SetTMXTile(walls, ground, 20, 5, 30));
+    assert(!IsTMXCellSolid(walls, NULL, 20, 5));
+    assert(SetTMXTile(walls, ground, 20, 5, 10));
+    assert(IsTMXCellSolid(walls, NULL, 20, 5));
+
+    trace("RaycastTMX");
+    RaylibTMXRayHit rayHit = RaycastTMX(walls, NULL, (Vector2){16, 48}, (Vector2){1000, 48});
+    assert(rayHit.hit && rayHit.x == 20 && rayHit.y == 1 && fabsf(rayHit.distance - 624) < 0.01f);
+    assert(fabsf(rayHit.point.x - 640) < 0.01f && rayHit.point.y == 48 && rayHit.normal.x == -1 && rayHit.normal.y == 0);
+    rayHit = RaycastTMX(walls, NULL, (Vector2){656, 624}, (Vector2){656, 0});
+    assert(rayHit.hit && rayHit.x == 20 && rayHit.y == 18 && fabsf(rayHit.distance - 16) < 0.01f);
+    assert(rayHit.normal.x == 0 && rayHit.normal.y == 1);
+    assert(!RaycastTMX(walls, NULL, (Vector2){16, 624}, (Vector2){1000, 624}).hit);
+    assert(!RaycastTMX(walls, NULL, (Vector2){-100, -100}, (Vector2){-10, -100}).hit);
+
+    trace("MoveTMXRect");
+    Vector2 moveNormal = {0, 0};
+    Rectangle moved = MoveTMXRect(walls, NULL, (Rectangle){100, 40, 20, 20}, (Vector2){1000, 0}, &moveNormal);
+    assert(moved.x == 620 && moved.y == 40 && moveNormal.x == -1 && moveNormal.y == 0);
+    moved = MoveTMXRect(walls, NULL, (Rectangle){600, 40, 20, 20}, (Vector2){50, 100}, &moveNormal);
+    assert(moved.x == 620 && moved.y == 140 && moveNormal.x == -1 && moveNormal.y == 0);
+    moved = MoveTMXRect(walls, NULL, (Rectangle){600, 612, 20, 20}, (Vector2){100, 0}, &moveNormal);
+    assert(moved.x == 700 && moved.y == 612 && moveNormal.x == 0 && moveNormal.y == 0);
+    moved = MoveTMXRect(walls, NULL, (Rectangle){-100, -100, 10, 10}, (Vector2){50, 0}, &moveNormal);
+    assert(moved.x == -50 && moved.y == -100 && moveNormal.x == 0 && moveNormal.y == 0);
+
+    // The cells of other orientations aren't laid out on the grid of the rays and rectangles.
+    walls->orient = O_ISO;
+    assert(IsTMXCellSolid(walls, NULL, 20, 0));
+    assert(!RaycastTMX(walls, NULL, (Vector2){16, 48}, (Vector2){1000, 48}).hit);
+    moved = MoveTMXRect(walls, NULL, (Rectangle){100, 40, 20, 20}, (Vector2){1000, 0}, &moveNormal);
+    assert(moved.x == 100 && moved.y == 40 && moveNormal.x == 0 && moveNormal.y == 0);
+    walls->orient = O_ORT;
+
+    trace("LoadTMXPath");
+    // From one side of the wall to the other, through the gap under it and across three clusters.
+    float tileWidth = (float)walls->tile_width, tileHeight = (float)walls->tile_height;
+    Vector2 start = {2.5f * tileWidth, 2.5f * tileHeight};
+    Vector2 goal = {37.5f * tileWidth, 2.5f * tileHeight};
+    Vector2 enclosed = {30.5f * tileWidth, 10.5f * tileHeight};
+    int pathCount = -1;
+    Vector2 *path = LoadTMXPath(walls, start, goal, &pathCount);
+    assert(path != NULL && pathCount >= 3);
+    assert(path[0].x == start.x && path[0].y == start.y);
+    assert(path[pathCount - 1].x == goal.x && path[pathCount - 1].y == goal.y);
+    bool throughGap = false;
+    for (int i = 0; i < pathCount; i++) {
+        if (path[i].y == 19.5f * tileHeight) throughGap = true;
+        if (i > 0) assert(!RaycastTMX(walls, NULL, path[i - 1], path[i]).hit);
+    }
+    assert(throughGap);
+    UnloadTMXPath(path);
+    path = LoadTMXPath(walls, start, start, &pathCount);
+    assert(path != NULL && pathCount == 1 && path[0].x == start.x && path[0].y == start.y);
+    UnloadTMXPath(path);
+    assert(LoadTMXPath(walls, (Vector2){-100, -100}, goal, &pathCount) == NULL && pathCount == 0);
+    assert(LoadTMXPath(walls, start, (Vector2){20.5f * tileWidth, 5.5f * tileHeight}, &pathCount) == NULL && pathCount == 0);
+    assert(LoadTMXPath(walls, start, enclosed, &pathCount) == NULL && pathCount == 0);
+
+    // Opening the walls around the enclosed cell makes it reachable.
+    assert(SetTMXTile(walls, ground, 29, 10, 30));
+    path = LoadTMXPath(walls, start, enclosed, &pathCount);
+    assert(path != NULL && path[pathCount - 1].x == enclosed.x && path[pathCount - 1].y == enclosed.y);
+    UnloadTMXPath(path);
+    assert(SetTMXTile(walls, ground, 29, 10, 10));
+    assert(LoadTMXPath(walls, start, enclosed, &pathCount) == NULL && pathCount == 0);
+
+    // Closing the gap leaves no way around the wall, until another one is opened at its top.
+    assert(SetTMXTile(walls, ground, 20, 19, 10));
+    assert(LoadTMXPath(walls, start, goal, &pathCount) == NULL && pathCount == 0);
+    assert(SetTMXTile(walls, ground, 20, 0, 30));
+    path = LoadTMXPath(walls, start, goal, &pathCount);
+    assert(path != NULL && pathCount >= 3);
+    for (int i = 0; i < pathCount; i++) assert(path[i].y < 3.0f * tileHeight);
+    UnloadTMXPath(path);
+    assert(SetTMXTile(walls, ground, 20, 0, 10));
+    assert(SetTMXTile(walls, ground, 20, 19, 30));
+
+    trace("LoadTMXPaths");
+    RaylibTMXPathRequest pathRequests[6] = {
+        {start, goal, NULL, 0},
+        {goal, start, NULL, 0},
+        {start, (Vector2){37.5f * tileWidth, 17.5f * tileHeight}, NULL, 0},
+        {(Vector2){10.5f * tileWidth, 15.5f * tileHeight}, (Vector2){35.5f * tileWidth, 5.5f * tileHeight}, NULL, 0},
+        {start, enclosed, NULL, 0},
+        {(Vector2){-100, -100}, goal, NULL, 0}
+    };
+    LoadTMXPaths(walls, pathRequests, 6, 4);
+    for (int i = 0; i < 6; i++) {
+        path = LoadTMXPath(walls, pathRequests[i].start, pathRequests[i].goal, &pathCount);
+        assert((path == NULL) == (i >= 4));
+        assert(pathRequests[i].count == pathCount && (pathRequests[i].path == NULL) == (path == NULL));
+        assert(pathCount == 0 || memcmp(pathRequests[i].path, path, (size_t)pathCount * sizeof(Vector2)) == 0);
+        UnloadTMXPath(path);
+        UnloadTMXPath(pathRequests[i].path);
+    }
+
+    trace("UpdateTMXAnimations");
+    // The animated tile shows its frames for 100, 200 and 300 milliseconds.
+    AnimationState *animation = GetTMXAnimationState(walls, walls->tiles[31]);
+    assert(animation != NULL && animation->currentFrame == 0);
+    assert(GetTMXAnimationState(walls, walls->tiles[10]) == NULL);
+    tmx_map *other = LoadTMX("resources/walls.tmx");
+    assert(other != NULL);
+    AnimationState *otherAnimation = GetTMXAnimationState(other, other->tiles[31]);
+    assert(otherAnimation != NULL && otherAnimation != animation);
+    UpdateTMXAnimations(walls, 0.125f);
+    assert(animation->currentFrame == 1 && animation->frameCounter == 25);
+    UpdateTMXAnimations(walls, 0.25f);
+    assert(animation->currentFrame == 2 && animation->frameCounter == 75);
+    UpdateTMXAnimations(walls, 0.25f);
+    assert(animation->currentFrame == 0 && animation->frameCounter == 25);
+    assert(otherAnimation->currentFrame == 0 && otherAnimation->frameCounter == 0);
+    UpdateTMXAnimations(other, 0.25f);
+    assert(otherAnimation->currentFrame == 1 && otherAnimation->frameCounter == 150);
+    assert(animation->currentFrame == 0 && animation->frameCounter == 25);
+    UnloadTMX(other);
+    UpdateTMXAnimations(walls, 0.125f);
+    assert(animation->currentFrame == 1 && animation->frameCounter == 50);
+
+    // Without UpdateTMXAnimations(), drawing twice in a frame advances by the time that passed, once.
+    tmx_map *drawn = LoadTMX("resources/walls.tmx");
+    assert(drawn != NULL);
+    AnimationState *drawnAnimation = GetTMXAnimationState(drawn, drawn->tiles[31]);
+    BeginDrawing();
+    {
+        double before = GetTime();
+        DrawTMX(drawn, 0, 0, WHITE);
+        assert(drawnAnimation->currentFrame == 0 && drawnAnimation->frameCounter == 0);
+        double drawnAt = GetTime();
+        while (GetTime() - drawnAt < 0.05) {}
+        DrawTMX(drawn, 0, 0, WHITE);
+        float passed = (float)((GetTime() - before) * 1000.0);
+        assert(drawnAnimation->currentFrame == 0 || passed >= 100);
+        if (drawnAnimation->currentFrame == 0) assert(drawnAnimation->frameCounter >= 50 && drawnAnimation->frameCounter <= passed);
+    }
+    EndDrawing();
+    UnloadTMX(drawn);
+
+    UnloadTMX(walls);
+
+    trace("IsTMXCellSolid in groups");
+    tmx_map *grouped = LoadTMX("resources/grouped.tmx");
+    assert(grouped != NULL);
+    tmx_layer *groupedWalls = grouped->ly_head->content.group_head;
+    tmx_layer *hiddenWalls = grouped->ly_head->next->content.group_head;
+    assert(groupedWalls->type == L_LAYER && hiddenWalls->type == L_LAYER);
+    assert(IsTMXCellSolid(grouped, groupedWalls, 4, 0) && IsTMXCellSolid(grouped, NULL, 4, 3));
+    assert(IsTMXCellSolid(grouped, hiddenWalls, 2, 0) && !IsTMXCellSolid(grouped, NULL, 2, 0));
+    rayHit = RaycastTMX(grouped, NULL, (Vector2){16, 48}, (Vector2){1000, 48});
+    assert(rayHit.hit && rayHit.x == 4 && rayHit.y == 1);
+    moved = MoveTMXRect(grouped, NULL, (Rectangle){16, 40, 20, 20}, (Vector2){200, 0}, &moveNormal);
+    assert(moved.x == 108 && moveNormal.x == -1);
+    assert(LoadTMXPath(grouped, (Vector2){48, 48}, (Vector2){208, 48}, &pathCount) == NULL && pathCount == 0);
+    UnloadTMX(grouped);
+
+    trace("DrawTMXLayerEx with an object grid");
+    // One object per grid bucket, with "Edge" anchored right of the view and rotated back into it.
+    tmx_map *objectMap = LoadTMX("resources/objects.tmx");
+    assert(objectMap != NULL);
+    assert(objectMap->ts_head->tileset->objectalignment == OA_TOPLEFT);
+    tmx_layer *objectLayer = objectMap->ly_head;
+    assert(FindObject(objectLayer, "Edge")->rotation == 90.0);
+    BeginTextureMode(expected);
+    {
+        ClearBackground(BLANK);
+        ResetTMXFrameStats();
+        DrawTMXLayerEx(objectMap, objectLayer, 0, 0, (Rectangle){0, 0, 1024, 1024}, WHITE);
+        assert(GetTMXFrameStats().objectsDrawn[OT_SQUARE] == 31 && GetTMXFrameStats().objectsDrawn[OT_TILE] == 33);
+    }
+    EndTextureMode();
+    BeginTextureMode(actual);
+    {
+        ClearBackground(BLANK);
+        ResetTMXFrameStats();
+        DrawTMXLayerEx(objectMap, objectLayer, 0, 0, (Rectangle){0, 0, 639, 479}, WHITE);
+        assert(GetTMXFrameStats().objectsDrawn[OT_SQUARE] == 10 && GetTMXFrameStats().objectsDrawn[OT_TILE] == 11);
+    }
+    EndTextureMode();
+    assert(IsRenderEqual(expected, actual));
+    UnloadTMX(objectMap);
+
+    // Only the cells whose tiles reach into the view are visited, and they draw the whole view.
+    const char *orientFiles[] = {"resources/isometric.tmx", "resources/staggered.tmx"};
+    const int orients[] = {O_ISO, O_STA};
+    const int orientCells[] = {1161, 1408};
+    for (size_t i = 0; i < sizeof(orients)/sizeof(orients[0]); i++) {
+        trace(TextFormat("DrawTMXLayerEx with %s", orientFiles[i]));
+        tmx_map *orientMap = LoadTMX(orientFiles[i]);
+        assert(orientMap != NULL && orientMap->orient == (enum tmx_map_orient)orients[i]);
+        BeginTextureMode(expected);
+        {
+            ClearBackground(BLANK);
+            ResetTMXFrameStats();
+            DrawTMXLayerEx(orientMap, orientMap->ly_head, -300, -100, (Rectangle){-1000, -1000, 4000, 4000}, WHITE);
+            assert(GetTMXFrameStats().cellsVisited == (int)(orientMap->width * orientMap->height));
+        }
+        EndTextureMode();
+        BeginTextureMode(actual);
+        {
+            ClearBackground(BLANK);
+            ResetTMXFrameStats();
+            DrawTMXLayerEx(orientMap, orientMap->ly_head, -300, -100, (Rectangle){0, 0, 640, 480}, WHITE);
+            RaylibTMXFrameStats orientStats = GetTMXFrameStats();
+            assert(orientStats.cellsVisited == orientCells[i] && orientStats.cellsSkipped > 0);
+            assert(orientStats.cellsVisited == orientStats.tilesDrawn + orientStats.cellsSkipped);
+        }
+        EndTextureMode();
+        assert(IsRenderEqual(expected, actual));
+        UnloadTMX(orientMap);
+    }
+
+    UnloadTMX(map);
+
+    trace("LoadTMXFromMemory");
+    int dataSize = 0;
+    unsigned char *data = LoadFileData("resources/desert.tmx", &dataSize);
+    assert(data != NULL);
+    map = LoadTMXFromMemory(data, dataSize, "resources");
+    UnloadFileData(data);
+    assert(map != NULL);
+    assert(map->ts_head->tileset->image->resource_image != NULL);
+    assert(((Texture2D *)map->ts_head->tileset->image->resource_image)->id > 0);
+
+    trace("SetTMXFileDataCallback");
+    int filesRead = 0;
+    SetTMXFileDataCallback(LoadFileDataCounted, &filesRead);
+    tmx_map *counted = LoadTMX("resources/desert.tmx");
+    SetTMXFileDataCallback(NULL, NULL);
+    assert(counted != NULL);
+    assert(filesRead == 2);
+    UnloadTMX(counted);
+
+    // Tilesets written in comments and CDATA sections aren't read.
+    const char *hidden = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+        "<map version=\"1.8\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"1\" height=\"1\" tilewidth=\"32\" tileheight=\"32\" infinite=\"0\">"
+        "<!-- <tileset firstgid=\"1\" source=\"commented.tsx\"/> -->"
+        "<properties><property name=\"note\"><![CDATA[<tileset firstgid=\"1\" source=\"cdata.tsx\"/>]]></property></properties>"
+        "<layer id=\"1\" name=\"Ground\" width=\"1\" height=\"1\"><data encoding=\"csv\">0</data></layer>"
+        "</map>";
+    filesRead = 0;
+    SetTMXFileDataCallback(LoadFileDataCounted, &filesRead);
+    counted = LoadTMXFromMemory((const unsigned char *)hidden, (int)strlen(hidden), "resources");
+    SetTMXFileDataCallback(NULL, NULL);
+    assert(counted != NULL);
+    assert(filesRead == 0);
+    UnloadTMX(counted);
+
+    trace("GetTMXTextureCacheStats");
+    RaylibTMXTextureCacheStats stats = GetTMXTextureCacheStats();
+    tmx_map *shared = LoadTMX("resources/desert.tmx");
+    assert(shared != NULL);
+    assert(GetTMXTextureCacheStats().hits == stats.hits + 1);
+    assert(GetTMXTextureCacheStats().resident == stats.resident);
+    assert(shared->ts_head->tileset->image->resource_image == map->ts_head->tileset->image->resource_image);
+    UnloadTMX(shared);
+    assert(GetTMXTextureCacheStats().residentBytes == stats.residentBytes);
+
+    trace("LoadTMXAsync");
+    RaylibTMXLoad *load = LoadTMXAsync("resources/desert.tmx");
+    assert(load != NULL);
+    tmx_map *loaded = NULL;
+    while (!PollTMXLoad(load, &loaded)) {}
+    assert(loaded != NULL);
+    assert(((Texture2D *)loaded->ts_head->tileset->image->resource_image)->id > 0);
+
+    trace("PackTMXAtlas");
+    assert(PackTMXAtlas(loaded, 0) == 0);
+    assert(PackTMXAtlas(loaded, 512) == 1);
+    assert(loaded->ts_head->tileset->image->resource_image != map->ts_head->tileset->image->resource_image);
+    BeginDrawing();
+    {
+        ClearBackground(RAYWHITE);
+        DrawTMX(loaded, 0, 0, WHITE);
+    }
+    EndDrawing();
+    UnloadTMX(loaded);
+    CancelTMXLoad(LoadTMXAsync("resources/desert.tmx"));
+
+    trace("PackTMXAtlas image collection");
+    // Tiles of different sizes, flipped tiles and a tile object, drawn plainly, compiled and meshed.
+    for (int mode = 0; mode < 3; mode++) {
+        tmx_map *collection = LoadTMX("resources/collection.tmx");
+        assert(collection != NULL);
+        tmx_tileset *images = collection->ts_head->tileset;
+        assert(images->image == NULL && images->tilecount == 3);
+        assert(images->tiles[0].image->resource_image != images->tiles[1].image->resource_image);
+        BeginTextureMode(expected);
+        {
+            ClearBackground(BLANK);
+            DrawTMX(collection, 0, 0, WHITE);
+        }
+        EndTextureMode();
+        if (mode == 1) CompileTMX(collection);
+        if (mode == 2) BuildTMXLayerMesh(collection, collection->ly_head);
+        assert(PackTMXAtlas(collection, 0) == 1);
+        for (unsigned int i = 1; i < images->tilecount; i++) {
+            assert(images->tiles[i].image->resource_image == images->tiles[0].image->resource_image);
+        }
+        BeginTextureMode(actual);
+        {
+            ClearBackground(BLANK);
+            DrawTMX(collection, 0, 0, WHITE);
+        }
+        EndTextureMode();
+        assert(IsRenderEqual(expected, actual));
+        if (mode == 2) UnloadTMXLayerMesh(collection, collection->ly_head);
+        UnloadTMX(collection);
+    }
+
+    trace("ExportTMX");
+    assert(ExportTMX(map, "resources/desert.rtmx"));
+    tmx_map *cooked = LoadTMXCooked("resources/desert.rtmx");
+    remove("resources/desert.rtmx");
+    assert(cooked != NULL);
+    assert(cooked->width == map->width && cooked->height == map->height);
+    assert(memcmp(cooked->ly_head->content.gids, map->ly_head->content.gids, map->width * map->height * sizeof(uint32_t)) == 0);
+    assert(cooked->ly_head->parallaxx == map->ly_head->parallaxx && cooked->ly_head->tintcolor == map->ly_head->tintcolor);
+    assert(cooked->ts_head->tileset->image->resource_image == map->ts_head->tileset->image->resource_image);
+    BeginDrawing();
+    {
+        ClearBackground(RAYWHITE);
+        DrawTMX(cooked, 0, 0, WHITE);
+    }
+    EndDrawing();
+    UnloadTMX(cooked);
+    assert(LoadTMXCooked("resources/desert.tmx") == NULL);
+
+    trace("ExportTMX properties, templates and collisions");
+    tmx_map *props = LoadTMX("resources/properties.tmx");
+    assert(props != NULL);
+    assert(ExportTMX(props, "resources/properties.rtmx"));
+    cooked = LoadTMXCooked("resources/properties.rtmx");
+    remove("resources/properties.rtmx");
+    assert(cooked != NULL);
+    assert(strcmp(GetTMXMapProperty(cooked, "title")->value.string, "Oasis") == 0);
+    tmx_property *spawn = GetTMXMapProperty(cooked, "spawn");
+    assert(spawn != NULL && spawn->type == PT_CUSTOM);
+    assert(GetTMXPropertyMember(cooked, spawn, "x")->value.integer == 3);
+    assert(GetTMXLayerProperty(cooked, cooked->ly_head, "depth")->value.integer == 3);
+    assert(GetTMXTileProperty(cooked, cooked->tiles[5], "solid")->value.boolean);
+    assert(GetTMXTileProperty(cooked, cooked->tiles[1], "solid") == NULL);
+    tmx_object *instance = cooked->ly_head->next->content.objgr->head;
+    while (instance != NULL && instance->template_ref == NULL) instance = instance->next;
+    assert(instance != NULL && strcmp(instance->template_ref->object->name, "Crate") == 0);
+    assert(strcmp(GetTMXObjectProperty(cooked, instance, "contents")->value.string, "gold") == 0);
+    assert(GetTMXObjectProperty(cooked, instance->template_ref->object, "weight")->value.integer == 5);
+
+    // The baked collisions are loaded as they were exported, rather than baked again.
+    for (int y = 0; y < (int)props->height; y++) {
+        for (int x = 0; x < (int)props->width; x++) {
+            int propsCount = 0;
+            int cookedCount = 0;
+            const RaylibTMXCollider *propsColliders = GetTMXCellColliders(props, props->ly_head, x, y, &propsCount);
+            const RaylibTMXCollider *cookedColliders = GetTMXCellColliders(cooked, cooked->ly_head, x, y, &cookedCount);
+            assert(propsCount == cookedCount);
+            for (int i = 0; i < cookedCount; i++) {
+                assert(cookedColliders[i].object->id == propsColliders[i].object->id);
+                assert(cookedColliders[i].collision.type == propsColliders[i].collision.type);
+                assert(memcmp(&cookedColliders[i].bounds, &propsColliders[i].bounds, sizeof(Rectangle)) == 0);
+                if (cookedColliders[i].collision.type != COLLISION_POLYGON) continue;
+                assert(cookedColliders[i].collision.polygon.count == 3);
+                assert(memcmp(cookedColliders[i].collision.polygon.vertices, propsColliders[i].collision.polygon.vertices, 3 * sizeof(Vector2)) == 0);
+            }
+            assert(IsTMXCellSolid(cooked, NULL, x, y) == IsTMXCellSolid(props, NULL, x, y));
+        }
+    }
+    int propsObjectCount = 0;
+    int cookedObjectCount = 0;
+    const RaylibTMXCollider *propsObjects = GetTMXObjectColliders(props, props->ly_head->next, &propsObjectCount);
+    const RaylibTMXCollider *cookedObjects = GetTMXObjectColliders(cooked, cooked->ly_head->next, &cookedObjectCount);
+    assert(cookedObjectCount == propsObjectCount && cookedObjectCount == 7);
+    for (int i = 0; i < cookedObjectCount; i++) {
+        assert(cookedObjects[i].object->id == propsObjects[i].object->id);
+        assert(cookedObjects[i].collision.type == propsObjects[i].collision.type);
+        assert(memcmp(&cookedObjects[i].bounds, &propsObjects[i].bounds, sizeof(Rectangle)) == 0);
+        if (cookedObjects[i].collision.type != COLLISION_POLYGON) continue;
+        int count = cookedObjects[i].collision.polygon.count;
+        assert(count == propsObjects[i].collision.polygon.count);
+        assert(memcmp(cookedObjects[i].collision.polygon.vertices, propsObjects[i].collision.polygon.vertices, (size_t)count * sizeof(Vector2)) == 0);
+    }
+    int queried = 0;
+    QueryTMXCollisionsRect(cooked, (Rectangle){0, 0, 256, 128}, CountCollisions, &queried);
+    assert(queried > cookedObjectCount);
+
+    // The solid masks are rebuilt with the properties, and a changed chunk is baked again.
+    assert(IsTMXCellSolid(cooked, NULL, 2, 0) && !IsTMXCellSolid(cooked, NULL, 4, 0));
+    SetTMXSolidProperty(cooked, "solid");
+    assert(!IsTMXCellSolid(cooked, NULL, 2, 0) && IsTMXCellSolid(cooked, NULL, 4, 0));
+    int cellCount = 0;
+    assert(SetTMXTile(cooked, cooked->ly_head, 0, 0, 10));
+    GetTMXCellColliders(cooked, cooked->ly_head, 0, 0, &cellCount);
+    assert(cellCount == 2);
+    GetTMXCellColliders(cooked, cooked->ly_head, 2, 0, &cellCount);
+    assert(cellCount == 2);
+    UnloadTMX(cooked);
+    UnloadTMX(props);
+
     UnloadTMX(map);
 
+    UnloadRenderTexture(expected);
+    UnloadRenderTexture(actual);
     CloseWindow();
     trace("raylib-tmx tests succesful");
 